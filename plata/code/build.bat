@@ -15,4 +15,8 @@ cl /c /TC ..\plata\code\tmx_impl.c
 REM echo Building s3mail.exe
 cl %CommonCompilerFlags% ..\plata\code\win32_plata.cpp -Fmwin32_plata.map /link  %CommonLinkerFlags%
 
+REM raytmx benchmarks, optimized since the timings are the point
+set BenchCompilerFlags=%CommonCompilerFlags:-Od=-O2%
+cl %BenchCompilerFlags% ..\plata\code\tmx_bench.cpp -Fmtmx_bench.map /link %CommonLinkerFlags%
+
 popd
@@ -0,0 +1,19 @@
+#!/bin/sh
+# Linux builds of the headless simulation runner and the raytmx benchmarks. Needs raylib installed as a library;
+# headers come from this directory.
+
+set -e
+
+CommonCompilerFlags="-O2 -g -fno-exceptions -fno-rtti -Wall -Wextra -Wno-unused-parameter"
+CommonCompilerFlags="$CommonCompilerFlags -Wno-missing-field-initializers"
+CommonLinkerFlags="-lraylib -lGL -lm -lpthread -ldl -lrt -lX11"
+
+cd "$(dirname "$0")"
+mkdir -p ../../build
+cd ../../build
+
+# build tmx_impl.c
+cc -c -O2 -g ../plata/code/tmx_impl.c -o tmx_impl.o
+
+c++ $CommonCompilerFlags ../plata/code/linux_plata_headless.cpp tmx_impl.o -o linux_plata_headless $CommonLinkerFlags
+c++ $CommonCompilerFlags ../plata/code/tmx_bench.cpp tmx_impl.o -o tmx_bench $CommonLinkerFlags
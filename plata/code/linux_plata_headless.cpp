@@ -0,0 +1,318 @@
+/*******************************************************************************************
+*
+*   Headless simulation runner for Linux
+*
+*   Loads the map without textures, drives the player with scripted pseudo-random input,
+*   and steps the simulation as fast as it will go. No window, audio or GPU is used, so
+*   this can soak-test and benchmark the simulation on a server.
+*
+*   Usage: linux_plata_headless [-map file.tmx] [-ticks N] [-seed N] [-record file.prec]
+*          linux_plata_headless -replay file.prec [-map file.tmx]
+*
+*   Either mode can also write every tick's state hash as text with -hashes file.txt, so
+*   runs from two builds can be diffed. A replay exits with 2 if any hash differs from
+*   the one recorded. -trace file.json dumps the profiler's most recent zones as a Chrome
+*   trace for chrome://tracing or ui.perfetto.dev.
+*
+********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include "plata_sim.cpp"
+
+#define MAP_PATH "plata/data/plata.tmx"
+#define PLAYER_SPRITE_PATH "plata/data/player_idle-right.png"
+#define DEFAULT_TICKS 1000000
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct HeadlessStats
+{
+    uint64_t events[SIM_EVENT_COUNT];
+    int peakProjectiles;
+    uint64_t hashMismatches;
+    uint64_t firstMismatchTick;
+} HeadlessStats;
+
+//----------------------------------------------------------------------------------
+// Function Forward Declarations / Prototypes
+//----------------------------------------------------------------------------------
+static Texture2D LoadNoTexture(const char *fileName);
+static uint32_t NextRandom(uint32_t *state);
+static void GenerateBotInput(PlayerInput *input, uint32_t *randomState);
+static double GetMonotonicSeconds(void);
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    const char *mapPath = 0;
+    const char *recordPath = 0;
+    const char *replayPath = 0;
+    const char *hashesPath = 0;
+    const char *tracePath = 0;
+    uint64_t tickCount = DEFAULT_TICKS;
+    uint32_t seed = 1;
+    for(int argIndex = 1;
+        argIndex < argc;
+        argIndex++)
+    {
+        if(strcmp(argv[argIndex], "-map") == 0 && argIndex + 1 < argc)
+        {
+            mapPath = argv[++argIndex];
+        }
+        else if(strcmp(argv[argIndex], "-ticks") == 0 && argIndex + 1 < argc)
+        {
+            tickCount = strtoull(argv[++argIndex], 0, 10);
+        }
+        else if(strcmp(argv[argIndex], "-seed") == 0 && argIndex + 1 < argc)
+        {
+            seed = (uint32_t)strtoul(argv[++argIndex], 0, 10);
+        }
+        else if(strcmp(argv[argIndex], "-record") == 0 && argIndex + 1 < argc)
+        {
+            recordPath = argv[++argIndex];
+        }
+        else if(strcmp(argv[argIndex], "-replay") == 0 && argIndex + 1 < argc)
+        {
+            replayPath = argv[++argIndex];
+        }
+        else if(strcmp(argv[argIndex], "-hashes") == 0 && argIndex + 1 < argc)
+        {
+            hashesPath = argv[++argIndex];
+        }
+        else if(strcmp(argv[argIndex], "-trace") == 0 && argIndex + 1 < argc)
+        {
+            tracePath = argv[++argIndex];
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-map file.tmx] [-ticks N] [-seed N] [-record file] [-hashes file]"
+                    " [-trace file]\n"
+                    "       %s -replay file [-map file.tmx] [-hashes file] [-trace file]\n", argv[0], argv[0]);
+            return(1);
+        }
+    }
+    
+    // A replay brings its own map, player size and length
+    InputRecording replay = {};
+    if(replayPath)
+    {
+        if(!LoadInputRecording(&replay, replayPath))
+        {
+            TraceLog(LOG_ERROR, "Failed to load input recording \"%s\"", replayPath);
+            return(1);
+        }
+        tickCount = replay.header.frameCount;
+        if(!mapPath) mapPath = replay.header.mapPath;
+    }
+    if(!mapPath) mapPath = MAP_PATH;
+    
+    // Tilesets only need their metadata here. Without a GL context there is nothing to upload textures to anyway.
+    SetTraceLogLevel(LOG_WARNING);
+    SetLoadTextureTMX(LoadNoTexture);
+    
+    TmxMap *map = LoadTMX(mapPath);
+    if(map == 0)
+    {
+        TraceLog(LOG_ERROR, "Failed to load TMX \"%s\"", mapPath);
+        UnloadInputRecording(&replay);
+        return(1);
+    }
+    if(replayPath && HashSimMap(map) != replay.header.mapHash)
+    {
+        TraceLog(LOG_ERROR, "\"%s\" was recorded on a different map than \"%s\"", replayPath, mapPath);
+        UnloadTMX(map);
+        UnloadInputRecording(&replay);
+        return(1);
+    }
+    
+    // The player's hitbox comes from their sprite's size. Decoding it on the CPU is enough for that.
+    float spriteWidth = replay.header.spriteWidth;
+    float spriteHeight = replay.header.spriteHeight;
+    if(!replayPath)
+    {
+        Image sprite = LoadImage(PLAYER_SPRITE_PATH);
+        if(sprite.data == 0)
+        {
+            TraceLog(LOG_ERROR, "Failed to load player sprite \"%s\"", PLAYER_SPRITE_PATH);
+            UnloadTMX(map);
+            return(1);
+        }
+        spriteWidth = (float)sprite.width;
+        spriteHeight = (float)sprite.height;
+        UnloadImage(sprite);
+    }
+    
+    SimState *sim = (SimState *)MemAlloc(sizeof(SimState));
+    if(!SimInit(sim, map, spriteWidth, spriteHeight))
+    {
+        TraceLog(LOG_WARNING, "Map has no Collision layer. The player will fall forever.");
+    }
+    
+    InputRecording recording = {};
+    if(recordPath) InitInputRecording(&recording, mapPath, HashSimMap(map), spriteWidth, spriteHeight);
+    
+    FILE *hashesFile = 0;
+    if(hashesPath)
+    {
+        hashesFile = fopen(hashesPath, "w");
+        if(!hashesFile) TraceLog(LOG_WARNING, "Failed to open \"%s\" for writing", hashesPath);
+    }
+    
+    PlayerInput input = {};
+    uint32_t randomState = seed ? seed : 1;
+    HeadlessStats stats = {};
+    
+    double startTime = GetMonotonicSeconds();
+    for(uint64_t tick = 0;
+        tick < tickCount;
+        tick++)
+    {
+        if(replayPath)
+        {
+            UnpackPlayerInput(replay.frames[tick].input, &input);
+        }
+        else
+        {
+            GenerateBotInput(&input, &randomState);
+        }
+        uint32_t inputBits = PackPlayerInput(&input);
+        
+        SimStep(sim, &input, SIM_DT);
+        
+        // Hashing walks every projectile, so it is only done when something will use it
+        if(replayPath || recordPath || hashesFile)
+        {
+            uint64_t stateHash = HashSimState(sim);
+            if(replayPath && stateHash != replay.frames[tick].stateHash)
+            {
+                if(stats.hashMismatches == 0) stats.firstMismatchTick = tick;
+                stats.hashMismatches++;
+            }
+            if(recordPath) AppendInputRecordingFrame(&recording, inputBits, stateHash);
+            if(hashesFile) fprintf(hashesFile, "%llu %016llx\n", (unsigned long long)tick,
+                                   (unsigned long long)stateHash);
+        }
+        
+        for(int i = 0;
+            i < sim->eventCount;
+            i++)
+        {
+            stats.events[sim->events[i].type]++;
+        }
+        SimClearEvents(sim);
+        
+        if(sim->player.gun.bullets.count > stats.peakProjectiles)
+        {
+            stats.peakProjectiles = sim->player.gun.bullets.count;
+        }
+    }
+    double elapsed = GetMonotonicSeconds() - startTime;
+    
+    printf("ticks: %llu (%.1f simulated seconds)\n", (unsigned long long)sim->tick, (double)sim->tick * SIM_DT);
+    printf("elapsed: %.3f s, %.0f ticks/s, %.3f us/tick\n", elapsed, elapsed > 0.0 ? (double)sim->tick / elapsed : 0.0,
+           sim->tick ? elapsed * 1e6 / (double)sim->tick : 0.0);
+    printf("shots: %llu, dry fires: %llu, reloads: %llu, overheats: %llu, impacts: %llu\n",
+           (unsigned long long)stats.events[SIM_EVENT_GUN_FIRED],
+           (unsigned long long)stats.events[SIM_EVENT_GUN_DRY_FIRED],
+           (unsigned long long)stats.events[SIM_EVENT_GUN_RELOADED],
+           (unsigned long long)stats.events[SIM_EVENT_GUN_OVERHEATED],
+           (unsigned long long)stats.events[SIM_EVENT_PROJECTILE_IMPACT]);
+    printf("peak projectiles: %d, final player position: (%.2f, %.2f)\n", stats.peakProjectiles,
+           sim->player.position.x, sim->player.position.y);
+    printf("final state hash: %016llx\n", (unsigned long long)HashSimState(sim));
+    
+    int result = 0;
+    if(replayPath)
+    {
+        if(stats.hashMismatches)
+        {
+            printf("replay: %llu of %llu ticks diverged, first at tick %llu\n",
+                   (unsigned long long)stats.hashMismatches, (unsigned long long)tickCount,
+                   (unsigned long long)stats.firstMismatchTick);
+            result = 2;
+        }
+        else
+        {
+            printf("replay: all %llu ticks matched\n", (unsigned long long)tickCount);
+        }
+    }
+    if(recordPath && !SaveInputRecording(&recording, recordPath))
+    {
+        TraceLog(LOG_ERROR, "Failed to save input recording \"%s\"", recordPath);
+        result = 1;
+    }
+    
+    if(tracePath && !ProfilerWriteChromeTrace(tracePath))
+    {
+        TraceLog(LOG_ERROR, "Failed to write profile trace \"%s\"", tracePath);
+        result = 1;
+    }
+    
+    if(hashesFile) fclose(hashesFile);
+    UnloadInputRecording(&recording);
+    UnloadInputRecording(&replay);
+    SimShutdown(sim);
+    MemFree(sim);
+    UnloadTMX(map);
+    ProfilerShutdown();
+    
+    return(result);
+}
+
+static Texture2D
+LoadNoTexture(const char *fileName)
+{
+    Texture2D texture = {};
+    return(texture);
+}
+
+// xorshift32. Deterministic for a given seed, so a run can be repeated exactly.
+static uint32_t
+NextRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return(x);
+}
+
+// Roughly what a restless player does: walk one way for a while, hop now and then, hold or tap fire, reload.
+static void
+GenerateBotInput(PlayerInput *input, uint32_t *randomState)
+{
+    if(NextRandom(randomState) % 60 == 0)
+    {
+        uint32_t direction = NextRandom(randomState) % 3;
+        input->moveLeft = (direction == 1);
+        input->moveRight = (direction == 2);
+    }
+    if(NextRandom(randomState) % 90 == 0)
+    {
+        input->fireDown = !input->fireDown;
+    }
+    
+    input->jumpPressed = (NextRandom(randomState) % 120 == 0);
+    input->jumpReleased = (NextRandom(randomState) % 30 == 0);
+    input->firePressed = (NextRandom(randomState) % 20 == 0);
+    input->reloadPressed = (NextRandom(randomState) % 300 == 0);
+}
+
+static double
+GetMonotonicSeconds(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return((double)now.tv_sec + (double)now.tv_nsec * 1e-9);
+}
@@ -0,0 +1,306 @@
+// Scoped-zone profiler. See plata_profiler.h. Compiled as part of each platform layer's single translation unit.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "plata_profiler.h"
+
+// Same workaround as the platform layer: no windows.h, just the two calls the clock needs
+#if defined(_WIN32) && !defined(_WINDOWS_)
+extern "C" __declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *lpPerformanceCount);
+extern "C" __declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *lpFrequency);
+#elif !defined(_WIN32)
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ProfilerAtomicIncrement(value) (_InterlockedIncrement(value) - 1)
+#define ProfilerCompilerBarrier() _ReadWriteBarrier()
+#else
+#define ProfilerAtomicIncrement(value) __sync_fetch_and_add(value, 1)
+#define ProfilerCompilerBarrier() __asm__ __volatile__("" ::: "memory")
+#endif
+
+static ProfileThreadBuffer profileThreads[PROFILER_MAX_THREADS];
+static volatile long profileThreadCount;
+static ProfileZoneStats profileZones[PROFILER_MAX_ZONES];
+static int profileZoneCount;
+static thread_local ProfileThreadBuffer *profileThreadBuffer;
+static thread_local bool profileThreadUnprofiled;
+
+#if PLATA_PROFILE
+ProfileZone::ProfileZone(const char *zoneName)
+{
+    name = zoneName;
+    start = ProfilerGetTicks();
+}
+
+ProfileZone::~ProfileZone()
+{
+    ProfilerRecord(name, start, ProfilerGetTicks());
+}
+#endif
+
+uint64_t
+ProfilerGetTicks(void)
+{
+#if defined(_WIN32)
+    long long counter;
+    QueryPerformanceCounter(&counter);
+    return((uint64_t)counter);
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return((uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec);
+#endif
+}
+
+double
+ProfilerTicksToMicroseconds(uint64_t ticks)
+{
+#if defined(_WIN32)
+    static double microsecondsPerTick;
+    if(microsecondsPerTick == 0.0)
+    {
+        long long frequency;
+        QueryPerformanceFrequency(&frequency);
+        microsecondsPerTick = 1e6 / (double)frequency;
+    }
+    return((double)ticks * microsecondsPerTick);
+#else
+    return((double)ticks * 1e-3);
+#endif
+}
+
+void
+ProfilerRecord(const char *name, uint64_t start, uint64_t end)
+{
+    ProfileThreadBuffer *buffer = GetProfileThreadBuffer();
+    if(!buffer) return;
+    
+    uint64_t writeCount = buffer->writeCount;
+    ProfileEvent *event = &buffer->events[writeCount & (PROFILER_RING_SIZE - 1)];
+    event->name = name;
+    event->start = start;
+    event->end = end;
+    
+    // The event has to be in place before a reader on another thread can see the count cover it
+    ProfilerCompilerBarrier();
+    buffer->writeCount = writeCount + 1;
+}
+
+// Called once a frame, from one thread, after the frame's last zone has closed
+void
+ProfilerEndFrame(void)
+{
+    long threadCount = profileThreadCount;
+    if(threadCount > PROFILER_MAX_THREADS) threadCount = PROFILER_MAX_THREADS;
+    
+    for(long threadIndex = 0;
+        threadIndex < threadCount;
+        threadIndex++)
+    {
+        ProfileThreadBuffer *buffer = &profileThreads[threadIndex];
+        
+        // Still being registered by its thread
+        if(!buffer->events) continue;
+        
+        uint64_t writeCount = buffer->writeCount;
+        ProfilerCompilerBarrier();
+        if(writeCount - buffer->readCount > PROFILER_RING_SIZE) buffer->readCount = writeCount - PROFILER_RING_SIZE;
+        
+        for(uint64_t eventIndex = buffer->readCount;
+            eventIndex < writeCount;
+            eventIndex++)
+        {
+            ProfileEvent *event = &buffer->events[eventIndex & (PROFILER_RING_SIZE - 1)];
+            ProfileZoneStats *zone = GetProfileZoneStats(event->name);
+            if(!zone) continue;
+            
+            zone->frameMicroseconds += ProfilerTicksToMicroseconds(event->end - event->start);
+            zone->enteredThisFrame = true;
+        }
+        buffer->readCount = writeCount;
+    }
+    
+    for(int zoneIndex = 0;
+        zoneIndex < profileZoneCount;
+        zoneIndex++)
+    {
+        ProfileZoneStats *zone = &profileZones[zoneIndex];
+        if(!zone->enteredThisFrame) continue;
+        
+        zone->history[zone->historyNext] = zone->frameMicroseconds;
+        zone->historyNext = (zone->historyNext + 1) % PROFILER_HISTORY;
+        if(zone->historyCount < PROFILER_HISTORY) zone->historyCount++;
+        
+        zone->frameMicroseconds = 0.0;
+        zone->enteredThisFrame = false;
+    }
+}
+
+// Zones are numbered in the order they were first seen by ProfilerEndFrame()
+int
+ProfilerGetZoneCount(void)
+{
+    return(profileZoneCount);
+}
+
+bool
+ProfilerGetZonePercentiles(int zoneIndex, const char **name, double *p50, double *p99)
+{
+    if(zoneIndex < 0 || zoneIndex >= profileZoneCount) return(false);
+    
+    ProfileZoneStats *zone = &profileZones[zoneIndex];
+    *name = zone->name;
+    if(zone->historyCount == 0) return(false);
+    
+    double sorted[PROFILER_HISTORY];
+    memcpy(sorted, zone->history, zone->historyCount * sizeof(double));
+    qsort(sorted, zone->historyCount, sizeof(double), CompareDoubles);
+    
+    // Nearest rank
+    *p50 = sorted[(zone->historyCount - 1) * 50 / 100];
+    *p99 = sorted[(zone->historyCount - 1) * 99 / 100];
+    return(true);
+}
+
+// Writes every zone still in the thread rings as a complete ("X") trace event, timed in microseconds from the oldest
+// one. Each profiled thread gets its own track.
+bool
+ProfilerWriteChromeTrace(const char *fileName)
+{
+    long threadCount = profileThreadCount;
+    if(threadCount > PROFILER_MAX_THREADS) threadCount = PROFILER_MAX_THREADS;
+    
+    uint64_t startTicks = UINT64_MAX;
+    for(long threadIndex = 0;
+        threadIndex < threadCount;
+        threadIndex++)
+    {
+        ProfileThreadBuffer *buffer = &profileThreads[threadIndex];
+        if(!buffer->events) continue;
+        
+        // Zones are recorded as they close, so an enclosing zone that started first comes after the ones it encloses
+        uint64_t writeCount = buffer->writeCount;
+        uint64_t oldest = writeCount > PROFILER_RING_SIZE ? writeCount - PROFILER_RING_SIZE : 0;
+        for(uint64_t eventIndex = oldest;
+            eventIndex < writeCount;
+            eventIndex++)
+        {
+            uint64_t start = buffer->events[eventIndex & (PROFILER_RING_SIZE - 1)].start;
+            if(start < startTicks) startTicks = start;
+        }
+    }
+    
+    FILE *file = fopen(fileName, "w");
+    if(!file) return(false);
+    
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+        
+    for(long threadIndex = 0;
+        threadIndex < threadCount;
+        threadIndex++)
+    {
+        ProfileThreadBuffer *buffer = &profileThreads[threadIndex];
+        if(!buffer->events) continue;
+            
+        uint64_t writeCount = buffer->writeCount;
+        ProfilerCompilerBarrier();
+        uint64_t oldest = writeCount > PROFILER_RING_SIZE ? writeCount - PROFILER_RING_SIZE : 0;
+            
+        for(uint64_t eventIndex = oldest;
+            eventIndex < writeCount;
+            eventIndex++)
+        {
+            ProfileEvent *event = &buffer->events[eventIndex & (PROFILER_RING_SIZE - 1)];
+            fprintf(file, "%s{\"name\":\"%s\",\"cat\":\"plata\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                    "\"pid\":1,\"tid\":%u}", first ? "" : ",\n", event->name,
+                    ProfilerTicksToMicroseconds(event->start - startTicks),
+                    ProfilerTicksToMicroseconds(event->end - event->start), buffer->threadIndex);
+            first = false;
+        }
+    }
+        
+    fprintf(file, "\n]}\n");
+    bool written = (ferror(file) == 0);
+    fclose(file);
+    
+    return(written);
+}
+
+// Only safe once no other thread will record again
+void
+ProfilerShutdown(void)
+{
+    long threadCount = profileThreadCount;
+    if(threadCount > PROFILER_MAX_THREADS) threadCount = PROFILER_MAX_THREADS;
+    
+    for(long threadIndex = 0;
+        threadIndex < threadCount;
+        threadIndex++)
+    {
+        free(profileThreads[threadIndex].events);
+        profileThreads[threadIndex] = {};
+    }
+    profileThreadCount = 0;
+    profileZoneCount = 0;
+    profileThreadBuffer = 0;
+    profileThreadUnprofiled = false;
+}
+
+// A thread claims a buffer the first time it records. Threads past PROFILER_MAX_THREADS go unprofiled.
+static ProfileThreadBuffer*
+GetProfileThreadBuffer(void)
+{
+    if(profileThreadBuffer) return(profileThreadBuffer);
+    if(profileThreadUnprofiled) return(0);
+    
+    long threadIndex = ProfilerAtomicIncrement(&profileThreadCount);
+    if(threadIndex >= PROFILER_MAX_THREADS)
+    {
+        profileThreadUnprofiled = true;
+        return(0);
+    }
+    
+    ProfileThreadBuffer *buffer = &profileThreads[threadIndex];
+    buffer->threadIndex = (uint32_t)threadIndex;
+    buffer->events = (ProfileEvent *)calloc(PROFILER_RING_SIZE, sizeof(ProfileEvent));
+    if(!buffer->events)
+    {
+        profileThreadUnprofiled = true;
+        return(0);
+    }
+    
+    profileThreadBuffer = buffer;
+    return(buffer);
+}
+
+static ProfileZoneStats*
+GetProfileZoneStats(const char *name)
+{
+    for(int zoneIndex = 0;
+        zoneIndex < profileZoneCount;
+        zoneIndex++)
+    {
+        if(profileZones[zoneIndex].name == name) return(&profileZones[zoneIndex]);
+    }
+    
+    if(profileZoneCount == PROFILER_MAX_ZONES) return(0);
+    
+    ProfileZoneStats *zone = &profileZones[profileZoneCount++];
+    *zone = {};
+    zone->name = name;
+    return(zone);
+}
+
+static int
+CompareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return((x > y) - (x < y));
+}
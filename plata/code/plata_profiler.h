@@ -0,0 +1,92 @@
+#ifndef PLATA_PROFILER_H
+#define PLATA_PROFILER_H
+
+// Scoped-zone profiler. PROFILE_ZONE("Name") times from that line to the end of the enclosing scope and appends the
+// zone to the calling thread's ring buffer. Once a frame the platform layer calls ProfilerEndFrame() to fold the new
+// zones into rolling per-zone percentiles, and on exit ProfilerWriteChromeTrace() dumps whatever the rings still
+// hold in Chrome's trace-event format (chrome://tracing, ui.perfetto.dev).
+//
+// Zones are told apart by their name's address, so names must be string literals. Build with PLATA_PROFILE 0 to
+// compile every zone out.
+
+#include <stdint.h>
+
+#ifndef PLATA_PROFILE
+#define PLATA_PROFILE 1
+#endif
+
+#define PROFILER_RING_SIZE 65536 // Zones kept per thread. Must be a power of two.
+#define PROFILER_MAX_THREADS 16
+#define PROFILER_MAX_ZONES 64
+#define PROFILER_HISTORY 240 // Frames the percentiles are taken over, 4 seconds at 60 fps
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef struct ProfileEvent
+{
+    const char *name;
+    uint64_t start; // ProfilerGetTicks()
+    uint64_t end;
+} ProfileEvent;
+
+// Written only by its own thread and read by whichever thread calls ProfilerEndFrame(). Counts only ever grow; the
+// event for count n lives in events[n % PROFILER_RING_SIZE], so a reader that falls behind just loses the oldest.
+typedef struct ProfileThreadBuffer
+{
+    ProfileEvent *events;
+    volatile uint64_t writeCount;
+    uint64_t readCount; // Events already folded into the zone stats
+    uint32_t threadIndex;
+} ProfileThreadBuffer;
+
+typedef struct ProfileZoneStats
+{
+    const char *name;
+    
+    // Time spent in the zone during the frame being collected. A zone entered several times a frame (once per
+    // simulation tick, say) is summed.
+    double frameMicroseconds;
+    bool enteredThisFrame;
+    
+    // Per-frame totals, in microseconds, for the last PROFILER_HISTORY frames the zone was entered in
+    double history[PROFILER_HISTORY];
+    uint32_t historyCount;
+    uint32_t historyNext;
+} ProfileZoneStats;
+
+#if PLATA_PROFILE
+struct ProfileZone
+{
+    const char *name;
+    uint64_t start;
+    
+    ProfileZone(const char *zoneName);
+    ~ProfileZone();
+};
+#endif
+
+//----------------------------------------------------------------------------------
+// Function Forward Declarations / Prototypes
+//----------------------------------------------------------------------------------
+uint64_t ProfilerGetTicks(void);
+double ProfilerTicksToMicroseconds(uint64_t ticks);
+void ProfilerRecord(const char *name, uint64_t start, uint64_t end);
+void ProfilerEndFrame(void);
+int ProfilerGetZoneCount(void);
+bool ProfilerGetZonePercentiles(int zoneIndex, const char **name, double *p50, double *p99);
+bool ProfilerWriteChromeTrace(const char *fileName);
+void ProfilerShutdown(void);
+static ProfileThreadBuffer *GetProfileThreadBuffer(void);
+static ProfileZoneStats *GetProfileZoneStats(const char *name);
+static int CompareDoubles(const void *a, const void *b);
+
+#if PLATA_PROFILE
+#define PROFILE_ZONE_JOIN_(a, b) a##b
+#define PROFILE_ZONE_JOIN(a, b) PROFILE_ZONE_JOIN_(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_ZONE_JOIN(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
+
+#endif // PLATA_PROFILER_H
@@ -0,0 +1,937 @@
+// Simulation core. See plata_sim.h. Compiled as part of each platform layer's single translation unit.
+
+#include "plata_sim.h"
+#include "plata_profiler.cpp"
+
+bool
+SimInit(SimState *sim, TmxMap *map, float spriteWidth, float spriteHeight)
+{
+    *sim = {};
+    sim->collisionGroup = GetCollisionLayer(map);
+    sim->worldBounds.width = (float)(map->width * map->tileWidth);
+    sim->worldBounds.height = (float)(map->height * map->tileHeight);
+    InitPlayer(&sim->player, spriteWidth, spriteHeight);
+    sim->spawnPosition = sim->player.position;
+    
+    return(sim->collisionGroup != 0);
+}
+
+void
+SimStep(SimState *sim, PlayerInput *input, float delta)
+{
+    UpdatePlayer(sim, input, delta);
+    UpdateBullets(&sim->player.gun.bullets, sim, delta);
+    ClearPlayerInputEdges(input);
+    
+    // There is no dying yet, so falling off the map just starts the player over
+    Player *player = &sim->player;
+    if(player->position.y > sim->worldBounds.y + sim->worldBounds.height + SIM_RESPAWN_DEPTH)
+    {
+        player->position = sim->spawnPosition;
+        player->previousPosition = sim->spawnPosition;
+        player->velocityX = 0.0f;
+        player->velocityY = 0.0f;
+    }
+    
+    sim->tick++;
+}
+
+void
+SimClearEvents(SimState *sim)
+{
+    sim->eventCount = 0;
+}
+
+void
+SimShutdown(SimState *sim)
+{
+    UnloadProjectiles(&sim->player.gun.bullets);
+    MemFree(sim->collisionCandidates.indices);
+    sim->collisionCandidates = {};
+}
+
+static SimEvent*
+PushSimEvent(SimState *sim, SimEventType type)
+{
+    if(sim->eventCount == MAX_SIM_EVENTS) return(0);
+    
+    SimEvent *event = &sim->events[sim->eventCount++];
+    *event = {};
+    event->type = type;
+    return(event);
+}
+
+static TmxObjectGroup*
+GetCollisionLayer(TmxMap *map)
+{
+    for(uint32_t i = 0;
+        i < map->layersLength;
+        i++)
+    {
+        if(map->layers[i].type == LAYER_TYPE_OBJECT_GROUP &&
+           TextIsEqual(map->layers[i].name, "Collision"))
+        {
+            return &map->layers[i].exact.objectGroup;
+        }
+    }
+    
+    TraceLog(LOG_ERROR, "Could not locate Collision layer");
+    return(0);
+}
+
+static void
+ClearPlayerInputEdges(PlayerInput *input)
+{
+    // A frame may also run several ticks, and each press should only act once
+    input->jumpPressed = false;
+    input->jumpReleased = false;
+    input->firePressed = false;
+    input->reloadPressed = false;
+}
+
+void
+UpdatePlayer(SimState *sim, PlayerInput *input, float delta)
+{
+    PROFILE_ZONE("UpdatePlayer");
+    
+    Player *player = &sim->player;
+    player->previousPosition = player->position;
+    
+    if(!sim->collisionGroup) return;
+    
+    UpdatePlayerMovement(player, input, delta);
+    UpdatePlayerCollision(player, sim->collisionGroup, &sim->collisionCandidates, delta);
+    UpdatePlayerAnimation(player, delta);
+    UpdatePlayerWeapon(sim, input, delta);
+}
+
+static void
+UpdatePlayerMovement(Player *player, PlayerInput *input, float delta)
+{
+    // Movement
+    float acceleration = 1000.0f;
+    float deceleration = 600.0f;
+    float max_speed = PLAYER_HOR_SPD;
+    
+    float inputX = 0.0f;
+    if(input->moveLeft && !player->inAir)
+    {
+        inputX = -1.0f;
+        player->facingRight = false;
+    }
+    if(input->moveRight && !player->inAir)
+    {
+        inputX = 1.0f;
+        player->facingRight = true;
+    }
+    
+    // Apply acceleration and deceleration
+    if(inputX != 0.0f)
+    {
+        player->velocityX += inputX * acceleration * delta;
+        
+        // Clamp to max speed
+        player->velocityX = Clamp(player->velocityX, -max_speed, max_speed);
+    }
+    else if(!player->inAir)
+    {
+        float decelerateAmount = deceleration * delta;
+        
+        if(player->velocityX > 0)
+        {
+            player->velocityX -= decelerateAmount;
+            if(player->velocityX < 0) player->velocityX = 0;
+        }
+        else if(player->velocityX < 0)
+        {
+            player->velocityX += decelerateAmount;
+            if(player->velocityX > 0) player->velocityX = 0;
+        }
+    }
+    
+    // Jumping
+    if(input->jumpPressed && player->canJump)
+    {
+        player->velocityY = -PLAYER_JUMP_SPD;
+        player->canJump = false;
+        player->inAir = true;
+    }
+    
+    if(input->jumpReleased && player->velocityY < 0)
+    {
+        player->velocityY *= 0.5f;
+    }
+}
+
+// Moves the player by their velocity, stopping at the first surface in the way and sliding along it with what's
+// left of the move. The whole tick's move is swept at once, so no speed or frame time carries the player through a
+// wall, and the work done is the same however fast they go.
+static void
+UpdatePlayerCollision(Player *player, TmxObjectGroup *objGroup, CollisionCandidates *candidates, float delta)
+{
+    PROFILE_ZONE("UpdatePlayerCollision");
+    
+    Vector2 move = { player->velocityX * delta, player->velocityY * delta };
+    Rectangle box = GetPlayerBox(player);
+    
+    // Every slide stays within the box swept by the whole move, so one query covers them all. It reaches a little
+    // further down for the ground probe below.
+    Rectangle swept = {};
+    swept.x = fminf(box.x, box.x + move.x);
+    swept.y = fminf(box.y, box.y + move.y);
+    swept.width = fmaxf(box.x, box.x + move.x) + box.width - swept.x;
+    swept.height = fmaxf(box.y, box.y + move.y) + box.height + PLAYER_GROUND_PROBE - swept.y;
+    
+    uint32_t candidateCount = QueryCollisionCandidates(objGroup, swept, candidates);
+    
+    bool grounded = false;
+    for(int iteration = 0;
+        iteration < PLAYER_SWEEP_ITERATIONS && (move.x != 0.0f || move.y != 0.0f);
+        iteration++)
+    {
+        float hitTime;
+        Vector2 hitNormal;
+        uint32_t hitIndex;
+        if(!SweepCollisionCandidates(objGroup, candidates->indices, candidateCount, box, move, &hitTime, &hitNormal,
+                                     &hitIndex))
+        {
+            player->position.x += move.x;
+            player->position.y += move.y;
+            break;
+        }
+        
+        // Advance to the point of contact, then put the touching edges exactly together so rounding can't leave
+        // the player inside what they hit
+        Vector2 wallMin;
+        Vector2 wallMax;
+        GetCollisionBounds(objGroup, hitIndex, &wallMin, &wallMax);
+        player->position.x += move.x * hitTime;
+        player->position.y += move.y * hitTime;
+        if(hitNormal.x < 0.0f) player->position.x = wallMin.x - player->width / 2;
+        if(hitNormal.x > 0.0f) player->position.x = wallMax.x + player->width / 2;
+        if(hitNormal.y < 0.0f)
+        {
+            // Landed
+            player->position.y = wallMin.y;
+            player->velocityY = 0.0f;
+            grounded = true;
+        }
+        if(hitNormal.y > 0.0f)
+        {
+            // Hit a ceiling
+            player->position.y = wallMax.y + player->height;
+            player->velocityY = 0.0f;
+        }
+        
+        // Slide. What's left of the move carries on along the surface. Walls only stop the move, not the velocity,
+        // so a jump that clears the top of one still carries the player over it.
+        move.x *= 1.0f - hitTime;
+        move.y *= 1.0f - hitTime;
+        if(hitNormal.x != 0.0f) move.x = 0.0f;
+        if(hitNormal.y != 0.0f) move.y = 0.0f;
+        box = GetPlayerBox(player);
+    }
+    
+    // A player standing still on the ground doesn't move into it, so look for it just underfoot
+    if(!grounded && player->velocityY >= 0.0f)
+    {
+        Vector2 probe = { 0.0f, PLAYER_GROUND_PROBE };
+        float hitTime;
+        Vector2 hitNormal;
+        uint32_t hitIndex;
+        Vector2 groundMin;
+        Vector2 groundMax;
+        if(SweepCollisionCandidates(objGroup, candidates->indices, candidateCount, box, probe, &hitTime, &hitNormal,
+                                    &hitIndex) && hitNormal.y < 0.0f &&
+           GetCollisionBounds(objGroup, hitIndex, &groundMin, &groundMax))
+        {
+            player->position.y = groundMin.y;
+            player->velocityY = 0.0f;
+            grounded = true;
+        }
+    }
+    
+    if(!grounded)
+    {
+        // Nothing underfoot
+        player->inAir = true;
+        player->velocityY += GRAVITY * delta;
+        player->canJump = false;
+    }
+    else
+    {
+        player->canJump = true;
+        player->inAir = false;
+    }
+}
+
+static Rectangle
+GetPlayerBox(Player *player)
+{
+    Rectangle box = {};
+    box.x = player->position.x - player->width / 2;
+    box.y = player->position.y - player->height;
+    box.width = player->width;
+    box.height = player->height;
+    return(box);
+}
+
+static void
+UpdatePlayerAnimation(Player *player, float delta)
+{
+    if(!player->inAir && player->velocityX != 0)
+    {
+        player->idle = false;
+        player->running.frameTimer += delta;
+        if(player->running.frameTimer >= player->running.frameSpeed)
+        {
+            player->running.frameTimer = 0.0f;
+            player->running.currentFrame++;
+            
+            if(player->running.currentFrame >= player->running.frameCount)
+                player->running.currentFrame = 0;
+        }
+    }
+    else
+    {
+        player->idle = true;
+    }
+}
+
+static void
+UpdatePlayerWeapon(SimState *sim, PlayerInput *input, float delta)
+{
+    Player *player = &sim->player;
+    player->gun.coolDown -= delta;
+    
+    // Handle overheat
+    if(player->gun.overHeated)
+    {
+        player->gun.overHeatTimer -= delta;
+        if(player->gun.overHeatTimer <= 0)
+        {
+            player->gun.overHeated = false;
+            
+        }
+        
+        // Exit function now if gun is overheated
+        return;
+    }
+    
+    // Rapid fire
+    if(input->fireDown && player->gun.coolDown <= 0 && player->gun.rounds > 0)
+    {
+        player->gunFiring = true;
+        SpawnBullet(player);
+        player->firing.currentFrame = 0;
+        PushSimEvent(sim, SIM_EVENT_GUN_FIRED);
+        
+        // Lower cool down if holding down fire
+        player->gun.coolDown = 0.1f;
+        player->gun.rounds--;
+        
+        // Check if mag is empty overheat
+        if(player->gun.rounds == 0)
+        {
+            player->gun.overHeated = true;
+            PushSimEvent(sim, SIM_EVENT_GUN_OVERHEATED);
+        }
+        
+    }
+    
+    // Firing gun
+    if(input->firePressed && player->gun.coolDown <= 0)
+    {
+        if(player->gun.rounds > 0)
+        {
+            player->gunFiring = true;
+            SpawnBullet(player);
+            player->gun.rounds--;
+            player->firing.currentFrame = 0;
+            PushSimEvent(sim, SIM_EVENT_GUN_FIRED);
+            
+        }
+        else
+        {
+            PushSimEvent(sim, SIM_EVENT_GUN_DRY_FIRED);
+        }
+        
+    }
+    
+    if(player->gunFiring)
+    {
+        
+        player->firing.frameTimer += delta;
+        if(player->firing.frameTimer >= player->firing.frameSpeed)
+        {
+            player->firing.frameTimer = 0.0f;
+            player->firing.currentFrame++;
+            
+            if(player->firing.currentFrame >= player->firing.frameCount)
+            {
+                player->gunFiring = false;
+                player->firing.currentFrame = 0;
+            }
+        }
+    }
+    
+    // Reloading
+    if(input->reloadPressed && !player->gun.overHeated)
+    {
+        PushSimEvent(sim, SIM_EVENT_GUN_RELOADED);
+        player->gun.rounds = player->gun.roundsPerMagazine;
+    }
+}
+
+static void
+SpawnBullet(Player *player)
+{
+    Vector2 position = { player->position.x, player->position.y - 33 };
+    
+    float direction = player->facingRight ? 1.0f : -1.0f;
+    Vector2 velocity = { direction * player->gun.bulletSpeed, 0.0f };
+    
+    SpawnProjectile(&player->gun.bullets, position, velocity);
+}
+
+static void
+UpdateBullets(ProjectilePool *pool, SimState *sim, float delta)
+{
+    PROFILE_ZONE("UpdateBullets");
+    
+    // Integrate first in a branch-free pass over plain float arrays so the compiler can vectorize it
+    float * __restrict x = pool->x;
+    float * __restrict y = pool->y;
+    float * __restrict previousX = pool->previousX;
+    float * __restrict previousY = pool->previousY;
+    const float * __restrict vx = pool->vx;
+    const float * __restrict vy = pool->vy;
+    int count = pool->count;
+    for(int i = 0;
+        i < count;
+        i++)
+    {
+        previousX[i] = x[i];
+        previousY[i] = y[i];
+        x[i] += vx[i] * delta;
+        y[i] += vy[i] * delta;
+    }
+    
+    // Walk backwards so the projectile swapped into a despawned slot has already been checked
+    for(int i = count - 1;
+        i >= 0;
+        i--)
+    {
+        Vector2 from = { pool->previousX[i], pool->previousY[i] };
+        Vector2 to = { pool->x[i], pool->y[i] };
+        
+        // Stop at the first wall along this tick's movement, slopes included
+        TmxRaycastHit hit;
+        if(sim->collisionGroup && RaycastTMXObjectGroup(sim->collisionGroup, from, to, &hit))
+        {
+            SimEvent *event = PushSimEvent(sim, SIM_EVENT_PROJECTILE_IMPACT);
+            if(event)
+            {
+                event->impact.position = hit.point;
+                event->impact.normal = hit.normal;
+                event->impact.objectIndex = hit.objectIndex;
+            }
+            DespawnProjectile(pool, i);
+            continue;
+        }
+        
+        // Despawn once well outside the map
+        Rectangle bounds = sim->worldBounds;
+        if(to.x < bounds.x - PROJECTILE_DESPAWN_MARGIN ||
+           to.x > bounds.x + bounds.width + PROJECTILE_DESPAWN_MARGIN ||
+           to.y < bounds.y - PROJECTILE_DESPAWN_MARGIN ||
+           to.y > bounds.y + bounds.height + PROJECTILE_DESPAWN_MARGIN)
+        {
+            DespawnProjectile(pool, i);
+        }
+    }
+}
+
+// The first of the candidate rectangles that a box moving by 'delta' would touch, and the face of it touched
+static bool
+SweepCollisionCandidates(TmxObjectGroup *objGroup, uint32_t *candidates, uint32_t candidateCount, Rectangle box,
+                         Vector2 delta, float *hitTime, Vector2 *hitNormal, uint32_t *hitIndex)
+{
+    bool hit = false;
+    *hitTime = 1.0f;
+    for(uint32_t i = 0;
+        i < candidateCount;
+        i++)
+    {
+        Vector2 wallMin;
+        Vector2 wallMax;
+        if(!GetCollisionBounds(objGroup, candidates[i], &wallMin, &wallMax)) continue;
+        
+        float time;
+        Vector2 normal;
+        if(SweepBoxBounds(box, delta, wallMin, wallMax, &time, &normal) && (!hit || time < *hitTime))
+        {
+            hit = true;
+            *hitTime = time;
+            *hitNormal = normal;
+            *hitIndex = candidates[i];
+        }
+    }
+    
+    return(hit);
+}
+
+// Swept AABB test. Finds the fraction of 'delta' a moving box covers before it touches the box from 'wallMin' to
+// 'wallMax', and the face of it touched. Boxes that overlap by no more than COLLISION_SKIN are only touching, so one
+// resting against or sliding along a surface is neither stuck to it nor let through it. Boxes already further
+// inside, or moving apart, don't hit.
+static bool
+SweepBoxBounds(Rectangle box, Vector2 delta, Vector2 wallMin, Vector2 wallMax, float *hitTime, Vector2 *hitNormal)
+{
+    float entryTime = -INFINITY;
+    float exitTime = INFINITY;
+    Vector2 normal = {};
+    
+    if(delta.x == 0.0f)
+    {
+        if(box.x + box.width <= wallMin.x + COLLISION_SKIN || box.x >= wallMax.x - COLLISION_SKIN) return(false);
+    }
+    else
+    {
+        // Moving right leads with the box's right edge into the wall's left edge, and the other way around
+        float speed = fabsf(delta.x);
+        float gap = delta.x > 0.0f ? wallMin.x - (box.x + box.width) : box.x - wallMax.x;
+        float pass = delta.x > 0.0f ? wallMax.x - box.x : box.x + box.width - wallMin.x;
+        float nearTime = (gap > -COLLISION_SKIN ? fmaxf(gap, 0.0f) : gap) / speed;
+        if(nearTime > entryTime)
+        {
+            entryTime = nearTime;
+            normal = { delta.x > 0.0f ? -1.0f : 1.0f, 0.0f };
+        }
+        exitTime = fminf(exitTime, pass / speed);
+    }
+    
+    if(delta.y == 0.0f)
+    {
+        if(box.y + box.height <= wallMin.y + COLLISION_SKIN || box.y >= wallMax.y - COLLISION_SKIN) return(false);
+    }
+    else
+    {
+        float speed = fabsf(delta.y);
+        float gap = delta.y > 0.0f ? wallMin.y - (box.y + box.height) : box.y - wallMax.y;
+        float pass = delta.y > 0.0f ? wallMax.y - box.y : box.y + box.height - wallMin.y;
+        float nearTime = (gap > -COLLISION_SKIN ? fmaxf(gap, 0.0f) : gap) / speed;
+        // Reaching a corner at the same time as a wall lands on it rather than stopping against it
+        if(nearTime >= entryTime)
+        {
+            entryTime = nearTime;
+            normal = { 0.0f, delta.y > 0.0f ? -1.0f : 1.0f };
+        }
+        exitTime = fminf(exitTime, pass / speed);
+    }
+    
+    if(entryTime < 0.0f || entryTime > 1.0f || entryTime >= exitTime) return(false);
+    
+    *hitTime = entryTime;
+    *hitNormal = normal;
+    return(true);
+}
+
+// Objects that a box moving within 'area' may touch, written to 'candidates'. A collision layer has its objects'
+// boxes packed side by side, and comparing all of them several at a time beats visiting the cells of its grid for a
+// level's worth of walls. Both queries count every overlap even past the capacity given, so a query that didn't
+// fit is simply run again once the buffer has grown to that count.
+static uint32_t
+QueryCollisionCandidates(TmxObjectGroup *objGroup, Rectangle area, CollisionCandidates *candidates)
+{
+    if(!candidates->indices) ReserveCollisionCandidates(candidates, COLLISION_CANDIDATES_INITIAL_CAPACITY);
+    
+    uint32_t candidateCount = 0;
+    for(int attempt = 0;
+        attempt < 2;
+        attempt++)
+    {
+        if(objGroup->bounds)
+        {
+            candidateCount = QueryTMXObjectGroupBounds(objGroup, area, candidates->indices, candidates->capacity);
+        }
+        else
+        {
+            candidateCount = QueryTMXObjectGroupGrid(objGroup, area, candidates->indices, candidates->capacity);
+        }
+        if(candidateCount <= candidates->capacity || !ReserveCollisionCandidates(candidates, candidateCount)) break;
+    }
+    
+    if(candidateCount > candidates->capacity)
+    {
+        TraceLog(LOG_WARNING, "Collision query found %u objects but only %u fit. The rest are ignored this tick.",
+                 candidateCount, candidates->capacity);
+        candidateCount = candidates->capacity;
+    }
+    return(candidateCount);
+}
+
+static bool
+ReserveCollisionCandidates(CollisionCandidates *candidates, uint32_t capacity)
+{
+    if(capacity <= candidates->capacity) return(true);
+    
+    // Grow geometrically so a slowly widening query doesn't reallocate every tick
+    uint32_t newCapacity = candidates->capacity ? candidates->capacity : COLLISION_CANDIDATES_INITIAL_CAPACITY;
+    while(newCapacity < capacity) newCapacity *= 2;
+    
+    uint32_t *indices = (uint32_t *)MemRealloc(candidates->indices, (unsigned int)(newCapacity * sizeof(uint32_t)));
+    if(!indices)
+    {
+        TraceLog(LOG_WARNING, "Failed to grow collision candidates to %u", newCapacity);
+        return(false);
+    }
+    
+    candidates->indices = indices;
+    candidates->capacity = newCapacity;
+    return(true);
+}
+
+// The edges of a rectangular collision object, read from the group's packed bounds when it has them. False for
+// objects of any other shape, which the player passes through.
+static bool
+GetCollisionBounds(TmxObjectGroup *objGroup, uint32_t index, Vector2 *boundsMin, Vector2 *boundsMax)
+{
+    TmxObjectBounds *bounds = objGroup->bounds;
+    if(bounds && (bounds->rectanglesOnly || objGroup->objects[index].type == OBJECT_TYPE_RECTANGLE))
+    {
+        *boundsMin = { bounds->minX[index], bounds->minY[index] };
+        *boundsMax = { bounds->maxX[index], bounds->maxY[index] };
+        return(true);
+    }
+    
+    TmxObject *obj = &objGroup->objects[index];
+    if(obj->type != OBJECT_TYPE_RECTANGLE) return(false);
+    *boundsMin = { (float)obj->x, (float)obj->y };
+    *boundsMax = { (float)(obj->x + obj->width), (float)(obj->y + obj->height) };
+    return(true);
+}
+
+static bool
+ReserveProjectiles(ProjectilePool *pool, int capacity)
+{
+    if(capacity <= pool->capacity) return(true);
+    
+    unsigned int size = (unsigned int)(capacity * sizeof(float));
+    float *x = (float *)MemRealloc(pool->x, size);
+    if(x) pool->x = x;
+    float *y = (float *)MemRealloc(pool->y, size);
+    if(y) pool->y = y;
+    float *vx = (float *)MemRealloc(pool->vx, size);
+    if(vx) pool->vx = vx;
+    float *vy = (float *)MemRealloc(pool->vy, size);
+    if(vy) pool->vy = vy;
+    float *previousX = (float *)MemRealloc(pool->previousX, size);
+    if(previousX) pool->previousX = previousX;
+    float *previousY = (float *)MemRealloc(pool->previousY, size);
+    if(previousY) pool->previousY = previousY;
+    
+    // Arrays that did grow are kept, but the pool is only as big as its smallest array
+    if(!x || !y || !vx || !vy || !previousX || !previousY)
+    {
+        TraceLog(LOG_WARNING, "Failed to grow projectile pool to %d", capacity);
+        return(false);
+    }
+    
+    pool->capacity = capacity;
+    return(true);
+}
+
+static int
+SpawnProjectile(ProjectilePool *pool, Vector2 position, Vector2 velocity)
+{
+    if(pool->count == pool->capacity)
+    {
+        int capacity = pool->capacity ? pool->capacity * 2 : PROJECTILE_INITIAL_CAPACITY;
+        if(!ReserveProjectiles(pool, capacity)) return(-1);
+    }
+    
+    int index = pool->count++;
+    pool->x[index] = position.x;
+    pool->y[index] = position.y;
+    pool->vx[index] = velocity.x;
+    pool->vy[index] = velocity.y;
+    pool->previousX[index] = position.x;
+    pool->previousY[index] = position.y;
+    
+    return(index);
+}
+
+static void
+DespawnProjectile(ProjectilePool *pool, int index)
+{
+    int last = --pool->count;
+    pool->x[index] = pool->x[last];
+    pool->y[index] = pool->y[last];
+    pool->vx[index] = pool->vx[last];
+    pool->vy[index] = pool->vy[last];
+    pool->previousX[index] = pool->previousX[last];
+    pool->previousY[index] = pool->previousY[last];
+}
+
+static void
+UnloadProjectiles(ProjectilePool *pool)
+{
+    MemFree(pool->x);
+    MemFree(pool->y);
+    MemFree(pool->vx);
+    MemFree(pool->vy);
+    MemFree(pool->previousX);
+    MemFree(pool->previousY);
+    *pool = {};
+}
+
+int
+InitPlayer(Player *player, float spriteWidth, float spriteHeight)
+{
+    player->position = { 400, 280 };
+    player->previousPosition = player->position;
+    //player->velocityX = 0.0f;
+    //player->velocityY = 0.0f;
+    
+    // NOTE(trist007): in Aseprite there were about 28 pixels to the right if player was facing right
+    // if player was facing left there were about 18 pixels to the right, I'm going to have to adjust this
+    // in Aseprite at some point
+    player->width = spriteWidth - PLAYER_SPRITE_TRIM;
+    player->height = spriteHeight;
+    player->facingRight = true;
+    player->canJump = false;
+    player->inAir = false;
+    player->idle = true;
+    player->gunFiring = false;
+    
+    //player->running.currentFrame = 0;
+    player->running.frameCount = 8;
+    //player->running.frameTimer = 0.0f;
+    player->running.frameSpeed = 0.1f;  // 10 frames per second (1.0/10)
+    
+    //player->firing.currentFrame = 0;
+    player->firing.frameCount = 4;
+    //player->firing.frameTimer = 0.0f;
+    player->firing.frameSpeed = 0.1f;  // 10 frames per second (1.0/10)
+    
+    player->gun.coolDown = 0.2f;
+    player->gun.overHeatTimer = 2.0f;
+    player->gun.rounds = 7;
+    player->gun.roundsPerMagazine = 7;
+    player->gun.bulletRadius = 2.0f;
+    player->gun.bulletSpeed = PROJECTILE_SPEED;
+    player->gun.bullets = {};
+    ReserveProjectiles(&player->gun.bullets, PROJECTILE_INITIAL_CAPACITY);
+    
+    return(0);
+}
+
+uint32_t
+PackPlayerInput(PlayerInput *input)
+{
+    uint32_t bits = 0;
+    if(input->moveLeft) bits |= PLAYER_INPUT_MOVE_LEFT;
+    if(input->moveRight) bits |= PLAYER_INPUT_MOVE_RIGHT;
+    if(input->fireDown) bits |= PLAYER_INPUT_FIRE_DOWN;
+    if(input->jumpPressed) bits |= PLAYER_INPUT_JUMP_PRESSED;
+    if(input->jumpReleased) bits |= PLAYER_INPUT_JUMP_RELEASED;
+    if(input->firePressed) bits |= PLAYER_INPUT_FIRE_PRESSED;
+    if(input->reloadPressed) bits |= PLAYER_INPUT_RELOAD_PRESSED;
+    return(bits);
+}
+
+void
+UnpackPlayerInput(uint32_t bits, PlayerInput *input)
+{
+    input->moveLeft = (bits & PLAYER_INPUT_MOVE_LEFT) != 0;
+    input->moveRight = (bits & PLAYER_INPUT_MOVE_RIGHT) != 0;
+    input->fireDown = (bits & PLAYER_INPUT_FIRE_DOWN) != 0;
+    input->jumpPressed = (bits & PLAYER_INPUT_JUMP_PRESSED) != 0;
+    input->jumpReleased = (bits & PLAYER_INPUT_JUMP_RELEASED) != 0;
+    input->firePressed = (bits & PLAYER_INPUT_FIRE_PRESSED) != 0;
+    input->reloadPressed = (bits & PLAYER_INPUT_RELOAD_PRESSED) != 0;
+}
+
+// Everything that carries over from one tick to the next, field by field so struct padding never gets hashed.
+// previousPosition is left out since it is only ever a copy of an earlier position.
+uint64_t
+HashSimState(SimState *sim)
+{
+    Player *player = &sim->player;
+    Gun *gun = &player->gun;
+    ProjectilePool *pool = &gun->bullets;
+    
+    uint64_t hash = 14695981039346656037ULL; // FNV-1a offset basis
+    hash = HashBytes(hash, &sim->tick, sizeof(sim->tick));
+    hash = HashBytes(hash, &player->position, sizeof(player->position));
+    hash = HashBytes(hash, &player->velocityX, sizeof(player->velocityX));
+    hash = HashBytes(hash, &player->velocityY, sizeof(player->velocityY));
+    
+    uint8_t flags[5] = { player->facingRight, player->canJump, player->inAir, player->idle, player->gunFiring };
+    hash = HashBytes(hash, flags, sizeof(flags));
+    
+    hash = HashBytes(hash, &player->running.currentFrame, sizeof(player->running.currentFrame));
+    hash = HashBytes(hash, &player->running.frameTimer, sizeof(player->running.frameTimer));
+    hash = HashBytes(hash, &player->firing.currentFrame, sizeof(player->firing.currentFrame));
+    hash = HashBytes(hash, &player->firing.frameTimer, sizeof(player->firing.frameTimer));
+    
+    uint8_t overHeated = gun->overHeated;
+    hash = HashBytes(hash, &gun->coolDown, sizeof(gun->coolDown));
+    hash = HashBytes(hash, &gun->rounds, sizeof(gun->rounds));
+    hash = HashBytes(hash, &overHeated, sizeof(overHeated));
+    hash = HashBytes(hash, &gun->overHeatTimer, sizeof(gun->overHeatTimer));
+    
+    size_t arraySize = (size_t)pool->count * sizeof(float);
+    hash = HashBytes(hash, &pool->count, sizeof(pool->count));
+    hash = HashBytes(hash, pool->x, arraySize);
+    hash = HashBytes(hash, pool->y, arraySize);
+    hash = HashBytes(hash, pool->vx, arraySize);
+    hash = HashBytes(hash, pool->vy, arraySize);
+    
+    return(hash);
+}
+
+// Hash of the parts of a map the simulation reads: its size and the Collision layer's shapes. A replay on a map
+// with a different hash would diverge, whichever file either map was loaded from.
+uint64_t
+HashSimMap(TmxMap *map)
+{
+    uint64_t hash = 14695981039346656037ULL; // FNV-1a offset basis
+    uint32_t size[4] = { map->width, map->height, map->tileWidth, map->tileHeight };
+    hash = HashBytes(hash, size, sizeof(size));
+    
+    TmxObjectGroup *objGroup = GetCollisionLayer(map);
+    if(!objGroup) return(hash);
+    
+    hash = HashBytes(hash, &objGroup->objectsLength, sizeof(objGroup->objectsLength));
+    for(uint32_t i = 0;
+        i < objGroup->objectsLength;
+        i++)
+    {
+        TmxObject *object = &objGroup->objects[i];
+        uint32_t type = (uint32_t)object->type;
+        hash = HashBytes(hash, &type, sizeof(type));
+        hash = HashBytes(hash, &object->aabb, sizeof(object->aabb));
+        hash = HashBytes(hash, &object->pointsLength, sizeof(object->pointsLength));
+        if(object->points) hash = HashBytes(hash, object->points, object->pointsLength * sizeof(Vector2));
+    }
+    
+    return(hash);
+}
+
+static uint64_t
+HashBytes(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for(size_t i = 0;
+        i < size;
+        i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL; // FNV-1a prime
+    }
+    return(hash);
+}
+
+void
+InitInputRecording(InputRecording *recording, const char *mapPath, uint64_t mapHash, float spriteWidth,
+                   float spriteHeight)
+{
+    *recording = {};
+    recording->header.magic = INPUT_RECORDING_MAGIC;
+    recording->header.version = INPUT_RECORDING_VERSION;
+    recording->header.tickRate = SIM_TICK_RATE;
+    recording->header.spriteWidth = spriteWidth;
+    recording->header.spriteHeight = spriteHeight;
+    recording->header.mapHash = mapHash;
+    strncpy(recording->header.mapPath, mapPath, INPUT_RECORDING_MAP_PATH_SIZE - 1);
+}
+
+bool
+AppendInputRecordingFrame(InputRecording *recording, uint32_t input, uint64_t stateHash)
+{
+    if(recording->header.frameCount == recording->frameCapacity)
+    {
+        uint32_t capacity = recording->frameCapacity ? recording->frameCapacity * 2 : SIM_TICK_RATE * 60;
+        unsigned int size = (unsigned int)(capacity * sizeof(InputRecordingFrame));
+        InputRecordingFrame *frames = (InputRecordingFrame *)MemRealloc(recording->frames, size);
+        if(!frames)
+        {
+            TraceLog(LOG_WARNING, "Failed to grow input recording to %u frames", capacity);
+            return(false);
+        }
+        recording->frames = frames;
+        recording->frameCapacity = capacity;
+    }
+    
+    InputRecordingFrame *frame = &recording->frames[recording->header.frameCount++];
+    frame->stateHash = stateHash;
+    frame->input = input;
+    frame->reserved = 0;
+    return(true);
+}
+
+bool
+SaveInputRecording(InputRecording *recording, const char *fileName)
+{
+    unsigned int framesSize = (unsigned int)(recording->header.frameCount * sizeof(InputRecordingFrame));
+    unsigned int size = (unsigned int)sizeof(InputRecordingHeader) + framesSize;
+    unsigned char *data = (unsigned char *)MemAlloc(size);
+    if(!data) return(false);
+    
+    memcpy(data, &recording->header, sizeof(InputRecordingHeader));
+    if(framesSize) memcpy(data + sizeof(InputRecordingHeader), recording->frames, framesSize);
+    bool saved = SaveFileData(fileName, data, (int)size);
+    MemFree(data);
+    
+    return(saved);
+}
+
+bool
+LoadInputRecording(InputRecording *recording, const char *fileName)
+{
+    *recording = {};
+    
+    int size = 0;
+    unsigned char *data = LoadFileData(fileName, &size);
+    if(!data) return(false);
+    
+    InputRecordingHeader header = {};
+    if(size >= (int)sizeof(InputRecordingHeader)) memcpy(&header, data, sizeof(InputRecordingHeader));
+    
+    uint64_t expectedSize = sizeof(InputRecordingHeader) + (uint64_t)header.frameCount * sizeof(InputRecordingFrame);
+    if(header.magic != INPUT_RECORDING_MAGIC || header.version != INPUT_RECORDING_VERSION ||
+       header.tickRate != SIM_TICK_RATE || (uint64_t)size != expectedSize)
+    {
+        TraceLog(LOG_WARNING, "\"%s\" is not an input recording this build can replay", fileName);
+        UnloadFileData(data);
+        return(false);
+    }
+    header.mapPath[INPUT_RECORDING_MAP_PATH_SIZE - 1] = 0;
+    
+    recording->header = header;
+    if(header.frameCount)
+    {
+        unsigned int framesSize = (unsigned int)(header.frameCount * sizeof(InputRecordingFrame));
+        recording->frames = (InputRecordingFrame *)MemAlloc(framesSize);
+        if(!recording->frames)
+        {
+            UnloadFileData(data);
+            *recording = {};
+            return(false);
+        }
+        memcpy(recording->frames, data + sizeof(InputRecordingHeader), framesSize);
+        recording->frameCapacity = header.frameCount;
+    }
+    UnloadFileData(data);
+    
+    return(true);
+}
+
+void
+UnloadInputRecording(InputRecording *recording)
+{
+    MemFree(recording->frames);
+    *recording = {};
+}
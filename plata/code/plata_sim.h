@@ -0,0 +1,251 @@
+#ifndef PLATA_SIM_H
+#define PLATA_SIM_H
+
+// Simulation core: the player, their gun and its projectiles, moving through the map's Collision layer. Nothing here
+// touches the window, audio, keyboard or GPU. The platform layer fills in a PlayerInput, calls SimStep() once per
+// SIM_DT tick, and reacts to the SimEvents each step queues up (sounds, effects).
+
+#include "raylib.h"
+#include "raymath.h"
+
+extern "C"
+{
+#include "raytmx.h"
+}
+
+#include "plata_profiler.h"
+
+#define GRAVITY 400
+#define PLAYER_JUMP_SPD 350.0f
+#define PLAYER_HOR_SPD 300.0f
+#define PLAYER_SPRITE_TRIM 30.0f
+#define PROJECTILE_INITIAL_CAPACITY 64
+#define PROJECTILE_DESPAWN_MARGIN 400.0f
+#define PROJECTILE_SPEED 900.0f
+#define COLLISION_CANDIDATES_INITIAL_CAPACITY 64
+#define COLLISION_SKIN 0.01f // Overlaps this shallow, in pixels, count as touching
+#define PLAYER_SWEEP_ITERATIONS 3 // Surfaces the player can stop at and slide along in one tick
+#define PLAYER_GROUND_PROBE 0.05f // How far, in pixels, under a player that isn't rising the ground is looked for
+#define MAX_SIM_EVENTS 256
+#define SIM_TICK_RATE 120
+#define SIM_DT (1.0f / SIM_TICK_RATE)
+#define SIM_RESPAWN_DEPTH 400.0f
+#define INPUT_RECORDING_MAGIC 0x43455250 // "PREC"
+#define INPUT_RECORDING_VERSION 4 // Also bumped when the simulation changes, as old recordings would diverge
+#define INPUT_RECORDING_MAP_PATH_SIZE 128
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+// Live projectiles are packed into [0, count) of every array, so updating and drawing never skip dead slots.
+// Spawning appends and despawning moves the last projectile into the freed index.
+typedef struct ProjectilePool
+{
+    float *x;
+    float *y;
+    float *vx;
+    float *vy;
+    
+    // Positions before the last tick, for interpolated drawing
+    float *previousX;
+    float *previousY;
+    
+    int count;
+    int capacity;
+} ProjectilePool;
+
+// Indexes of the collision objects a move may touch, filled in by QueryCollisionCandidates(). Grows to fit the
+// largest query so far, so a long sweep or a dense layer never loses walls.
+typedef struct CollisionCandidates
+{
+    uint32_t *indices;
+    uint32_t capacity;
+} CollisionCandidates;
+
+typedef struct ProjectileImpact
+{
+    Vector2 position;
+    Vector2 normal; // Zero if the projectile started inside the object
+    uint32_t objectIndex; // Into the collision group's objects
+} ProjectileImpact;
+
+typedef struct AnimationFrame
+{
+    int currentFrame;
+    int frameCount;
+    float frameTimer;
+    float frameSpeed;
+} AnimationFrame;
+
+typedef struct Gun
+{
+    float coolDown;;
+    int rounds;
+    int roundsPerMagazine;
+    bool overHeated;
+    float overHeatTimer;
+    
+    ProjectilePool bullets;
+    float bulletRadius;
+    float bulletSpeed;
+} Gun;
+
+typedef struct PlayerInput
+{
+    // Held buttons, sampled every frame
+    bool moveLeft;
+    bool moveRight;
+    bool fireDown;
+    
+    // Presses and releases, latched until the next simulation tick consumes them
+    bool jumpPressed;
+    bool jumpReleased;
+    bool firePressed;
+    bool reloadPressed;
+} PlayerInput;
+
+// Bits of a PlayerInput packed into an InputRecordingFrame
+typedef enum
+{
+    PLAYER_INPUT_MOVE_LEFT = 1 << 0,
+    PLAYER_INPUT_MOVE_RIGHT = 1 << 1,
+    PLAYER_INPUT_FIRE_DOWN = 1 << 2,
+    PLAYER_INPUT_JUMP_PRESSED = 1 << 3,
+    PLAYER_INPUT_JUMP_RELEASED = 1 << 4,
+    PLAYER_INPUT_FIRE_PRESSED = 1 << 5,
+    PLAYER_INPUT_RELOAD_PRESSED = 1 << 6
+} PlayerInputBits;
+
+typedef struct Player {
+    Vector2 position;
+    Vector2 previousPosition;
+    float velocityX;
+    float velocityY;
+    float height;
+    float width;
+    bool facingRight;
+    bool canJump;
+    bool inAir;
+    bool idle;
+    bool gunFiring;
+    
+    // Running animation
+    AnimationFrame running;
+    
+    // Gun firing animation
+    AnimationFrame firing;
+    
+    // Gun parameters
+    Gun gun;
+} Player;
+
+typedef enum
+{
+    SIM_EVENT_GUN_FIRED = 0,
+    SIM_EVENT_GUN_DRY_FIRED,
+    SIM_EVENT_GUN_RELOADED,
+    SIM_EVENT_GUN_OVERHEATED,
+    SIM_EVENT_PROJECTILE_IMPACT,
+    SIM_EVENT_COUNT
+} SimEventType;
+
+typedef struct SimEvent
+{
+    SimEventType type;
+    ProjectileImpact impact; // SIM_EVENT_PROJECTILE_IMPACT only
+} SimEvent;
+
+typedef struct SimState
+{
+    Player player;
+    
+    // Resolved once after the map loads
+    TmxObjectGroup *collisionGroup;
+    Rectangle worldBounds;
+    
+    // Scratch space for collision queries, kept between ticks so it is only allocated as it grows
+    CollisionCandidates collisionCandidates;
+    
+    // Where the player starts, and is put back after falling off the map
+    Vector2 spawnPosition;
+    
+    // Queued by SimStep() in the order they happened, until SimClearEvents(). Events past MAX_SIM_EVENTS are dropped.
+    SimEvent events[MAX_SIM_EVENTS];
+    int eventCount;
+    
+    uint64_t tick;
+} SimState;
+
+// A session's input, one frame per tick, along with a hash of the state that tick produced. Replaying the inputs
+// through SimStep() from the same map must reproduce every hash. Saved as the header followed by the frames.
+typedef struct InputRecordingHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t tickRate;
+    uint32_t frameCount;
+    float spriteWidth; // As passed to SimInit()
+    float spriteHeight;
+    uint64_t mapHash; // HashSimMap() of the map that was recorded on
+    char mapPath[INPUT_RECORDING_MAP_PATH_SIZE];
+} InputRecordingHeader;
+
+typedef struct InputRecordingFrame
+{
+    uint64_t stateHash; // HashSimState() after the tick
+    uint32_t input; // PlayerInputBits before the tick
+    uint32_t reserved;
+} InputRecordingFrame;
+
+typedef struct InputRecording
+{
+    InputRecordingHeader header;
+    InputRecordingFrame *frames;
+    uint32_t frameCapacity;
+} InputRecording;
+
+//----------------------------------------------------------------------------------
+// Function Forward Declarations / Prototypes
+//----------------------------------------------------------------------------------
+bool SimInit(SimState *sim, TmxMap *map, float spriteWidth, float spriteHeight);
+void SimStep(SimState *sim, PlayerInput *input, float delta);
+void SimClearEvents(SimState *sim);
+void SimShutdown(SimState *sim);
+static SimEvent *PushSimEvent(SimState *sim, SimEventType type);
+static TmxObjectGroup *GetCollisionLayer(TmxMap *map);
+static void ClearPlayerInputEdges(PlayerInput *input);
+void UpdatePlayer(SimState *sim, PlayerInput *input, float delta);
+static void UpdatePlayerMovement(Player *player, PlayerInput *input, float delta);
+static void UpdatePlayerCollision(Player *player, TmxObjectGroup *objGroup, CollisionCandidates *candidates,
+                                  float delta);
+static Rectangle GetPlayerBox(Player *player);
+static void UpdatePlayerAnimation(Player *player, float delta);
+static void UpdatePlayerWeapon(SimState *sim, PlayerInput *input, float delta);
+static void SpawnBullet(Player *player);
+static void UpdateBullets(ProjectilePool *pool, SimState *sim, float delta);
+static bool SweepCollisionCandidates(TmxObjectGroup *objGroup, uint32_t *candidates, uint32_t candidateCount,
+                                     Rectangle box, Vector2 delta, float *hitTime, Vector2 *hitNormal,
+                                     uint32_t *hitIndex);
+static bool SweepBoxBounds(Rectangle box, Vector2 delta, Vector2 wallMin, Vector2 wallMax, float *hitTime,
+                           Vector2 *hitNormal);
+static uint32_t QueryCollisionCandidates(TmxObjectGroup *objGroup, Rectangle area, CollisionCandidates *candidates);
+static bool ReserveCollisionCandidates(CollisionCandidates *candidates, uint32_t capacity);
+static bool GetCollisionBounds(TmxObjectGroup *objGroup, uint32_t index, Vector2 *boundsMin, Vector2 *boundsMax);
+static bool ReserveProjectiles(ProjectilePool *pool, int capacity);
+static int SpawnProjectile(ProjectilePool *pool, Vector2 position, Vector2 velocity);
+static void DespawnProjectile(ProjectilePool *pool, int index);
+static void UnloadProjectiles(ProjectilePool *pool);
+int InitPlayer(Player *player, float spriteWidth, float spriteHeight);
+uint32_t PackPlayerInput(PlayerInput *input);
+void UnpackPlayerInput(uint32_t bits, PlayerInput *input);
+uint64_t HashSimState(SimState *sim);
+uint64_t HashSimMap(TmxMap *map);
+static uint64_t HashBytes(uint64_t hash, const void *data, size_t size);
+void InitInputRecording(InputRecording *recording, const char *mapPath, uint64_t mapHash, float spriteWidth,
+                        float spriteHeight);
+bool AppendInputRecordingFrame(InputRecording *recording, uint32_t input, uint64_t stateHash);
+bool SaveInputRecording(InputRecording *recording, const char *fileName);
+bool LoadInputRecording(InputRecording *recording, const char *fileName);
+void UnloadInputRecording(InputRecording *recording);
+
+#endif // PLATA_SIM_H
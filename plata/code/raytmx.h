@@ -34,7 +34,7 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include <math.h> /* floor(), INFINITY */
 #include <stddef.h> /* NULL */
 #include <stdint.h> /* int32_t, uint32_t */
-#include <stdlib.h> /* atoi(), strtoul() */
+#include <stdlib.h> /* atoi(), qsort(), strtoul() */
 #include <string.h> /* memcpy(), memset(), strcpy(), strcpy_s() strlen(), strncpy(), strncpy_s() */
 
 #include "raylib.h"
@@ -56,6 +56,12 @@ extern "C" {
      */
     typedef Texture2D (*LoadTextureCallback)(const char* fileName);
     
+    /**
+     * Object index given by the batched collision checks, such as CheckCollisionTMXObjectGroupRecs(), to queries that
+     * didn't collide with any object.
+     */
+    #define TMX_NO_OBJECT UINT32_MAX
+    
     /**
      * Bit flags passed to SetTraceLogFlagsTMX() that optionally disable the logging of specific TMX elements.
      */
@@ -72,6 +78,14 @@ extern "C" {
         LOG_SKIP_WANG_TILES = 512 /**< Skip Wang tiles of Wang sets (<wangset>s). */
     };
     
+    /**
+     * Bit flags of TmxTileDraw's 'flags'.
+     */
+    enum tmx_tile_draw_flags {
+        TILE_DRAW_EXISTS = 1, /**< The GID belongs to a tile of one of the map's tilesets. */
+        TILE_DRAW_ANIMATED = 2 /**< The tile is an animation. Its 'frameGid' changes as the map is animated. */
+    };
+    
     /**
      * Identifiers for the possible layer types.
      */
@@ -184,9 +198,23 @@ extern "C" {
         Texture2D texture; /**< The image as a raylib texture loaded into VRAM, if loading was successful. */
     } TmxImage;
     
+    /**
+     * Model of a <chunk> element. Tile layers of infinite maps are made of these rather than one array of tiles. Only
+     * chunks near the camera are decoded, see UpdateTMXChunkResidency(), so a chunk's tiles may not be available.
+     */
+    typedef struct tmx_tile_chunk {
+        int32_t x; /**< X position, in tiles, of the chunk's top-left tile. May be negative. */
+        int32_t y; /**< Y position, in tiles, of the chunk's top-left tile. May be negative. */
+        uint32_t width; /**< Width of the chunk in tiles. */
+        uint32_t height; /**< Height of the chunk in tiles. */
+        char* data; /**< The chunk's tiles as they were encoded within the document, using the layer's encoding and
+                         compression. Kept so that the chunk can be decoded again after being evicted. */
+        uint32_t* tiles; /**< Array of 'width' times 'height' tile GIDs while the chunk is resident, or NULL. */
+    } TmxTileChunk;
+    
     /**
      * Model of a <layer> element when combined with the 'TmxLayer' model. Defines a tile layer with a fixed-size list of
-     * tile Global IDs (GIDs).
+     * tile Global IDs (GIDs) or, for infinite maps, a table of chunks of tiles.
      */
     typedef struct tmx_tile_layer {
         uint32_t width; /**< Width of the layer in tiles. */
@@ -195,6 +223,25 @@ extern "C" {
         char* compression; /**< [optional] Compression used to compress tiles. May be NULL, "gzip," "zlib," or "zstd." */
         uint32_t* tiles; /**< Array of tile Global IDs (GIDs) contained by this tile layer. */
         uint32_t tilesLength; /**< Length of the 'tiles' array. */
+        TmxTileChunk* chunks; /**< [optional] Array of chunks of tiles, in place of 'tiles', if the map is infinite. */
+        uint32_t chunksLength; /**< Length of the 'chunks' array. */
+        uint32_t chunkWidth; /**< Width, in tiles, shared by every chunk. A tile's chunk X coordinate is its X position
+                                  divided by this. */
+        uint32_t chunkHeight; /**< Height, in tiles, shared by every chunk. A tile's chunk Y coordinate is its Y
+                                   position divided by this. */
+        int32_t chunksMinX, chunksMinY, chunksMaxX, chunksMaxY; /**< Inclusive bounds, in chunk coordinates, of the
+                                                                     layer's chunks. */
+        uint32_t* chunkTable; /**< Hash table, keyed by chunk coordinates, of indexes into 'chunks' plus one. Zero marks
+                                   an empty slot. */
+        uint32_t chunkTableCapacity; /**< Length of the 'chunkTable' array. Always a power of two. */
+        int32_t residentMinX, residentMinY, residentMaxX, residentMaxY; /**< Inclusive bounds, in chunk coordinates,
+                                                                             of the chunks made resident by the last
+                                                                             call to UpdateTMXChunkResidency(). */
+        uint64_t* solidBits; /**< Bitmap, one bit per tile in row-major order, of the tiles whose collision shapes fill
+                                  their whole cell. Baked at load time. NULL for layers of chunks. */
+        uint64_t* shapeBits; /**< Bitmap, laid out like 'solidBits', of the other tiles with collision shapes. Their
+                                  shapes still need testing. NULL for layers of chunks. */
+        uint32_t bitsStride; /**< Number of 64-bit words in each row of the 'solidBits' and 'shapeBits' bitmaps. */
     } TmxTileLayer;
     
     /**
@@ -267,6 +314,67 @@ extern "C" {
         Rectangle aabb; /**< Axis-Aligned Bounding Box (AABB). */
     } TmxObject;
     
+    /**
+     * Uniform grid over the Axis-Aligned Bounding Boxes (AABBs) of an object group's objects. Built once at load time so
+     * that queries only visit the objects in the cells a search area overlaps rather than every object in the group.
+     */
+    typedef struct tmx_object_grid {
+        float originX; /**< X coordinate, in pixels, of the left edge of the grid's first column. */
+        float originY; /**< Y coordinate, in pixels, of the top edge of the grid's first row. */
+        float cellWidth; /**< Width of a cell in pixels. */
+        float cellHeight; /**< Height of a cell in pixels. */
+        uint32_t columns; /**< Number of cells along the X axis. */
+        uint32_t rows; /**< Number of cells along the Y axis. */
+        uint32_t* cellStarts; /**< Array of 'columns' * 'rows' + 1 offsets into 'cellObjects'. The objects of cell N are
+                                   found at indexes 'cellStarts[N]' up to but excluding 'cellStarts[N + 1]'. */
+        uint32_t* cellObjects; /**< Array of indexes of the group's objects, grouped by cell. An object is listed once
+                                    for every cell its AABB overlaps. */
+        uint32_t cellObjectsLength; /**< Length of the 'cellObjects' array. */
+    } TmxObjectGrid;
+
+    /**
+     * Copy of the Axis-Aligned Bounding Boxes (AABBs) of an object group's objects as a structure of arrays, so that
+     * the batched collision checks can compare several AABBs at once with SIMD. Built once at load time.
+     */
+    typedef struct tmx_object_bounds {
+        float* minX; /**< Array of the left edges, in pixels, of the objects' AABBs. */
+        float* minY; /**< Array of the top edges, in pixels, of the objects' AABBs. */
+        float* maxX; /**< Array of the right edges, in pixels, of the objects' AABBs. */
+        float* maxY; /**< Array of the bottom edges, in pixels, of the objects' AABBs. */
+        uint32_t length; /**< Length of each array. The group's 'objectsLength' rounded up to a multiple of eight. The
+                              entries past the last object are empty boxes that collide with nothing. */
+        bool rectanglesOnly; /**< When true, indicates every object is a rectangle. The arrays then hold the objects'
+                                  exact shapes, so overlapping AABBs are colliding objects. */
+    } TmxObjectBounds;
+
+    /**
+     * Node of an object group's bounding volume hierarchy. An inner node's first child directly follows it in the
+     * 'nodes' array while its second child is found at 'start'. A leaf lists objects instead of having children.
+     */
+    typedef struct tmx_object_bvh_node {
+        float minX; /**< Left edge, in pixels, of the union of the AABBs of every object beneath the node. */
+        float minY; /**< Top edge, in pixels, of the union of the AABBs of every object beneath the node. */
+        float maxX; /**< Right edge, in pixels, of the union of the AABBs of every object beneath the node. */
+        float maxY; /**< Bottom edge, in pixels, of the union of the AABBs of every object beneath the node. */
+        uint32_t start; /**< For a leaf, the index into 'objectIndices' of its first object. For an inner node, the
+                             index into 'nodes' of its second child. */
+        uint32_t count; /**< Number of objects listed by a leaf. Zero for inner nodes. */
+        uint32_t lowestObject; /**< Lowest index into the group's 'objects' array of the objects beneath the node. */
+    } TmxObjectBvhNode;
+
+    /**
+     * Bounding Volume Hierarchy (BVH) over the Axis-Aligned Bounding Boxes (AABBs) of an object group's objects. Built
+     * once at load time by splitting the objects where the sum of the halves' perimeters weighted by their object
+     * counts is lowest, a two-dimensional Surface Area Heuristic (SAH). Queries walk down only the branches their area
+     * or ray reaches. Moving objects at runtime keeps the tree's shape but needs its boxes refit to stay correct.
+     */
+    typedef struct tmx_object_bvh {
+        TmxObjectBvhNode* nodes; /**< Array of nodes, depth first. The root is the first. */
+        uint32_t nodesLength; /**< Length of the 'nodes' array. */
+        uint32_t* objectIndices; /**< Array of indexes into the group's 'objects' array, grouped by leaf. */
+        uint32_t objectIndicesLength; /**< Length of the 'objectIndices' array, equal to the group's 'objectsLength'. */
+    } TmxObjectBvh;
+
     /**
      * Model of an <objectgroup> element when combined with the 'TmxLayer' model. Defines an object layer of an arbitrary
      * number of objects of varying types.
@@ -280,6 +388,16 @@ extern "C" {
         TmxObject* objects; /**< Array of objects contained by this object layer. */
         uint32_t objectsLength; /**< Length of the 'objects' array. */
         uint32_t* ySortedObjects; /**< Array of indexes of 'objects' sorted by the objects' y-coordinates. */
+        TmxObjectGrid* grid; /**< [optional] Spatial index of 'objects' used by QueryTMXObjectGroupGrid(). Built for
+                                  object layers when the map is loaded, and detached by UpdateTMXObjectGroupBounds()
+                                  since it can't follow objects that move. May be NULL. */
+        TmxObjectBounds* bounds; /**< [optional] Copy of the objects' AABBs used by the batched collision checks, such
+                                      as CheckCollisionTMXObjectGroupRecs(). Built for object layers when the map is
+                                      loaded. May be NULL. */
+        TmxObjectBvh* bvh; /**< [optional] Bounding volume hierarchy over 'objects' used by the first-collision
+                                checks, QueryTMXObjectGroupBVH(), RaycastTMXObjectGroup() and
+                                EnumerateTMXObjectGroupCollisions(). Built for object layers of at least
+                                TMX_BVH_MIN_OBJECTS objects when the map is loaded. May be NULL. */
     } TmxObjectGroup;
     
     /**
@@ -395,6 +513,8 @@ extern "C" {
         uint32_t gid; /**< Global ID (GID) unique to the tile, used for lookups. 0 means the tile is effectively unused. */
         Rectangle sourceRect; /**< Sub-rectangle within a tileset to extract that is to be drawn. */
         Texture2D texture; /**< Texture in VRAM to be used to draw. May be used whole or as a source of a sub-rectangle. */
+        Vector2 texCoordsMin; /**< Top-left corner of 'sourceRect' as texture coordinates, in the [0.0, 1.0] range. */
+        Vector2 texCoordsMax; /**< Bottom-right corner of 'sourceRect' as texture coordinates, in the [0.0, 1.0] range. */
         Vector2 offset; /**< Offset in pixels to be applied to the tile, derived from the tileset. */
         TmxAnimation animation; /**< [optional] Animation. Lists GIDs to be drawn temporarily and periodically. */
         bool hasAnimation; /**< When true, indicates 'animation' is assigned. */
@@ -403,9 +523,29 @@ extern "C" {
         TmxObjectGroup objectGroup; /**< [optional] 0+ objects representing collision information unique to the tile. */
     } TmxTile;
     
+    /**
+     * The few bytes of a tile read when drawing it as part of a tile layer, packed so that a layer's draw loop stays in
+     * cache. Everything else about the tile, including its animation and collision objects, stays in TmxTile.
+     */
+    typedef struct tmx_tile_draw {
+        uint32_t frameGid; /**< GID to draw in place of this tile. Its own GID unless it's an animation, in which
+                                case the GID of the animation's current frame. */
+        uint16_t textureIndex; /**< Index of the tile's texture within the map's 'tileTextures' array. */
+        uint16_t flags; /**< Bit flags from the tmx_tile_draw_flags enumeration. */
+        uint16_t texCoords[4]; /**< 'texCoordsMin' and 'texCoordsMax' of the TmxTile, in that order, scaled from the
+                                    [0.0, 1.0] range to the [0, 65535] range. */
+        int16_t offsetX; /**< X offset in pixels to be applied to the tile, derived from the tileset. */
+        int16_t offsetY; /**< Y offset in pixels to be applied to the tile, derived from the tileset. */
+        uint16_t width; /**< Width of the tile's source rectangle in pixels. */
+        uint16_t height; /**< Height of the tile's source rectangle in pixels. */
+    } TmxTileDraw;
+    
     /**
      * Model of a <map> element along with some pre-calculated objects for efficient drawing.
      */
+    struct raytmx_arena; /* Forward declaration. Opaque to users of the library. */
+    struct raytmx_render_cache; /* Forward declaration. Opaque to users of the library. */
+    
     typedef struct tmx_map {
         char* fileName; /**< File name of the TMX file with extension. */
         TmxOrientation orientation; /**< Map orientation. May be orthogonal, isometric, staggered, or hexagonal. */
@@ -427,8 +567,68 @@ extern "C" {
         TmxTile* gidsToTiles; /**< Array of pre-calculated tile metadata with all the values needed to quickly draw a tile
                                    given its GID. Allocated such that gidsToTiles[1] returns the data of tile GID 1. */
         uint32_t gidsToTilesLength; /**< Length of the 'gidsToTiles' array. */
+        TmxTileDraw* tileDraws; /**< Compact copy of what drawing each tile of 'gidsToTiles' needs, also indexed by
+                                     GID and with the same length. */
+        Texture2D* tileTextures; /**< Textures of the tilesets' images, referenced by the 'tileDraws' array. */
+        uint32_t tileTexturesLength; /**< Length of the 'tileTextures' array. */
+        uint32_t* animatedGids; /**< GIDs of every animated tile, in ascending order. Only these are visited by
+                                     AnimateTMX() and AnimateTMXEx(). */
+        uint32_t animatedGidsLength; /**< Length of the 'animatedGids' array. */
+        uint32_t* changedGids; /**< GIDs, from 'animatedGids', whose animations changed frame during the last call to
+                                    AnimateTMX() or AnimateTMXEx(). Allocated with the same length as 'animatedGids'. */
+        uint32_t changedGidsLength; /**< Number of GIDs in the 'changedGids' array. */
+        struct raytmx_arena* arena; /**< Memory from which the map, its arrays, and its strings were allocated, or the
+                                         mapping of a .tmxb file. Released all at once by UnloadTMX(). */
+        struct raytmx_render_cache* renderCache; /**< [optional] Tile layers pre-rendered in chunks. Created by
+                                                      LoadTMXRenderCache(). May be NULL. */
     } TmxMap;
     
+    /**
+     * Cursor over the tiles of a tile layer overlapping with some area. Each iteration's state is held entirely by its
+     * iterator so any number of iterations may be in progress at once, nested or on different threads, and abandoning
+     * one early has no effect on others. Initialize with InitTMXTileLayerIterator() then call NextTMXTileLayerTile().
+     */
+    typedef struct tmx_tile_layer_iterator {
+        const TmxMap* map; /**< Map containing the layer being iterated. */
+        const TmxTileLayer* layer; /**< Tile layer being iterated. */
+        int fromX; /**< Initial X position, tile not pixel, that row-by-row iteration begins at. */
+        int toX; /**< Final X position, tile not pixel, that each row ends at. */
+        int toY; /**< Final Y position, tile not pixel, that iteration ends at. */
+        int stepX; /**< Either +1 or -1 depending on the map's render order. */
+        int stepY; /**< Either +1 or -1 depending on the map's render order. */
+        int currentX; /**< Current tile X position (column) within the iteration. */
+        int currentY; /**< Current tile Y position (row) within the iteration. */
+        const TmxTileChunk* chunk; /**< For layers made of chunks, the chunk of the last tile. Neighboring tiles usually
+                                        share a chunk so this saves looking it up again. */
+        bool isDone; /**< When true, there are no more tiles to be provided. */
+    } TmxTileLayerIterator;
+
+    /**
+     * The nearest object hit by a line segment, as found by RaycastTMXObjectGroup().
+     */
+    typedef struct tmx_raycast_hit {
+        uint32_t objectIndex; /**< Index into the group's 'objects' array of the object hit. */
+        float time; /**< Fraction, from zero to one, of the way along the segment at which the object was hit. */
+        Vector2 point; /**< Position, in pixels, at which the object was hit. */
+        Vector2 normal; /**< Unit normal of the edge that was hit, facing back along the segment. Zero if the segment
+                             began inside the object. */
+    } TmxRaycastHit;
+    
+    /**
+     * Progress of a map being loaded in the background, as returned by UpdateTMXAsync().
+     */
+    typedef enum tmx_async_load_status {
+        ASYNC_LOAD_PARSING = 0, /**< The worker thread is parsing documents and decoding images. */
+        ASYNC_LOAD_UPLOADING, /**< Decoded images are being uploaded to VRAM by UpdateTMXAsync(). */
+        ASYNC_LOAD_DONE, /**< The map is complete and can be taken with FinishTMXAsync(). */
+        ASYNC_LOAD_FAILED /**< The map could not be loaded. FinishTMXAsync() will return NULL. */
+    } TmxAsyncLoadStatus;
+    
+    /**
+     * Handle to a map being loaded in the background. Created by LoadTMXAsync() and released by FinishTMXAsync().
+     */
+    typedef struct tmx_async_load TmxAsyncLoad;
+    
     /**
      * Given a path to TMX document, parse it and create an equivalent model that can be, among other uses, quickly drawn.
      * This function allocates memory and loads textures into VRAM. To clean up, use UnloadTMX().
@@ -446,6 +646,64 @@ extern "C" {
      */
     RAYTMX_DEC void UnloadTMX(TmxMap* map);
     
+    /**
+     * Save a loaded map as a baked, binary (.tmxb) file that LoadTMXBinary() can load without any parsing. The file
+     * holds the fully-resolved models, including pre-calculated values like the GIDs-to-tiles array, y-sorted object
+     * indexes, text lines, and spatial grids. Pointers are stored as offsets so the file is position-independent, but
+     * it is only compatible with builds of raytmx with the same pointer size and models.
+     *
+     * @param map A map previously loaded with LoadTMX() or LoadTMXBinary().
+     * @param fileName File name and/or path of the .tmxb file to be written. An existing file is overwritten.
+     * @return True if the file was written, or false if writing failed for any reason.
+     */
+    RAYTMX_DEC bool ExportTMXBinary(const TmxMap* map, const char* fileName);
+    
+    /**
+     * Load a map previously baked by ExportTMXBinary(). The file is memory-mapped, copy-on-write, and its offsets are
+     * fixed up in place so the time taken is proportional to reading the file rather than parsing XML. Textures are
+     * loaded from the images' sources, relative to the directory of the .tmxb file, just as LoadTMX() would. To clean
+     * up, use UnloadTMX().
+     *
+     * @param fileName File name and/or path referencing a .tmxb file on disk to be loaded.
+     * @return A model of the map, or NULL if the file is missing, invalid, or was exported by an incompatible build.
+     */
+    RAYTMX_DEC TmxMap* LoadTMXBinary(const char* fileName);
+    
+    /**
+     * Begin loading a map on a background thread. The thread parses the TMX document, and any TSX and TX documents it
+     * references, and decodes their images into RAM. Textures can only be created on the thread that owns the OpenGL
+     * context so uploading the decoded images is left to UpdateTMXAsync(), called on that thread once per frame. The
+     * calling thread is free to keep updating and drawing in the meantime, including other maps. The callback set with
+     * SetLoadTextureTMX() is only ever called from the calling thread and must not be changed until the load finishes.
+     *
+     * @param fileName File name and/or path referencing a TMX document on disk to be loaded.
+     * @return A handle to be polled with UpdateTMXAsync() and released with FinishTMXAsync(), or NULL if the thread
+     *         could not be started.
+     */
+    RAYTMX_DEC TmxAsyncLoad* LoadTMXAsync(const char* fileName);
+    
+    /**
+     * Advance a background load. Once the worker thread is done, decoded images are uploaded to VRAM, and cached, until
+     * the given time budget is spent. At least one image is uploaded per call so that loading always progresses. Once
+     * the last is uploaded, the map's textures are filled in. Must be called from the thread that called
+     * LoadTMXAsync().
+     *
+     * @param load A handle returned by LoadTMXAsync().
+     * @param timeBudget Time, in seconds, that may be spent uploading images during this call (e.g. 0.004).
+     * @return The status of the load after this call.
+     */
+    RAYTMX_DEC TmxAsyncLoadStatus UpdateTMXAsync(TmxAsyncLoad* load, double timeBudget);
+    
+    /**
+     * Complete a background load and release its handle. A load that is not yet done is completed first, blocking
+     * until the worker thread is done and uploading every remaining image regardless of time. To cancel a load, finish
+     * it and unload the map. Must be called from the thread that called LoadTMXAsync().
+     *
+     * @param load A handle returned by LoadTMXAsync(). It is invalid after this call.
+     * @return The loaded map, to be unloaded with UnloadTMX(), or NULL if loading failed for any reason.
+     */
+    RAYTMX_DEC TmxMap* FinishTMXAsync(TmxAsyncLoad* load);
+    
     /**
      * Draw the entirety of the given map at the given position.
      * When a camera is also passed to this function, parallaxed scrolling can be applied to layers with parallax factors
@@ -492,6 +750,70 @@ extern "C" {
      */
     RAYTMX_DEC void AnimateTMX(TmxMap* map);
     
+    /**
+     * Progress the animations of the given map by the given time. Unlike AnimateTMX(), the time step is up to the
+     * caller so animations may follow a fixed-step simulation, be slowed, sped up, or paused. Only animated tiles are
+     * visited. The GIDs of those that changed frame are listed in the map's 'changedGids' array until the next call.
+     *
+     * @param map A loaded map model to be animated.
+     * @param dt Time, in seconds, by which to progress the animations.
+     * @return The number of animated tiles that changed frame. This is also assigned to the map's 'changedGidsLength'.
+     */
+    RAYTMX_DEC uint32_t AnimateTMXEx(TmxMap* map, float dt);
+    
+    /**
+     * Rebuild the map's GIDs-to-tiles array, and what's derived from it, from its tilesets. This is done by LoadTMX()
+     * and only needs repeating after a tileset has been changed, such as by assigning its image a new texture.
+     * Animations restart from their first frames. The previous arrays stay allocated until the map is unloaded so
+     * rebuilding should be rare. A render cache isn't updated and should be reloaded with LoadTMXRenderCache().
+     *
+     * @param map A loaded map model with at least one tileset.
+     * @return True if the arrays were rebuilt, or false if the map has no tiles or memory ran out. The map is left as
+     *         it was if false.
+     */
+    RAYTMX_DEC bool RebuildTMXTiles(TmxMap* map);
+    
+    /**
+     * Pre-render every tile layer of the given map into square chunks of render textures. Once loaded, DrawTMX() and
+     * DrawTMXLayers() draw a handful of chunks per tile layer rather than every visible tile. Chunks are rendered
+     * immediately so this must be called outside of BeginMode2D() and BeginTextureMode(). Calling this again replaces
+     * the existing cache. The cache is unloaded by UnloadTMX() or UnloadTMXRenderCache().
+     *
+     * @param map A loaded map model whose tile layers are to be cached.
+     * @param chunkTiles Width and height, in tiles, of each chunk. If zero, TMX_CHUNK_TILES is used.
+     */
+    RAYTMX_DEC void LoadTMXRenderCache(TmxMap* map, uint32_t chunkTiles);
+    
+    /**
+     * Re-render the cached chunks containing animated tiles whose frames changed since the chunks were last rendered.
+     * Chunks without animations are never re-rendered. This is intended to be called once per frame, after AnimateTMX()
+     * or AnimateTMXEx(), and outside of BeginMode2D() and BeginTextureMode(). Does nothing if the map has no render
+     * cache.
+     *
+     * @param map A loaded map model with a render cache.
+     */
+    RAYTMX_DEC void UpdateTMXRenderCache(TmxMap* map);
+    
+    /**
+     * Unload the render textures and memory of a map's render cache. Tile layers are then drawn tile by tile again.
+     *
+     * @param map A loaded map model with or without a render cache.
+     */
+    RAYTMX_DEC void UnloadTMXRenderCache(TmxMap* map);
+    
+    /**
+     * Decode the chunks of an infinite map's tile layers within the given radius of the camera's target and release
+     * those outside of it. Tiles of chunks that aren't resident are treated as empty when drawing and checking for
+     * collisions, so the radius should cover the screen and wherever collisions are checked. However large the map,
+     * at most (2 * radius + 1) squared chunks per tile layer are decoded at once. This is intended to be called once
+     * per frame. Does nothing for maps that aren't infinite.
+     *
+     * @param map A loaded map model whose chunks are to be loaded and evicted.
+     * @param camera The camera whose target, in pixels, is the center of the resident chunks.
+     * @param radius Number of chunks to keep resident on every side of the chunk containing the camera's target.
+     */
+    RAYTMX_DEC void UpdateTMXChunkResidency(TmxMap* map, Camera2D camera, uint32_t radius);
+    
     /**
      * Check for collisions between two objects of arbitrary type. Objects that are not primitive shapes, namely text and
      * tiles, are treated as rectangles.
@@ -648,7 +970,174 @@ extern "C" {
      */
     RAYTMX_DEC bool CheckCollisionTMXObjectGroupPolyEx(TmxObjectGroup group, Vector2* points, int pointCount,
                                                        Rectangle aabb, TmxObject* outputObject);
+
+    /**
+     * Check each of an array of rectangles for collisions with the given object group in one pass, such as the hitboxes
+     * of every enemy at once. Each rectangle is found to collide with the same object CheckCollisionTMXObjectGroupRec()
+     * would find. The group's 'bounds', if it has them, are compared with each rectangle several at a time.
+     * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+     *
+     * @param group The object group whose 0+ objects will be checked for collisions.
+     * @param recs An array of rectangles to check.
+     * @param recsLength Length of the 'recs' array.
+     * @param objectIndices Output array, as long as 'recs', assigned with the index into the group's 'objects' array of
+     *                      the object each rectangle collided with, or TMX_NO_OBJECT if it collided with none.
+     * @return The number of rectangles that collided with an object.
+     */
+    RAYTMX_DEC uint32_t CheckCollisionTMXObjectGroupRecs(const TmxObjectGroup* group, const Rectangle* recs,
+                                                         uint32_t recsLength, uint32_t* objectIndices);
+    
+    /**
+     * Check each of an array of points for collisions with the given object group in one pass, such as the positions of
+     * every bullet at once. Each point is found to collide with the same object CheckCollisionTMXObjectGroupPoint()
+     * would find. The group's 'bounds', if it has them, are compared with each point several at a time.
+     * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+     *
+     * @param group The object group whose 0+ objects will be checked for collisions.
+     * @param points An array of points to check.
+     * @param pointsLength Length of the 'points' array.
+     * @param objectIndices Output array, as long as 'points', assigned with the index into the group's 'objects' array
+     *                      of the object each point collided with, or TMX_NO_OBJECT if it collided with none.
+     * @return The number of points that collided with an object.
+     */
+    RAYTMX_DEC uint32_t CheckCollisionTMXObjectGroupPoints(const TmxObjectGroup* group, const Vector2* points,
+                                                           uint32_t pointsLength, uint32_t* objectIndices);
+    
+    /**
+     * Find the objects of the given object group whose Axis-Aligned Bounding Boxes (AABBs) overlap or touch the given
+     * rectangle, as QueryTMXObjectGroupGrid() does, but by comparing every object's AABB from the group's 'bounds'
+     * several at a time. For groups of up to a few thousand objects this is usually quicker than visiting the grid's
+     * cells. All three queries, this one, QueryTMXObjectGroupGrid() and QueryTMXObjectGroupBVH(), count AABBs that
+     * only touch the rectangle's edges, and so find the same objects.
+     * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+     *
+     * @param group The object group whose 0+ objects will be queried.
+     * @param rec The area to search, such as the box swept by a moving entity from its current to its next position.
+     * @param indices Output array assigned with indexes into the group's 'objects' array, in ascending order.
+     * @param indicesCapacity The length of the 'indices' array. At most this many indexes are written.
+     * @return The number of objects found. If greater than 'indicesCapacity' then only the first 'indicesCapacity'
+     *         indexes were written and the query should be retried with a larger array.
+     */
+    RAYTMX_DEC uint32_t QueryTMXObjectGroupBounds(const TmxObjectGroup* group, Rectangle rec, uint32_t* indices,
+                                                  uint32_t indicesCapacity);
+    
+    /**
+     * Copy the Axis-Aligned Bounding Boxes (AABBs) of an object group's objects into its 'bounds' again, and refit its
+     * bounding volume hierarchy to them. The collision checks and queries use both so they must be updated after
+     * objects are moved or resized at runtime. The hierarchy keeps its shape, so objects moving far from where they
+     * were loaded make its queries slower but never wrong. The spatial grid is static: its cells can't be re-binned
+     * in place, so it is detached (set to NULL) and QueryTMXObjectGroupGrid() checks every object from then on.
+     *
+     * @param group The object group whose objects have changed.
+     */
+    RAYTMX_DEC void UpdateTMXObjectGroupBounds(TmxObjectGroup* group);
+
+    /**
+     * Find the objects of the given object group whose Axis-Aligned Bounding Boxes (AABBs) overlap or touch the given
+     * rectangle. This is a broad phase: callers are expected to perform precise checks on the returned objects. When the
+     * group has a spatial grid only the cells overlapped by the rectangle are visited, otherwise all objects are checked.
+     * AABBs that only touch the rectangle's edges are found, as they are by QueryTMXObjectGroupBounds() and
+     * QueryTMXObjectGroupBVH().
+     * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+     *
+     * @param group The object group whose 0+ objects will be queried.
+     * @param rec The area to search, such as the box swept by a moving entity from its current to its next position.
+     * @param indices Output array assigned with indexes into the group's 'objects' array, in ascending order.
+     * @param indicesCapacity The length of the 'indices' array. At most this many indexes are written.
+     * @return The number of objects found. If greater than 'indicesCapacity' then only the first 'indicesCapacity'
+     *         indexes were written and the query should be retried with a larger array.
+     */
+    RAYTMX_DEC uint32_t QueryTMXObjectGroupGrid(const TmxObjectGroup* group, Rectangle rec, uint32_t* indices,
+                                                uint32_t indicesCapacity);
+
+    /**
+     * Find the objects of the given object group whose Axis-Aligned Bounding Boxes (AABBs) overlap or touch the given
+     * rectangle by walking down the group's bounding volume hierarchy, if it has one, or else by checking every
+     * object. The same objects are found as with QueryTMXObjectGroupBounds() and QueryTMXObjectGroupGrid(), including
+     * those whose AABBs only touch the rectangle's edges.
+     * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+     *
+     * @param group The object group whose 0+ objects will be queried.
+     * @param rec The area to search, such as the box swept by a moving entity from its current to its next position.
+     * @param indices Output array assigned with indexes into the group's 'objects' array, in ascending order.
+     * @param indicesCapacity The length of the 'indices' array. At most this many indexes are written.
+     * @return The number of objects found. If greater than 'indicesCapacity' then only 'indicesCapacity' of the
+     *         indexes, not necessarily the lowest, were written and the query should be retried with a larger array.
+     */
+    RAYTMX_DEC uint32_t QueryTMXObjectGroupBVH(const TmxObjectGroup* group, Rectangle rec, uint32_t* indices,
+                                               uint32_t indicesCapacity);
+
+    /**
+     * Find the nearest object of the given object group hit by the line segment from one point to another, such as a
+     * bullet's path over one frame. Polygons and polylines are hit by their edges, and the other shapes, except for
+     * points which can't be hit, by their AABBs. A polyline only closes if its last point is its first. An object the
+     * segment begins inside of is hit immediately. Of objects hit at the same time, the one with the lowest index is
+     * found. The group's bounding volume hierarchy, if it has one, is used to skip objects the segment can't reach or
+     * that are farther than the nearest hit so far.
+     * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+     *
+     * @param group The object group whose 0+ objects will be checked.
+     * @param from The point the segment begins at.
+     * @param to The point the segment ends at.
+     * @param hit Output parameter assigned with the object hit and where. NULL if not wanted.
+     * @return True if the segment hits any object in the object group, or false if it hits none.
+     */
+    RAYTMX_DEC bool RaycastTMXObjectGroup(const TmxObjectGroup* group, Vector2 from, Vector2 to, TmxRaycastHit* hit);
+
+    /**
+     * Find every object of the given object group that collides with the given object, rather than only the first as
+     * CheckCollisionTMXObjectGroupPoly() and the like do. Collisions are decided as by CheckCollisionTMXObjects().
+     * The group's bounding volume hierarchy, if it has one, is used so that only objects near the given one are
+     * checked.
+     * Note: This function assumes the map is positioned at (0, 0). If the map is drawn with an offset, normalize.
+     *
+     * @param group The object group whose 0+ objects will be checked for collisions.
+     * @param object The object to check, of any type, such as an object of another group.
+     * @param indices Output array assigned with indexes into the group's 'objects' array, in ascending order.
+     * @param indicesCapacity The length of the 'indices' array. At most this many indexes are written.
+     * @return The number of objects collided with. If greater than 'indicesCapacity' then only 'indicesCapacity' of the
+     *         indexes, not necessarily the lowest, were written and the call should be retried with a larger array.
+     */
+    RAYTMX_DEC uint32_t EnumerateTMXObjectGroupCollisions(const TmxObjectGroup* group, TmxObject object,
+                                                          uint32_t* indices, uint32_t indicesCapacity);
+
+    /**
+     * Restore the top-down order of an object group's 'ySortedObjects' after its objects' y-coordinates have changed,
+     * such as when objects are moved at runtime. As when loaded, objects sharing a y-coordinate are kept in index order.
+     * The current order is the starting point so the cost depends on how far objects moved past one another: a handful
+     * of objects moving a little each frame costs little more than one pass over the group.
+     *
+     * @param group The object group whose objects have moved.
+     */
+    RAYTMX_DEC void SortTMXObjectGroup(TmxObjectGroup* group);
+
+    /**
+     * Prepare an iterator over the tiles of the given tile layer that overlap with the given area, in the map's render
+     * order. Tiles are then retrieved one at a time with NextTMXTileLayerTile(). The iterator holds no resources so it
+     * does not need to be cleaned up, even if iteration stops early.
+     *
+     * @param iterator The iterator to be (re)initialized.
+     * @param map A loaded map model containing the given tile layer.
+     * @param layer The tile layer within the given map whose tiles will be iterated.
+     * @param viewport The area, in pixels, whose tiles will be iterated, such as the region being drawn to.
+     */
+    RAYTMX_DEC void InitTMXTileLayerIterator(TmxTileLayerIterator* iterator, const TmxMap* map,
+                                             const TmxTileLayer* layer, Rectangle viewport);
     
+    /**
+     * Advance an iterator prepared by InitTMXTileLayerIterator() to its next tile. Iteration is done row-by-row. This
+     * allows the function to be used e.g. "while (NextTMXTileLayerTile(&iterator, ...)) { ... }".
+     *
+     * @param iterator An iterator initialized by InitTMXTileLayerIterator().
+     * @param rawGid Optional output. The Global ID (GID) with possible flip flags. Pass NULL if not wanted.
+     * @param tile Optional output. Metadata of the current tile. Pass NULL if not wanted.
+     * @param tileRect Optional output. The destination rectangle, in pixels, of the current tile. Pass NULL if not
+     *                 wanted.
+     * @return True if the next tile is being provided via the output parameters, or false if iteration is done.
+     */
+    RAYTMX_DEC bool NextTMXTileLayerTile(TmxTileLayerIterator* iterator, uint32_t* rawGid, TmxTile* tile,
+                                         Rectangle* tileRect);
+
     /**
      * Set a custom callback in place of raylib's LoadTexture(). The callback must return a Texture2D and take a const char*
      * as the sole parameter. To unset, pass NULL to this function.
@@ -658,6 +1147,26 @@ extern "C" {
      */
     RAYTMX_DEC void SetLoadTextureTMX(LoadTextureCallback callback);
     
+    /**
+     * Load a texture through raytmx's texture cache. The cache is shared by the whole process: maps and tilesets loaded
+     * with LoadTMX(), and any other caller of this function, get the same texture for the same file name rather than
+     * another copy of it in VRAM. Each call adds a reference that must be released with UnloadTextureTMX(). File names
+     * are compared as given, so the same file reached through different relative paths is loaded more than once.
+     * The callback set with SetLoadTextureTMX(), if any, is used for loading.
+     *
+     * @param fileName Path to the image file to load.
+     * @return The cached or newly-loaded texture. If loading failed, the texture's 'id' is zero.
+     */
+    RAYTMX_DEC Texture2D LoadTextureTMX(const char* fileName);
+    
+    /**
+     * Release a reference to a texture returned by LoadTextureTMX(). The texture is unloaded from VRAM once its last
+     * reference is released. Textures that did not come from the cache are unloaded immediately.
+     *
+     * @param texture A texture returned by LoadTextureTMX().
+     */
+    RAYTMX_DEC void UnloadTextureTMX(Texture2D texture);
+    
     /**
      * Log properties of the given map as a formatted string.
      * SetTraceLogFlagsTMX() may be used to exclude select information.
@@ -686,10 +1195,98 @@ extern "C" {
 #endif
 #include "hoxml.h"
 
+#ifdef _WIN32
+#ifndef _WINDOWS_ /* If <windows.h> wasn't included. It conflicts with raylib so only what's needed is declared. */
+#ifdef __cplusplus
+extern "C" {
+#endif
+__declspec(dllimport) void* __stdcall CreateFileA(const char* lpFileName, unsigned long dwDesiredAccess,
+                                                  unsigned long dwShareMode, void* lpSecurityAttributes,
+                                                  unsigned long dwCreationDisposition,
+                                                  unsigned long dwFlagsAndAttributes, void* hTemplateFile);
+__declspec(dllimport) unsigned long __stdcall GetFileSize(void* hFile, unsigned long* lpFileSizeHigh);
+__declspec(dllimport) void* __stdcall CreateFileMappingA(void* hFile, void* lpFileMappingAttributes,
+                                                         unsigned long flProtect, unsigned long dwMaximumSizeHigh,
+                                                         unsigned long dwMaximumSizeLow, const char* lpName);
+__declspec(dllimport) void* __stdcall MapViewOfFile(void* hFileMappingObject, unsigned long dwDesiredAccess,
+                                                    unsigned long dwFileOffsetHigh, unsigned long dwFileOffsetLow,
+                                                    size_t dwNumberOfBytesToMap);
+__declspec(dllimport) int __stdcall UnmapViewOfFile(const void* lpBaseAddress);
+__declspec(dllimport) int __stdcall CloseHandle(void* hObject);
+__declspec(dllimport) void* __stdcall CreateThread(void* lpThreadAttributes, size_t dwStackSize,
+                                                   unsigned long (__stdcall* lpStartAddress)(void*),
+                                                   void* lpParameter, unsigned long dwCreationFlags,
+                                                   unsigned long* lpThreadId);
+__declspec(dllimport) unsigned long __stdcall WaitForSingleObject(void* hHandle, unsigned long dwMilliseconds);
+#ifdef __cplusplus
+}
+#endif
+#endif /* _WINDOWS_ */
+#else
+#include <fcntl.h> /* open() */
+#include <pthread.h> /* pthread_create(), pthread_join() */
+#include <sys/mman.h> /* mmap(), munmap() */
+#include <sys/stat.h> /* fstat() */
+#include <unistd.h> /* close() */
+#endif /* _WIN32 */
+
+/* Just enough atomics and thread-local storage for LoadTMXAsync()'s worker thread to hand its results back */
+#ifdef _MSC_VER
+#include <intrin.h> /* _InterlockedExchange(), _InterlockedOr() */
+#define RAYTMX_THREAD_LOCAL __declspec(thread)
+#define RAYTMX_ATOMIC_STORE(variable, value) _InterlockedExchange(&(variable), (value))
+#define RAYTMX_ATOMIC_LOAD(variable) _InterlockedOr(&(variable), 0)
+#else
+#define RAYTMX_THREAD_LOCAL __thread
+#define RAYTMX_ATOMIC_STORE(variable, value) __atomic_store_n(&(variable), (value), __ATOMIC_RELEASE)
+#define RAYTMX_ATOMIC_LOAD(variable) __atomic_load_n(&(variable), __ATOMIC_ACQUIRE)
+#endif
+
+/* Object bounds are compared eight at a time with AVX2, or four at a time with SSE or NEON. Which is used is decided */
+/* when compiling: SSE is always available on x86-64 and NEON on ARM64, while AVX2 has to be enabled (/arch:AVX2 or */
+/* -mavx2). Without any of them, they're compared one at a time. */
+#if defined(__AVX2__)
+#define RAYTMX_AVX2
+#include <immintrin.h> /* _mm256_loadu_ps(), _mm256_cmp_ps(), _mm256_movemask_ps() */
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define RAYTMX_SSE
+#include <xmmintrin.h> /* _mm_loadu_ps(), _mm_cmplt_ps(), _mm_movemask_ps() */
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define RAYTMX_NEON
+#include <arm_neon.h> /* vld1q_f32(), vcltq_f32(), vaddvq_u32() */
+#endif
+
 /******************/
 /* Implementation */
 
 #define TMX_LINE_THICKNESS 3.0f /* Thickness, in pixels, that outlines of specific objects are drawn with */
+#ifndef TMX_GRID_CELL_TILES
+#define TMX_GRID_CELL_TILES 4 /* Width and height, in tiles, of a cell within object groups' spatial grids */
+#endif
+#ifndef TMX_ARENA_REGION_SIZE
+#define TMX_ARENA_REGION_SIZE (64 * 1024) /* Minimum size, in bytes, of each region of memory an arena allocates */
+#endif
+#define TMX_ARENA_ALIGNMENT 16 /* Alignment, in bytes, of every allocation made from an arena */
+#define TMX_ARENA_HEADER_SIZE ((sizeof(RaytmxArena) + TMX_ARENA_ALIGNMENT - 1) & ~(size_t)(TMX_ARENA_ALIGNMENT - 1))
+#define TMX_BINARY_MAGIC 0x42584D54 /* "TMXB" when read as a little-endian, 32-bit integer */
+#define TMX_BINARY_VERSION 1 /* Incremented whenever the layout of .tmxb files changes */
+#ifndef TMX_CHUNK_TILES
+#define TMX_CHUNK_TILES 16 /* Default width and height, in tiles, of the chunks of LoadTMXRenderCache() */
+#endif
+#ifndef TMX_TILE_BATCH_SIZE
+#define TMX_TILE_BATCH_SIZE 512 /* Tiles of a tile layer buffered, then drawn in runs of one texture, at a time */
+#endif
+#ifndef TMX_GRID_MAX_CELLS
+#define TMX_GRID_MAX_CELLS 65536 /* Upper limit on cells per spatial grid. Cells are enlarged to stay within it. */
+#endif
+#define TMX_BOUNDS_PADDING 8 /* Object bounds are padded to a multiple of this many, the most compared at once */
+#ifndef TMX_BVH_MIN_OBJECTS
+#define TMX_BVH_MIN_OBJECTS 256 /* Object groups with fewer objects are scanned, which is quicker for so few */
+#endif
+#define TMX_BVH_LEAF_OBJECTS 4 /* Most objects listed by a leaf of an object group's bounding volume hierarchy */
+#define TMX_BVH_BINS 16 /* Candidate split positions, per axis, compared when splitting a hierarchy's node */
+#define TMX_BVH_SAH_DEPTH 32 /* Below this depth, nodes are split in half so that no branch exceeds the stack */
+#define TMX_BVH_STACK_SIZE 64 /* Nodes waiting to be visited by a walk down a hierarchy, at most */
 
 /* Bit flags that GIDs may be masked with in order to indicate transformations for individual tiles */
 enum tmx_flip_flags {
@@ -705,6 +1302,12 @@ typedef enum raytmx_document_format {
     FORMAT_TX /* Object templates */
 } RaytmxDocumentFormat;
 
+typedef enum raytmx_tile_shapes {
+    TILE_SHAPES_NONE = 0, /* The tile has no collision shapes */
+    TILE_SHAPES_SOLID, /* The tile's collision shapes fill its cell and stay within it */
+    TILE_SHAPES_PARTIAL /* The tile has collision shapes that have to be tested one by one */
+} RaytmxTileShapes;
+
 typedef struct raytmx_external_tileset {
     TmxTileset tileset;
     bool isSuccess; /* 'isSuccess' is true when the external tileset was successfully loaded */
@@ -716,12 +1319,109 @@ typedef struct raytmx_object_template {
     bool isSuccess, hasTileset; /* 'isSuccess' is true when the object template was successfully loaded */
 } RaytmxObjectTemplate;
 
-struct raytmx_cached_texture; /* Forward declaration */
+typedef struct raytmx_arena {
+    struct raytmx_arena* previous; /* The region that was filled before this one, or NULL if this is the first */
+    size_t capacity, used; /* Bytes available following this header and how many have been handed out */
+    void* mapping; /* When not NULL, the region's bytes are this memory-mapped file rather than following the header */
+} RaytmxArena; /* Header of a region of memory that allocations are carved out of. A pointer to the newest region is */
+               /* the arena's handle. Allocations are never freed individually, only the whole chain at once. */
+
+typedef struct raytmx_binary_header {
+    uint32_t magic, version; /* TMX_BINARY_MAGIC and the TMX_BINARY_VERSION of the build that exported the file */
+    uint32_t layoutHash; /* Hash of the sizes of a pointer and of the models. Differing builds can't share files. */
+    uint32_t relocationsLength; /* Number of pointers within the data that are stored as offsets */
+    uint64_t dataOffset, dataSize; /* Location, within the file, and size of the models */
+    uint64_t relocationsOffset; /* Location, within the file, of the array of 64-bit offsets, within the data, of the */
+                                /* pointers to be fixed up */
+    uint64_t mapOffset; /* Location, within the data, of the TmxMap */
+} RaytmxBinaryHeader; /* Leads a .tmxb file. Pointers within the data are stored as offsets from the data's start. */
+
+typedef struct raytmx_binary_writer {
+    RaytmxArena** regions; /* The map's arena regions, oldest first */
+    uint64_t* regionOffsets; /* Offset, within 'data', at which each region was copied */
+    uint32_t regionsLength;
+    unsigned char* data; /* Copy of every region that pointers are rewritten within */
+    uint64_t* relocations;
+    uint32_t relocationsLength, relocationsCapacity;
+    bool isSuccess; /* Becomes false if any pointer leads outside of the map's arena, or memory runs out */
+    bool isOutOfMemory; /* Becomes true if the relocations couldn't grow */
+} RaytmxBinaryWriter; /* Intermediate data used internally by ExportTMXBinary() */
+
+typedef struct raytmx_chunk {
+    RenderTexture2D target; /* The chunk's tiles rendered, or an ID of zero if the chunk has no tiles */
+    uint32_t* animatedGids; /* Distinct GIDs of animated tiles within the chunk that cause it to be re-rendered */
+    uint32_t animatedGidsLength;
+    bool isDirty; /* When true, the chunk is to be rendered by the next UpdateTMXRenderCache() */
+} RaytmxChunk;
+
+typedef struct raytmx_layer_chunks {
+    const uint32_t* tiles; /* Tiles of the tile layer the chunks were rendered from. Identifies the layer. */
+    uint32_t tilesLength;
+    RaytmxChunk* chunks; /* Array of 'columns' * 'rows' chunks, row by row */
+} RaytmxLayerChunks;
+
+typedef struct raytmx_render_cache {
+    RaytmxArena* arena; /* Memory of the cache itself. Render textures are unloaded separately. */
+    uint32_t chunkTiles; /* Width and height, in tiles, of a chunk */
+    uint32_t columns, rows; /* Chunks along each axis. All tile layers share the map's dimensions. */
+    int32_t padLeft, padTop, padRight, padBottom; /* Pixels by which tiles may extend beyond their cells */
+    RaytmxLayerChunks* layers;
+    uint32_t layersLength;
+    uint32_t* frameIndexes; /* Frame index of every GID as of the last UpdateTMXRenderCache() */
+} RaytmxRenderCache; /* Tile layers pre-rendered in chunks by LoadTMXRenderCache() */
+
+typedef struct raytmx_tile_quad {
+    unsigned int textureId;
+    Rectangle dest; /* Area, in pixels, to be drawn to */
+    Vector2 texCoordsMin, texCoordsMax; /* Area within the texture to be drawn from, before flipping */
+    bool flipX, flipY, flipDiag;
+} RaytmxTileQuad;
+
+typedef struct raytmx_tile_batch {
+    RaytmxTileQuad quads[TMX_TILE_BATCH_SIZE];
+    uint32_t quadsLength;
+    Color tint; /* Applied to every quad. Tiles of a layer share the layer's tint. */
+} RaytmxTileBatch; /* Visible tiles of a layer buffered so that each run of one texture is submitted with one bind */
+
 typedef struct raytmx_cached_texture {
-    char* fileName;
+    char* fileName; /* Path the texture was loaded from. Owned by the cache. */
+    uint32_t fileNameHash;
     Texture2D texture;
-    struct raytmx_cached_texture* next;
-} RaytmxCachedTextureNode; /* Associates a file name with a Texture2D allowing for the reuse of textures in VRAM */
+    uint32_t references; /* Loads not yet matched by an unload. The texture leaves VRAM when this reaches zero. */
+} RaytmxCachedTexture; /* Associates a file name with a Texture2D allowing for the reuse of textures in VRAM */
+
+typedef struct raytmx_texture_cache {
+    RaytmxCachedTexture* textures; /* Every cached texture, densely packed */
+    uint32_t texturesLength;
+    uint32_t texturesCapacity;
+    int32_t* byFileName; /* Open-addressed (linear probing) indexes into 'textures' by file name hash. -1 is empty. */
+    int32_t* byTextureId; /* Open-addressed (linear probing) indexes into 'textures' by texture ID. -1 is empty. */
+    uint32_t indexCapacity; /* Length of both index arrays. A power of two, at least twice 'texturesCapacity'. */
+} RaytmxTextureCache; /* Process-wide so that maps and tilesets sharing an image share one copy of it in VRAM */
+
+typedef struct raytmx_pending_texture {
+    char* fileName; /* Path joined with the document's directory, also the image's key in the texture cache */
+    Image image; /* Decoded by the worker thread. Empty if a LoadTextureTMX() callback is set or decoding failed. */
+    Texture2D texture; /* Uploaded and cached by UpdateTMXAsync(). Holds a reference until the map's are set. */
+} RaytmxPendingTexture; /* An image a map being loaded in the background is waiting on */
+
+struct tmx_async_load {
+    char* fileName;
+    TmxAsyncLoadStatus status;
+#ifdef _WIN32
+    void* thread;
+#else
+    pthread_t thread;
+#endif
+    volatile long isParsed; /* Set by the worker thread once it's done with the members below */
+    
+    /* Written by the worker thread only, then read by the loading thread only once 'isParsed' is set */
+    TmxMap* map;
+    RaytmxPendingTexture* textures;
+    uint32_t texturesLength, texturesCapacity;
+    
+    uint32_t texturesUploaded;
+}; /* TmxAsyncLoad. Images referenced by the map hold placeholder textures until they're all uploaded. */
 
 struct raytmx_cached_template; /* Forward declaration */
 typedef struct raytmx_cached_template {
@@ -767,18 +1467,21 @@ typedef struct raytmx_tile_layer_tile_node {
     struct raytmx_tile_layer_tile_node* next;
 } RaytmxTileLayerTileNode;
 
+typedef struct raytmx_tile_chunk_node {
+    TmxTileChunk chunk;
+    struct raytmx_tile_chunk_node* next;
+} RaytmxTileChunkNode;
+
 struct raytmx_object_node; /* Forward declaration */
 typedef struct raytmx_object_node {
     TmxObject object;
     struct raytmx_object_node* next;
 } RaytmxObjectNode;
 
-struct raytmx_object_sorting_node; /* Forward declaration */
-typedef struct raytmx_object_sorting_node {
+typedef struct raytmx_object_sort_key {
     double y;
-    uint32_t index;
-    struct raytmx_object_sorting_node* next;
-} RaytmxObjectSortingNode;
+    uint32_t index; /* Index into the object group's 'objects' array. Breaks ties between equal y-coordinates. */
+} RaytmxObjectSortKey;
 
 struct raytmx_poly_point_node; /* Forward declaration */
 typedef struct raytmx_poly_point_node {
@@ -797,8 +1500,13 @@ typedef struct raytmx_state {
     char documentDirectory[512];
     bool isSuccess;
     
+    /* Allocations that end up in the loaded map are made from 'arena', shared with the states of any TSX and TX */
+    /* documents the map references. The linked list nodes below only live as long as this state and are made from */
+    /* 'scratch' which is released all at once by FreeState(). */
+    RaytmxArena** arena;
+    RaytmxArena* scratch;
+    
     /* Variables intended for TMX (map) parsing */
-    RaytmxCachedTextureNode* texturesRoot;
     RaytmxCachedTemplateNode* templatesRoot;
     TmxOrientation mapOrientation;
     TmxRenderOrder mapRenderOrder;
@@ -818,6 +1526,7 @@ typedef struct raytmx_state {
     /* TmxWangColor* wangColor; */ /* TODO: Wang sets. Low priority. */
     TmxLayer* layer;
     TmxTileLayer* tileLayer;
+    TmxTileChunk* tileChunk;
     TmxObjectGroup* objectGroup;
     TmxImageLayer* imageLayer;
     TmxObject* object;
@@ -830,34 +1539,79 @@ typedef struct raytmx_state {
     RaytmxAnimationFrameNode *animationFramesRoot, *animationFramesTail;
     RaytmxLayerNode *layersRoot, *layersTail, *groupNode;
     RaytmxTileLayerTileNode *layerTilesRoot, *layerTilesTail;
+    RaytmxTileChunkNode *tileChunksRoot, *tileChunksTail;
     RaytmxObjectNode *objectsRoot, *objectsTail;
     uint32_t tilesetsLength, tilesetTilesLength, animationFramesLength, propertiesLength, layersLength,
-    layerTilesLength, objectsLength, propertiesDepth;
+    layerTilesLength, tileChunksLength, objectsLength, propertiesDepth;
 } RaytmxState; /* Intermediate data used internally to parse TMX (map), TSX (tileset), and TX (template) files */
 
-RaytmxExternalTileset LoadTSX(const char* fileName);
-RaytmxObjectTemplate LoadTX(const char* fileName);
+RaytmxExternalTileset LoadTSX(RaytmxArena** arena, const char* fileName);
+RaytmxObjectTemplate LoadTX(RaytmxArena** arena, const char* fileName);
 void ParseDocument(RaytmxState* raytmxState, const char* fileName);
 void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext);
 void FreeState(RaytmxState* raytmxState);
-void FreeString(char* str);
-void FreeTileset(TmxTileset tileset);
-void FreeProperty(TmxProperty property);
-void FreeLayer(TmxLayer layer);
-void FreeObject(TmxObject object);
-bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle viewport, uint32_t* rawGid, TmxTile* tile,
-                      Rectangle* tileRect);
+void UnloadTilesetTextures(TmxTileset tileset);
+void UnloadLayerTextures(TmxLayer layer);
+void UnloadLayerChunks(TmxLayer* layers, uint32_t layersLength);
+void UpdateLayerChunkResidency(const TmxMap* map, TmxLayer* layers, uint32_t layersLength, Vector2 target,
+                               uint32_t radius);
+void LoadTileChunk(const TmxLayer* layer, TmxTileChunk* chunk);
+TmxTileChunk* FindTileChunk(const TmxTileLayer* tileLayer, int32_t chunkX, int32_t chunkY);
+uint32_t HashChunkCoordinates(int32_t chunkX, int32_t chunkY);
 void DrawTMXTileLayer(const TmxMap* map, Rectangle viewport, TmxLayer layer, int posX, int posY, Color tint);
-void DrawTMXLayerTile(const TmxMap* map, Rectangle viewport, uint32_t rawGid, int posX, int posY, Color tint);
+bool DrawTMXLayerChunks(const TmxMap* map, Rectangle viewport, const TmxTileLayer* tileLayer, int posX, int posY,
+                        Color tint);
+void RenderTMXChunk(const TmxMap* map, const RaytmxRenderCache* cache, const RaytmxLayerChunks* layerChunks,
+                    uint32_t chunkX, uint32_t chunkY, RaytmxChunk* chunk);
+uint32_t CollectTileLayers(const TmxLayer* layers, uint32_t layersLength, const TmxLayer** output);
+void BatchTMXLayerTile(RaytmxTileBatch* batch, const TmxMap* map, Rectangle viewport, uint32_t rawGid, int posX,
+                       int posY);
+void DrawTileBatch(RaytmxTileBatch* batch);
+void DrawTextureTile(Texture2D texture, Vector2 texCoordsMin, Vector2 texCoordsMax, Rectangle dest, bool flipX,
+                     bool flipY, bool flipDiag, Color tint);
+void EmitTileQuad(Vector2 texCoordsMin, Vector2 texCoordsMax, Rectangle dest, bool flipX, bool flipY, bool flipDiag);
+bool BuildGidsToTiles(TmxMap* map, uint32_t gidsToTilesLength);
+void OffsetAnimationFrameGids(TmxMap* map, bool toGlobal);
+void StepTileAnimation(TmxTile* tile);
+void CalculateTileTexCoords(TmxMap* map);
+void PackTileDraws(TmxMap* map);
+uint16_t PackTexCoord(float texCoord);
 void DrawTMXObjectTile(const TmxMap* map, Rectangle viewport, uint32_t rawGid, int posX, int posY, float width,
                        float height, Color tint);
 void DrawTMXObjectGroup(const TmxMap* map, Rectangle viewport, TmxLayer layer, int posX, int posY, Color tint);
 void DrawTMXImageLayer(const TmxMap* map, Rectangle viewport, TmxLayer layer, int posX, int posY, Color tint);
 bool CheckCollisionTMXTileLayerObject(const TmxMap* map, const TmxLayer* layers, uint32_t layersLength,
                                       TmxObject object, TmxObject* outputObject);
+bool CheckCollisionTMXTileLayerBits(const TmxMap* map, const TmxTileLayer* layer, TmxObject object,
+                                    TmxObject* outputObject);
+bool CheckCollisionTMXTileObjects(const TmxTile* tile, Rectangle tileRect, TmxObject object, TmxObject* outputObject);
+bool AnyTileBits(const uint64_t* row, int fromX, int toX);
+void BakeTileCollisionBits(TmxMap* map);
+void BakeLayerCollisionBits(TmxMap* map, TmxLayer* layers, uint32_t layersLength, const uint8_t* gidShapes);
 bool CheckCollisionTMXObjectGroupObject(TmxObjectGroup group, TmxObject object, TmxObject* outputObject);
+TmxObjectGrid* BuildObjectGroupGrid(RaytmxArena** arena, const TmxObjectGroup* group, float cellWidth,
+                                    float cellHeight);
+TmxObjectBounds* BuildObjectGroupBounds(RaytmxArena** arena, const TmxObjectGroup* group);
+void CopyObjectGroupBounds(TmxObjectBounds* bounds, const TmxObjectGroup* group);
+uint32_t FindTMXObjectGroupCollision(const TmxObjectGroup* group, TmxObject* object);
+uint32_t NextOverlappingBounds(const TmxObjectBounds* bounds, uint32_t start, float minX, float minY, float maxX,
+                               float maxY);
+uint32_t LowestSetBit(uint32_t mask);
+bool IsBoxObjectType(TmxObjectType type);
+TmxObjectBvh* BuildObjectGroupBvh(RaytmxArena** arena, const TmxObjectGroup* group);
+uint32_t BuildBvhNode(TmxObjectBvh* bvh, const TmxObject* objects, uint32_t start, uint32_t count, uint32_t depth);
+void FitBvhNode(TmxObjectBvh* bvh, uint32_t nodeIndex, const TmxObject* objects);
+void RefitObjectGroupBvh(TmxObjectBvh* bvh, const TmxObject* objects);
+uint32_t FindTMXObjectGroupBvhCollision(const TmxObjectGroup* group, const TmxObject* object);
+bool IntersectSegmentBox(Vector2 from, Vector2 delta, float minX, float minY, float maxX, float maxY,
+                         float* entryTime, Vector2* normal);
+bool IntersectSegmentTMXObject(const TmxObject* object, Vector2 from, Vector2 to, float* hitTime, Vector2* hitNormal);
+int CompareObjectIndexes(const void* a, const void* b);
+int CompareObjectSortKeys(const void* a, const void* b);
+int Clampi(int value, int minimum, int maximum);
+int FloorDivi(int dividend, int divisor);
 void TraceLogTMXTilesets(int logLevel, TmxOrientation orientation, TmxTileset* tilesets, uint32_t tilesetsLength,
                          int numSpaces);
 void TraceLogTMXProperties(int logLevel, TmxProperty* properties, uint32_t propertiesLength, int numSpaces);
@@ -866,18 +1620,60 @@ void TraceLogTMXObject(int logLevel, TmxObject object, int numSpaces);
 void StringCopy(char* destination, const char* source);
 TmxProperty* AddProperty(RaytmxState* raytmxState);
 void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid);
+uint32_t AddTileLayerGids(RaytmxState* raytmxState, const unsigned char* data, int dataLength);
+TmxTileChunk* AddTileChunk(RaytmxState* raytmxState);
+void BuildTileChunks(RaytmxState* raytmxState);
+unsigned char* DecodeTileData(const char* layerName, const char* content, const char* compression, int* dataLength);
+uint32_t DecodeTileDataCsv(const char* content, uint32_t* gids, uint32_t gidsCapacity);
 TmxTileset* AddTileset(RaytmxState* raytmxState);
 TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState);
 TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState);
 TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup);
 TmxObject* AddObject(RaytmxState* raytmxState);
 void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* layersRoot, uint32_t layersLength);
-RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char* fileName);
+Texture2D LoadCachedTexture(RaytmxState* raytmxState, const char* fileName);
+int32_t FindCachedTexture(const char* fileName, uint32_t fileNameHash);
+int32_t FindCachedTextureById(unsigned int id);
+bool GrowTextureCache(void);
+void IndexTextureCache(void);
+bool AddCachedTexture(const char* fileName, uint32_t fileNameHash, Texture2D texture);
+uint32_t HashFileName(const char* fileName);
+#ifdef _WIN32
+unsigned long __stdcall RunAsyncLoad(void* load);
+#else
+void* RunAsyncLoad(void* load);
+#endif
+void JoinAsyncLoad(TmxAsyncLoad* load);
+Texture2D QueueAsyncTexture(TmxAsyncLoad* load, const char* fileName);
+void UploadAsyncTexture(TmxAsyncLoad* load);
+Texture2D ResolveAsyncTexture(const TmxAsyncLoad* load, Texture2D texture, bool isReference);
+void ResolveAsyncLayerTextures(const TmxAsyncLoad* load, TmxLayer* layers, uint32_t layersLength);
+void ResolveAsyncTextures(TmxAsyncLoad* load);
+void FreeAsyncLoad(TmxAsyncLoad* load);
 RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const char* fileName);
 Color GetColorFromHexString(const char* hex);
 uint32_t GetGid(uint32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVertically, bool* isFlippedDiagonally,
                 bool* isRotatedHexagonal120);
 void* MemAllocZero(unsigned int size);
+void* ArenaAlloc(RaytmxArena** arena, size_t size);
+void FreeArena(RaytmxArena* arena);
+unsigned char* GetArenaRegionData(RaytmxArena* region);
+void* MapFile(const char* fileName, size_t* size);
+void UnmapFile(void* mapping, size_t size);
+uint32_t GetBinaryLayoutHash(void);
+bool GetBinaryOffset(const RaytmxBinaryWriter* writer, const void* pointer, uint64_t* offset);
+void WriteBinaryPointer(RaytmxBinaryWriter* writer, const void* field);
+void WriteBinaryZeroes(RaytmxBinaryWriter* writer, const void* field, size_t size);
+void WriteBinaryProperties(RaytmxBinaryWriter* writer, const TmxProperty* properties, uint32_t propertiesLength);
+void WriteBinaryImage(RaytmxBinaryWriter* writer, const TmxImage* image);
+void WriteBinaryObjectGroup(RaytmxBinaryWriter* writer, const TmxObjectGroup* objectGroup);
+void WriteBinaryTilesets(RaytmxBinaryWriter* writer, const TmxTileset* tilesets, uint32_t tilesetsLength);
+void WriteBinaryLayers(RaytmxBinaryWriter* writer, const TmxLayer* layers, uint32_t layersLength);
+int CompareBinaryOffsets(const void* a, const void* b);
+Texture2D LoadBinaryTexture(RaytmxState* raytmxState, const char* directory, const char* source);
+void LoadBinaryLayerResources(RaytmxState* raytmxState, TmxLayer* layers, uint32_t layersLength,
+                              const char* directory);
+void SetObjectGroupFonts(TmxObjectGroup* objectGroup);
 char* GetDirectoryPath2(const char* filePath);
 char* JoinPath(const char* prefix, const char* suffix);
 void StringCopyN(char* destination, const char* source, size_t number);
@@ -891,19 +1687,31 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TMX;
     
-    /* Initialize the map object */
-    TmxMap* map = (TmxMap*)MemAllocZero(sizeof(TmxMap));
+    /* Initialize the map object. The map is the first allocation from its own arena so that everything parsed from */
+    /* the document, including the map, can be released with a single call. */
+    RaytmxArena* arena = NULL;
+    TmxMap* map = (TmxMap*)ArenaAlloc(&arena, sizeof(TmxMap));
+    if (map == NULL)
+        return NULL;
+    map->arena = arena;
+    raytmxState->arena = &map->arena;
     
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
     ParseDocument(raytmxState, fileName);
     if (!raytmxState->isSuccess) {
+        FreeState(raytmxState);
         UnloadTMX(map);
         return NULL;
     }
     
     /* Copy some top-level map properties */
-    map->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
+    map->fileName = (char*)ArenaAlloc(&map->arena, strlen(fileName) + 1);
+    if (map->fileName == NULL) {
+        FreeState(raytmxState);
+        UnloadTMX(map);
+        return NULL;
+    }
     StringCopy(map->fileName, GetFileName(fileName));
     map->orientation = raytmxState->mapOrientation;
     map->renderOrder = raytmxState->mapRenderOrder;
@@ -919,7 +1727,7 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
     uint32_t gidsToTilesLength = 0; /* Can also be seen as the last GID */
     if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
         /* Allocate the array of tilesets and zeroize every index */
-        TmxTileset* tilesets = (TmxTileset*)MemAllocZero(sizeof(TmxTileset) * raytmxState->tilesetsLength);
+        TmxTileset* tilesets = (TmxTileset*)ArenaAlloc(&map->arena, sizeof(TmxTileset) * raytmxState->tilesetsLength);
         /* Copy the TmxTileset pointers into the array */
         RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot;
         for (uint32_t i = 0; tilesetIterator != NULL; i++) {
@@ -962,90 +1770,14 @@ RAYTMX_DEC TmxMap* LoadTMX(const char* fileName) {
     } else
         TraceLog(LOG_WARNING, "RAYTMX: The map does not contain any layers");
     
-    if (gidsToTilesLength > 0) {
-        TmxTile* gidsToTiles = (TmxTile*)MemAllocZero(sizeof(TmxTile) * gidsToTilesLength);
-        
-        for (uint32_t i = 0; i < map->tilesetsLength; i++) {
-            TmxTileset* tileset = &map->tilesets[i];
-            if (tileset->hasImage) { /* If the tileset has a shared image (i.e. not a "collection of images") */
-                /* First, iterate through the explicit tiles. These are explicitly defined with <tile> elements and */
-                /* are used to, among other things, provide animations and specific source rectangles. Note: Their */
-                /* IDs may exceed the tileset's tile count. */
-                for (uint32_t j = 0; j < tileset->tilesLength; j++) {
-                    TmxTilesetTile tilesetTile = tileset->tiles[j];
-                    uint32_t gid = tileset->firstGid + tilesetTile.id;
-                    if (tilesetTile.hasAnimation) { /* If the tile is meta, pointing to a series of other tiles */
-                        gidsToTiles[gid].hasAnimation = true;
-                        gidsToTiles[gid].animation = tilesetTile.animation;
-                        /* Frames' tile (G)IDs are initially set with local values. Now that all tilesets are known */
-                        /* and this tileset's first global ID is available, update the ID to be global. */
-                        for (uint32_t k = 0; k < gidsToTiles[gid].animation.framesLength; k++)
-                            gidsToTiles[gid].animation.frames[k].gid += tileset->firstGid;
-                    }
-                    if (tilesetTile.x != 0 || tilesetTile.y != 0 || tilesetTile.width != 0 || tilesetTile.height != 0) {
-                        /* This tile directly tells us the area within the tileset's image to use when drawing, */
-                        /* overriding the implicit dimensions derived from the map's tile width and height. */
-                        gidsToTiles[gid].sourceRect.x = (float)tilesetTile.x;
-                        gidsToTiles[gid].sourceRect.y = (float)tilesetTile.y;
-                        gidsToTiles[gid].sourceRect.width = (float)tilesetTile.width;
-                        gidsToTiles[gid].sourceRect.height = (float)tilesetTile.height;
-                    }
-                    /* Tiles may have child object groups. These objects are a form of collision information. The */
-                    /* object group may be empty or may have objects. A simple assignment covers both. */
-                    gidsToTiles[gid].objectGroup = tilesetTile.objectGroup;
-                    gidsToTiles[gid].gid = gid; /* Tell the tile its GID */
-                } /* for (uint32_t j = 0; j < tileset->tilesLength; j++) */
-                /* Second, loop through the implicit tiles. These are inferred from knowing the dimensions of the */
-                /* tileset's image, dimensiosn of tiles, and the (right-down) order of tiles within the image. */
-                for (uint32_t id = 0; id < tileset->tileCount; id++) {
-                    uint32_t gid = id + tileset->firstGid, x = id % tileset->columns, y = id / tileset->columns;
-                    gidsToTiles[gid].gid = gid; /* Tell the tile its GID */
-                    /* If that source renctangle within the image was NOT explicitly defined. */
-                    /* Note: Float comparisons like this are typically unreliable but the GIDs-to-tiles array is */
-                    /* initialized with zeroes making this accurate. */
-                    if (gidsToTiles[gid].sourceRect.x == 0.0f && gidsToTiles[gid].sourceRect.y == 0.0f &&
-                        gidsToTiles[gid].sourceRect.width == 0.0f && gidsToTiles[gid].sourceRect.height == 0.0f) {
-                        /* Calculate the area within the texture to be drawn from contextual information */
-                        gidsToTiles[gid].sourceRect.x = (float)(tileset->margin + (x * tileset->tileWidth) +
-                                                                (x * tileset->spacing));
-                        gidsToTiles[gid].sourceRect.y = (float)(tileset->margin + (y * tileset->tileHeight) +
-                                                                (y * tileset->spacing));
-                        gidsToTiles[gid].sourceRect.width = (float)tileset->tileWidth;
-                        gidsToTiles[gid].sourceRect.height = (float)tileset->tileHeight;
-                    }
-                    gidsToTiles[gid].texture = tileset->image.texture;
-                    gidsToTiles[gid].offset.x = (float)tileset->tileOffsetX;
-                    gidsToTiles[gid].offset.y = (float)tileset->tileOffsetY;
-                } /* for (uint32_t id = 0; id < tileset->tileCount; id++) */
-            } else { /* If the tileset is a collection of images where each tile has its own image */
-                for (uint32_t j = 0; j < tileset->tilesLength; j++) {
-                    TmxTilesetTile tilesetTile = tileset->tiles[j];
-                    if (!tilesetTile.hasImage) {
-                        TraceLog(LOG_WARNING, "RAYTMX: Skipping tile %d of image collection tileset \"%s\" because "
-                                 "it has no image", tilesetTile.id, tileset->name);
-                        continue;
-                    }
-                    
-                    int32_t gid = tileset->firstGid + tilesetTile.id;
-                    gidsToTiles[gid].gid = gid;
-                    gidsToTiles[gid].sourceRect.x = (float)tilesetTile.x; /* Defaults to and probably is zero */
-                    gidsToTiles[gid].sourceRect.y = (float)tilesetTile.y; /* Defaults to and probably is zero */
-                    if (tilesetTile.width != tilesetTile.image.width)
-                        gidsToTiles[gid].sourceRect.width = (float)tilesetTile.width;
-                    else
-                        gidsToTiles[gid].sourceRect.width = (float)tilesetTile.image.width;
-                    if (tilesetTile.height != tilesetTile.image.height)
-                        gidsToTiles[gid].sourceRect.height = (float)tilesetTile.height;
-                    else
-                        gidsToTiles[gid].sourceRect.height = (float)tilesetTile.image.height;
-                    gidsToTiles[gid].texture = tilesetTile.image.texture;
-                }
-            }
-        }
-        
-        map->gidsToTiles = gidsToTiles;
-        map->gidsToTilesLength = gidsToTilesLength;
-    } /* gidsToTilesLength > 0 */
+    /* Pre-calculate what's needed to draw each GID now that every tileset's first GID is known */
+    if (gidsToTilesLength > 0 && !BuildGidsToTiles(map, gidsToTilesLength)) {
+        FreeState(raytmxState);
+        UnloadTMX(map);
+        return NULL;
+    }
+    /* Bake which tiles are solid, for collision checks, now that every GID's collision shapes are known */
+    BakeTileCollisionBits(map);
     
     /* Free the linked lists and zeroize related values */
     FreeState(raytmxState);
@@ -1057,69 +1789,364 @@ RAYTMX_DEC void UnloadTMX(TmxMap* map) {
     if (map == NULL)
         return;
     
-    if (map->fileName != NULL)
-        MemFree(map->fileName);
+    UnloadTMXRenderCache(map);
+    UnloadLayerChunks(map->layers, map->layersLength); /* Resident chunks' tiles aren't allocated from the arena */
     
-    if (map->properties != NULL) {
-        for (uint32_t i = 0; i < map->propertiesLength; i++)
-            FreeProperty(map->properties[i]);
-        MemFree(map->properties);
-    }
+    /* Textures live in VRAM and must be unloaded individually */
+    for (uint32_t i = 0; i < map->tilesetsLength; i++)
+        UnloadTilesetTextures(map->tilesets[i]);
+    for (uint32_t i = 0; i < map->layersLength; i++)
+        UnloadLayerTextures(map->layers[i]);
     
-    if (map->tilesets != NULL) {
-        for (uint32_t i = 0; i < map->tilesetsLength; i++)
-            FreeTileset(map->tilesets[i]);
-        MemFree(map->tilesets);
-    }
+    /* Everything else, including the map itself, was allocated from the map's arena */
+    FreeArena(map->arena);
+}
+
+RAYTMX_DEC bool ExportTMXBinary(const TmxMap* map, const char* fileName) {
+    if (map == NULL || fileName == NULL)
+        return false;
     
-    if (map->layers != NULL) {
-        for (uint32_t i = 0; i < map->layersLength; i++)
-            FreeLayer(map->layers[i]);
-        MemFree(map->layers);
+    RaytmxBinaryWriter writer[1];
+    memset(writer, 0, sizeof(RaytmxBinaryWriter));
+    writer->isSuccess = true;
+    
+    /* Every model of the map was allocated from its arena so the arena's regions, placed back to back, are a copy of */
+    /* the whole map. Only the pointers within that copy need to be rewritten as offsets. */
+    for (RaytmxArena* region = map->arena; region != NULL; region = region->previous)
+        writer->regionsLength++;
+    writer->regions = (RaytmxArena**)MemAllocZero(sizeof(RaytmxArena*) * writer->regionsLength);
+    writer->regionOffsets = (uint64_t*)MemAllocZero(sizeof(uint64_t) * writer->regionsLength);
+    if (writer->regions == NULL || writer->regionOffsets == NULL) {
+        TraceLog(LOG_ERROR, "RAYTMX: Ran out of memory exporting \"%s\"", fileName);
+        MemFree(writer->regionOffsets);
+        MemFree(writer->regions);
+        return false;
+    }
+    uint32_t regionIndex = writer->regionsLength;
+    for (RaytmxArena* region = map->arena; region != NULL; region = region->previous)
+        writer->regions[--regionIndex] = region; /* Newest regions are first in the chain so fill from the back */
+    uint64_t dataSize = 0;
+    for (uint32_t i = 0; i < writer->regionsLength; i++) {
+        writer->regionOffsets[i] = dataSize;
+        /* Each region starts at an aligned offset so that the alignment of every allocation is preserved */
+        dataSize += (writer->regions[i]->used + TMX_ARENA_ALIGNMENT - 1) & ~(uint64_t)(TMX_ARENA_ALIGNMENT - 1);
     }
     
-    if (map->gidsToTiles != NULL)
-        MemFree(map->gidsToTiles);
-    
-    MemFree(map);
-}
-
-RAYTMX_DEC void DrawTMX(const TmxMap* map, const Camera2D* camera, const Rectangle* viewport, int posX, int posY,
-                        Color tint) {
-    if (map == NULL)
-        return;
+    RaytmxBinaryHeader header;
+    memset(&header, 0, sizeof(RaytmxBinaryHeader));
+    header.magic = TMX_BINARY_MAGIC;
+    header.version = TMX_BINARY_VERSION;
+    header.layoutHash = GetBinaryLayoutHash();
+    header.dataOffset = (sizeof(RaytmxBinaryHeader) + TMX_ARENA_ALIGNMENT - 1) & ~(uint64_t)(TMX_ARENA_ALIGNMENT - 1);
+    header.dataSize = dataSize;
+    header.relocationsOffset = header.dataOffset + dataSize;
+    
+    /* The file is assembled in a single buffer with the data written in place */
+    size_t fileSize = (size_t)header.relocationsOffset;
+    unsigned char* file = (unsigned char*)MemAllocZero((unsigned int)fileSize);
+    if (file == NULL) {
+        TraceLog(LOG_ERROR, "RAYTMX: Ran out of memory exporting \"%s\"", fileName);
+        MemFree(writer->regionOffsets);
+        MemFree(writer->regions);
+        return false;
+    }
+    writer->data = file + header.dataOffset;
+    for (uint32_t i = 0; i < writer->regionsLength; i++) {
+        memcpy(writer->data + writer->regionOffsets[i], GetArenaRegionData(writer->regions[i]),
+               writer->regions[i]->used);
+    }
     
-    if (map->hasBackgroundColor) {
-        Rectangle backgroundRect;
-        if (viewport != NULL)
-            backgroundRect = *viewport;
-        else {
-            backgroundRect.x = (float)posX;
-            backgroundRect.y = (float)posY;
-            backgroundRect.width = (float)(map->width * map->tileWidth);
-            backgroundRect.height = (float)(map->height * map->tileHeight);
+    if (!GetBinaryOffset(writer, map, &header.mapOffset))
+        writer->isSuccess = false;
+    WriteBinaryPointer(writer, &map->fileName);
+    WriteBinaryProperties(writer, map->properties, map->propertiesLength);
+    WriteBinaryPointer(writer, &map->properties);
+    WriteBinaryTilesets(writer, map->tilesets, map->tilesetsLength);
+    WriteBinaryPointer(writer, &map->tilesets);
+    WriteBinaryLayers(writer, map->layers, map->layersLength);
+    WriteBinaryPointer(writer, &map->layers);
+    for (uint32_t i = 0; i < map->gidsToTilesLength; i++) {
+        TmxTile* tile = &map->gidsToTiles[i];
+        WriteBinaryZeroes(writer, &tile->texture, sizeof(Texture2D)); /* Textures are reloaded by LoadTMXBinary() */
+        WriteBinaryPointer(writer, &tile->animation.frames);
+        WriteBinaryObjectGroup(writer, &tile->objectGroup);
+    }
+    WriteBinaryPointer(writer, &map->gidsToTiles);
+    WriteBinaryPointer(writer, &map->tileDraws);
+    if (map->tileTextures != NULL) /* Textures are reloaded by LoadTMXBinary() */
+        WriteBinaryZeroes(writer, map->tileTextures, sizeof(Texture2D) * map->tileTexturesLength);
+    WriteBinaryPointer(writer, &map->tileTextures);
+    WriteBinaryPointer(writer, &map->animatedGids);
+    WriteBinaryPointer(writer, &map->changedGids);
+    WriteBinaryZeroes(writer, &map->arena, sizeof(map->arena)); /* Replaced by LoadTMXBinary() */
+    WriteBinaryZeroes(writer, &map->renderCache, sizeof(map->renderCache)); /* Render textures can't be baked */
+    
+    bool isSuccess = writer->isSuccess;
+    if (isSuccess) {
+        /* Models shared between arrays, like tiles' object groups, are visited more than once. Sorting the */
+        /* relocations lets the duplicates be dropped and lets the loader walk through the data front to back. */
+        qsort(writer->relocations, writer->relocationsLength, sizeof(uint64_t), CompareBinaryOffsets);
+        uint32_t uniqueLength = 0;
+        for (uint32_t i = 0; i < writer->relocationsLength; i++) {
+            if (uniqueLength == 0 || writer->relocations[uniqueLength - 1] != writer->relocations[i])
+                writer->relocations[uniqueLength++] = writer->relocations[i];
         }
+        header.relocationsLength = uniqueLength;
         
-        DrawRectangleRec(/* rec: */ backgroundRect, /* color: */ map->backgroundColor);
+        size_t relocationsSize = sizeof(uint64_t) * uniqueLength;
+        unsigned char* grownFile = (unsigned char*)MemRealloc(file, (unsigned int)(fileSize + relocationsSize));
+        if (grownFile != NULL) {
+            file = grownFile;
+            memcpy(file, &header, sizeof(RaytmxBinaryHeader));
+            memcpy(file + fileSize, writer->relocations, relocationsSize);
+            fileSize += relocationsSize;
+            
+            isSuccess = SaveFileData(fileName, file, (int)fileSize);
+            if (!isSuccess)
+                TraceLog(LOG_ERROR, "RAYTMX: Failed to write \"%s\"", fileName);
+        } else { /* The original buffer is still valid, and freed below */
+            TraceLog(LOG_ERROR, "RAYTMX: Ran out of memory exporting \"%s\"", fileName);
+            isSuccess = false;
+        }
+    } else if (writer->isOutOfMemory) {
+        TraceLog(LOG_ERROR, "RAYTMX: Ran out of memory exporting \"%s\"", fileName);
+    } else {
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to export \"%s\" because the map references memory outside of its arena",
+                 fileName);
     }
     
-    DrawTMXLayers(map, camera, viewport, map->layers, map->layersLength, posX, posY, tint);
+    MemFree(file);
+    MemFree(writer->relocations);
+    MemFree(writer->regionOffsets);
+    MemFree(writer->regions);
+    return isSuccess;
 }
 
-RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const Rectangle* viewport,
-                              const TmxLayer* layers, uint32_t layersLength, int posX, int posY, Color tint) {
-    if (map == NULL || layers == NULL || layersLength == 0)
-        return;
+RAYTMX_DEC TmxMap* LoadTMXBinary(const char* fileName) {
+    size_t fileSize = 0;
+    unsigned char* file = (unsigned char*)MapFile(fileName, &fileSize);
+    if (file == NULL) {
+        TraceLog(LOG_ERROR, "RAYTMX: Failed to open \"%s\"", fileName);
+        return NULL;
+    }
     
-    for (uint32_t i = 0; i < layersLength; i++) {
-        TmxLayer layer = layers[i];
-        if (!layers[i].visible) /* If the layer is not visible */
-            continue; /* Skip it - it's literally invisible */
-        
-        /* All types of layers can have a couple attributes that affect color: 'opacity' and 'tintcolor' */
-        Color layerTint = tint;
-        layerTint.a = (unsigned char)((double)layerTint.a * layer.opacity);
-        if (layer.hasTintColor)
+    RaytmxBinaryHeader header;
+    memset(&header, 0, sizeof(RaytmxBinaryHeader));
+    if (fileSize >= sizeof(RaytmxBinaryHeader))
+        memcpy(&header, file, sizeof(RaytmxBinaryHeader));
+    if (header.magic != TMX_BINARY_MAGIC) {
+        TraceLog(LOG_ERROR, "RAYTMX: \"%s\" is not a baked map", fileName);
+        UnmapFile(file, fileSize);
+        return NULL;
+    }
+    if (header.version != TMX_BINARY_VERSION || header.layoutHash != GetBinaryLayoutHash()) {
+        TraceLog(LOG_WARNING, "RAYTMX: \"%s\" was exported by an incompatible build and must be exported again",
+                 fileName);
+        UnmapFile(file, fileSize);
+        return NULL;
+    }
+    /* Make sure every section lies within the file before anything is read from it */
+    if (header.dataOffset % TMX_ARENA_ALIGNMENT != 0 || header.dataOffset > fileSize ||
+        header.dataSize > fileSize - header.dataOffset || header.relocationsOffset % sizeof(uint64_t) != 0 ||
+        header.relocationsOffset > fileSize ||
+        header.relocationsLength > (fileSize - header.relocationsOffset) / sizeof(uint64_t) ||
+        header.dataSize < sizeof(TmxMap) || header.mapOffset > header.dataSize - sizeof(TmxMap)) {
+        TraceLog(LOG_ERROR, "RAYTMX: \"%s\" is truncated or corrupt", fileName);
+        UnmapFile(file, fileSize);
+        return NULL;
+    }
+    
+    /* Turn the offsets back into pointers. The mapping is copy-on-write so this doesn't modify the file. Both where */
+    /* each pointer is stored and where it points must lie within the data, or a corrupt file could send the map's */
+    /* pointers anywhere. A pointer may point at the very end, as zero-length allocations there do. */
+    unsigned char* data = file + header.dataOffset;
+    const uint64_t* relocations = (const uint64_t*)(file + header.relocationsOffset);
+    for (uint32_t i = 0; i < header.relocationsLength; i++) {
+        uintptr_t value;
+        if (header.dataSize < sizeof(uintptr_t) || relocations[i] > header.dataSize - sizeof(uintptr_t)) {
+            TraceLog(LOG_ERROR, "RAYTMX: \"%s\" is truncated or corrupt", fileName);
+            UnmapFile(file, fileSize);
+            return NULL;
+        }
+        memcpy(&value, data + relocations[i], sizeof(uintptr_t)); /* memcpy() in case a field isn't aligned */
+        if (value > header.dataSize) {
+            TraceLog(LOG_ERROR, "RAYTMX: \"%s\" is truncated or corrupt", fileName);
+            UnmapFile(file, fileSize);
+            return NULL;
+        }
+        value += (uintptr_t)data;
+        memcpy(data + relocations[i], &value, sizeof(uintptr_t));
+    }
+    
+    /* The mapping becomes the map's arena, released by UnloadTMX() like any other */
+    TmxMap* map = (TmxMap*)(data + header.mapOffset);
+    map->arena = (RaytmxArena*)MemAllocZero((unsigned int)TMX_ARENA_HEADER_SIZE);
+    if (map->arena == NULL) {
+        UnmapFile(file, fileSize);
+        return NULL;
+    }
+    map->arena->capacity = fileSize;
+    map->arena->used = fileSize;
+    map->arena->mapping = file;
+    
+    /* Textures and fonts can't be baked. Load textures like LoadTMX() would, relative to the baked file. */
+    RaytmxState raytmxState[1];
+    memset(raytmxState, 0, sizeof(RaytmxState));
+    char directory[512];
+    StringCopy(directory, GetDirectoryPath2(fileName));
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        TmxTileset* tileset = &map->tilesets[i];
+        /* Images of external tilesets are relative to the TSX document rather than the map */
+        char tilesetDirectory[512];
+        StringCopy(tilesetDirectory, directory);
+        if (tileset->source != NULL && strlen(directory) + strlen(tileset->source) + 2 > 260) {
+            /* JoinPath() can't join them, so the tileset's images are looked for next to the map and likely missed */
+            TraceLog(LOG_ERROR, "RAYTMX: Path of tileset \"%s\" is too long", tileset->source);
+        } else if (tileset->source != NULL) {
+            StringCopy(tilesetDirectory, JoinPath(directory, tileset->source));
+            char* iterator = tilesetDirectory + strlen(tilesetDirectory);
+            while (iterator != tilesetDirectory && *(iterator - 1) != '\\' && *(iterator - 1) != '/')
+                iterator -= 1;
+            *iterator = '\0'; /* Remove the TSX file's name, keeping the trailing slash */
+        }
+        
+        if (tileset->hasImage) {
+            tileset->image.texture = LoadBinaryTexture(raytmxState, tilesetDirectory, tileset->image.source);
+            for (uint32_t id = 0; id < tileset->tileCount; id++) {
+                if (tileset->firstGid + id < map->gidsToTilesLength)
+                    map->gidsToTiles[tileset->firstGid + id].texture = tileset->image.texture;
+            }
+        }
+        for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+            TmxTilesetTile* tilesetTile = &tileset->tiles[j];
+            if (tilesetTile->hasImage) { /* If the tileset is a "collection of images" */
+                tilesetTile->image.texture = LoadBinaryTexture(raytmxState, tilesetDirectory,
+                                                               tilesetTile->image.source);
+                if (!tileset->hasImage && tileset->firstGid + tilesetTile->id < map->gidsToTilesLength)
+                    map->gidsToTiles[tileset->firstGid + tilesetTile->id].texture = tilesetTile->image.texture;
+            }
+            SetObjectGroupFonts(&tilesetTile->objectGroup);
+        }
+    }
+    LoadBinaryLayerResources(raytmxState, map->layers, map->layersLength, directory);
+    FreeState(raytmxState);
+    CalculateTileTexCoords(map); /* In case the images have changed dimensions since the map was baked */
+    PackTileDraws(map);
+    
+    return map;
+}
+
+RAYTMX_DEC TmxAsyncLoad* LoadTMXAsync(const char* fileName) {
+    if (fileName == NULL)
+        return NULL;
+    
+    TmxAsyncLoad* load = (TmxAsyncLoad*)MemAllocZero(sizeof(TmxAsyncLoad));
+    if (load == NULL)
+        return NULL;
+    load->fileName = (char*)MemAlloc((unsigned int)(strlen(fileName) + 1));
+    if (load->fileName == NULL) {
+        MemFree(load);
+        return NULL;
+    }
+    StringCopy(load->fileName, fileName);
+    load->status = ASYNC_LOAD_PARSING;
+    
+#ifdef _WIN32
+    load->thread = CreateThread(NULL, 0, RunAsyncLoad, load, 0, NULL);
+    bool isStarted = load->thread != NULL;
+#else
+    bool isStarted = pthread_create(&load->thread, NULL, RunAsyncLoad, load) == 0;
+#endif
+    if (!isStarted) {
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to start a thread to load \"%s\"", fileName);
+        FreeAsyncLoad(load);
+        return NULL;
+    }
+    
+    return load;
+}
+
+RAYTMX_DEC TmxAsyncLoadStatus UpdateTMXAsync(TmxAsyncLoad* load, double timeBudget) {
+    if (load == NULL)
+        return ASYNC_LOAD_FAILED;
+    
+    if (load->status == ASYNC_LOAD_PARSING) {
+        if (RAYTMX_ATOMIC_LOAD(load->isParsed) == 0)
+            return ASYNC_LOAD_PARSING;
+        JoinAsyncLoad(load); /* Returns immediately since the thread is finishing or finished */
+    }
+    
+    if (load->status == ASYNC_LOAD_UPLOADING) {
+        double startTime = GetTime();
+        do {
+            if (load->texturesUploaded == load->texturesLength)
+                break;
+            UploadAsyncTexture(load);
+        } while (GetTime() - startTime < timeBudget);
+        
+        if (load->texturesUploaded == load->texturesLength) {
+            ResolveAsyncTextures(load);
+            load->status = ASYNC_LOAD_DONE;
+        }
+    }
+    
+    return load->status;
+}
+
+RAYTMX_DEC TmxMap* FinishTMXAsync(TmxAsyncLoad* load) {
+    if (load == NULL)
+        return NULL;
+    
+    if (load->status == ASYNC_LOAD_PARSING)
+        JoinAsyncLoad(load); /* Blocks until the worker thread is done */
+    if (load->status == ASYNC_LOAD_UPLOADING) {
+        while (load->texturesUploaded < load->texturesLength)
+            UploadAsyncTexture(load);
+        ResolveAsyncTextures(load);
+        load->status = ASYNC_LOAD_DONE;
+    }
+    
+    TmxMap* map = load->status == ASYNC_LOAD_DONE ? load->map : NULL;
+    FreeAsyncLoad(load);
+    return map;
+}
+
+RAYTMX_DEC void DrawTMX(const TmxMap* map, const Camera2D* camera, const Rectangle* viewport, int posX, int posY,
+                        Color tint) {
+    if (map == NULL)
+        return;
+    
+    if (map->hasBackgroundColor) {
+        Rectangle backgroundRect;
+        if (viewport != NULL)
+            backgroundRect = *viewport;
+        else {
+            backgroundRect.x = (float)posX;
+            backgroundRect.y = (float)posY;
+            backgroundRect.width = (float)(map->width * map->tileWidth);
+            backgroundRect.height = (float)(map->height * map->tileHeight);
+        }
+        
+        DrawRectangleRec(/* rec: */ backgroundRect, /* color: */ map->backgroundColor);
+    }
+    
+    DrawTMXLayers(map, camera, viewport, map->layers, map->layersLength, posX, posY, tint);
+}
+
+RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const Rectangle* viewport,
+                              const TmxLayer* layers, uint32_t layersLength, int posX, int posY, Color tint) {
+    if (map == NULL || layers == NULL || layersLength == 0)
+        return;
+    
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer layer = layers[i];
+        if (!layers[i].visible) /* If the layer is not visible */
+            continue; /* Skip it - it's literally invisible */
+        
+        /* All types of layers can have a couple attributes that affect color: 'opacity' and 'tintcolor' */
+        Color layerTint = tint;
+        layerTint.a = (unsigned char)((double)layerTint.a * layer.opacity);
+        if (layer.hasTintColor)
             layerTint = ColorTint(layerTint, layer.tintColor);
         
         /* Determine the viewport. This will depend on a couple parameters. If 'viewport' was assigned, it's used */
@@ -1168,27 +2195,217 @@ RAYTMX_DEC void DrawTMXLayers(const TmxMap* map, const Camera2D* camera, const R
 }
 
 RAYTMX_DEC void AnimateTMX(TmxMap* map) {
+    AnimateTMXEx(map, GetFrameTime()); /* Returns the duration, in seconds, of the last frame drawn */
+}
+
+RAYTMX_DEC uint32_t AnimateTMXEx(TmxMap* map, float dt) {
     if (map == NULL)
-        return;
+        return 0;
     
-    float dt = GetFrameTime(); /* Returns the duration, in seconds, of the last frame drawn */
-    /* Iterate through the tiles, searching for those that are animations */
-    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+    map->changedGidsLength = 0;
+    /* Only the tiles that are animations, indexed when the map was loaded, are visited */
+    for (uint32_t i = 0; i < map->animatedGidsLength; i++) {
+        uint32_t gid = map->animatedGids[i];
         TmxTile* tile = &map->gidsToTiles[gid]; /* A pointer is used in case the frame time needs to be reassigned */
-        /* If the GID maps to a valid tile, that tile is an animation, and the bounds check passes */
-        if (tile->gid > 0 && tile->hasAnimation && tile->frameIndex < tile->animation.framesLength) {
-            tile->frameTime += dt;
-            /* If the current frame has been displayed for its whole duration, or longer */
-            if (tile->frameTime > tile->animation.frames[tile->frameIndex].duration) {
-                tile->frameTime -= tile->animation.frames[tile->frameIndex].duration;
-                /* Increment the frame index to display the next one... */
-                tile->frameIndex += 1;
-                /* ...unless the last frame was "last" in both senses */
-                if (tile->frameIndex == tile->animation.framesLength)
-                    tile->frameIndex = 0; /* Wrap around to the first frame */
+        if (tile->frameIndex >= tile->animation.framesLength) /* Bounds check */
+            continue;
+        uint32_t oldFrameIndex = tile->frameIndex;
+        tile->frameTime += dt;
+        StepTileAnimation(tile);
+        /* If the time step was longer than a whole cycle of the animation then only the remainder matters */
+        if (tile->frameTime > tile->animation.frames[tile->frameIndex].duration) {
+            float cycleDuration = 0.0f;
+            for (uint32_t j = 0; j < tile->animation.framesLength; j++)
+                cycleDuration += tile->animation.frames[j].duration;
+            tile->frameTime = cycleDuration > 0.0f ? fmodf(tile->frameTime, cycleDuration) : 0.0f;
+            StepTileAnimation(tile);
+        }
+        if (tile->frameIndex != oldFrameIndex) {
+            map->tileDraws[gid].frameGid = tile->animation.frames[tile->frameIndex].gid;
+            map->changedGids[map->changedGidsLength++] = gid;
+        }
+    }
+    
+    return map->changedGidsLength;
+}
+
+RAYTMX_DEC bool RebuildTMXTiles(TmxMap* map) {
+    if (map == NULL || map->gidsToTilesLength == 0)
+        return false;
+    
+    /* The last build made the animation frames' GIDs global, in place. They're made local again so that building */
+    /* doesn't offset them twice, and made global again if the build fails without touching them. */
+    OffsetAnimationFrameGids(map, false);
+    if (BuildGidsToTiles(map, map->gidsToTilesLength))
+        return true;
+    OffsetAnimationFrameGids(map, true);
+    return false;
+}
+
+RAYTMX_DEC void LoadTMXRenderCache(TmxMap* map, uint32_t chunkTiles) {
+    if (map == NULL || map->width == 0 || map->height == 0 || map->tileWidth == 0 || map->tileHeight == 0)
+        return;
+    
+    UnloadTMXRenderCache(map); /* Replace any existing cache */
+    if (chunkTiles == 0)
+        chunkTiles = TMX_CHUNK_TILES;
+    
+    RaytmxArena* arena = NULL;
+    RaytmxRenderCache* cache = (RaytmxRenderCache*)ArenaAlloc(&arena, sizeof(RaytmxRenderCache));
+    if (cache == NULL) /* Without a cache, DrawTMX() draws tile by tile */
+        return;
+    cache->arena = arena;
+    cache->chunkTiles = chunkTiles;
+    cache->columns = (map->width + chunkTiles - 1) / chunkTiles;
+    cache->rows = (map->height + chunkTiles - 1) / chunkTiles;
+    
+    /* Tiles larger than the map's tile size, or with offsets, extend beyond their cells. Chunks are padded by the */
+    /* greatest of those extents so that tiles along a chunk's edges aren't cut off. */
+    for (uint32_t gid = 1; gid < map->gidsToTilesLength; gid++) {
+        TmxTile tile = map->gidsToTiles[gid];
+        if (tile.gid == 0)
+            continue;
+        int32_t left = (int32_t)ceilf(-tile.offset.x);
+        int32_t right = (int32_t)ceilf(tile.offset.x + tile.sourceRect.width) - (int32_t)map->tileWidth;
+        int32_t top = (int32_t)ceilf(tile.sourceRect.height - tile.offset.y) - (int32_t)map->tileHeight;
+        int32_t bottom = (int32_t)ceilf(tile.offset.y);
+        cache->padLeft = left > cache->padLeft ? left : cache->padLeft;
+        cache->padRight = right > cache->padRight ? right : cache->padRight;
+        cache->padTop = top > cache->padTop ? top : cache->padTop;
+        cache->padBottom = bottom > cache->padBottom ? bottom : cache->padBottom;
+    }
+    
+    if (map->gidsToTilesLength > 0) {
+        cache->frameIndexes = (uint32_t*)ArenaAlloc(&cache->arena, sizeof(uint32_t) * map->gidsToTilesLength);
+        if (cache->frameIndexes == NULL) {
+            FreeArena(cache->arena);
+            return;
+        }
+        for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++)
+            cache->frameIndexes[gid] = map->gidsToTiles[gid].frameIndex;
+    }
+    
+    /* Tile layers may be nested within group layers so they're gathered into a flat list first */
+    uint32_t tileLayersLength = CollectTileLayers(map->layers, map->layersLength, NULL);
+    const TmxLayer** tileLayers = (const TmxLayer**)MemAllocZero(sizeof(TmxLayer*) * (tileLayersLength + 1));
+    cache->layers = (RaytmxLayerChunks*)ArenaAlloc(&cache->arena, sizeof(RaytmxLayerChunks) * tileLayersLength);
+    uint32_t* gids = (uint32_t*)MemAllocZero(sizeof(uint32_t) * chunkTiles * chunkTiles);
+    bool isOutOfMemory = tileLayers == NULL || cache->layers == NULL || gids == NULL;
+    if (!isOutOfMemory)
+        CollectTileLayers(map->layers, map->layersLength, tileLayers);
+    
+    /* Layers are counted as they're reached so that, if memory runs out, only their chunks need unloading */
+    for (uint32_t i = 0; i < tileLayersLength && !isOutOfMemory; i++) {
+        const TmxTileLayer* tileLayer = &tileLayers[i]->exact.tileLayer;
+        RaytmxLayerChunks* layerChunks = &cache->layers[i];
+        layerChunks->tiles = tileLayer->tiles;
+        layerChunks->tilesLength = tileLayer->tilesLength;
+        layerChunks->chunks = (RaytmxChunk*)ArenaAlloc(&cache->arena,
+                                                       sizeof(RaytmxChunk) * cache->columns * cache->rows);
+        if (layerChunks->chunks == NULL) {
+            isOutOfMemory = true;
+            break;
+        }
+        cache->layersLength = i + 1;
+        
+        for (uint32_t chunkY = 0; chunkY < cache->rows && !isOutOfMemory; chunkY++) {
+            for (uint32_t chunkX = 0; chunkX < cache->columns && !isOutOfMemory; chunkX++) {
+                RaytmxChunk* chunk = &layerChunks->chunks[(chunkY * cache->columns) + chunkX];
+                /* Find whether the chunk has any tiles at all and which of them are animated */
+                bool hasTiles = false;
+                uint32_t gidsLength = 0;
+                for (uint32_t y = chunkY * chunkTiles; y < (chunkY + 1) * chunkTiles && y < map->height; y++) {
+                    for (uint32_t x = chunkX * chunkTiles; x < (chunkX + 1) * chunkTiles && x < map->width; x++) {
+                        uint32_t index = (y * map->width) + x;
+                        if (index >= tileLayer->tilesLength)
+                            continue;
+                        uint32_t gid = GetGid(tileLayer->tiles[index], NULL, NULL, NULL, NULL);
+                        if (gid == 0 || gid >= map->gidsToTilesLength)
+                            continue;
+                        hasTiles = true;
+                        if (!map->gidsToTiles[gid].hasAnimation)
+                            continue;
+                        bool isKnown = false;
+                        for (uint32_t j = 0; j < gidsLength && !isKnown; j++)
+                            isKnown = gids[j] == gid;
+                        if (!isKnown)
+                            gids[gidsLength++] = gid;
+                    }
+                }
+                if (!hasTiles) /* Empty chunks don't need a render texture */
+                    continue;
+                
+                chunk->target = LoadRenderTexture((int)(cache->chunkTiles * map->tileWidth) + cache->padLeft +
+                                                  cache->padRight, (int)(cache->chunkTiles * map->tileHeight) +
+                                                  cache->padTop + cache->padBottom);
+                if (gidsLength > 0) {
+                    chunk->animatedGids = (uint32_t*)ArenaAlloc(&cache->arena, sizeof(uint32_t) * gidsLength);
+                    isOutOfMemory = chunk->animatedGids == NULL;
+                    if (isOutOfMemory)
+                        continue;
+                    memcpy(chunk->animatedGids, gids, sizeof(uint32_t) * gidsLength);
+                    chunk->animatedGidsLength = gidsLength;
+                }
+                chunk->isDirty = true;
             }
         }
     }
+    MemFree(gids);
+    MemFree(tileLayers);
+    
+    map->renderCache = cache;
+    if (isOutOfMemory) { /* Drop the partial cache so that DrawTMX() draws tile by tile instead */
+        TraceLog(LOG_WARNING, "RAYTMX: Out of memory for the render cache of \"%s\"", map->fileName);
+        UnloadTMXRenderCache(map);
+        return;
+    }
+    UpdateTMXRenderCache(map); /* Render every chunk for the first time */
+}
+
+RAYTMX_DEC void UpdateTMXRenderCache(TmxMap* map) {
+    if (map == NULL || map->renderCache == NULL)
+        return;
+    
+    RaytmxRenderCache* cache = map->renderCache;
+    for (uint32_t i = 0; i < cache->layersLength; i++) {
+        RaytmxLayerChunks* layerChunks = &cache->layers[i];
+        for (uint32_t j = 0; j < cache->columns * cache->rows; j++) {
+            RaytmxChunk* chunk = &layerChunks->chunks[j];
+            /* A chunk is only re-rendered when one of its animated tiles is showing a different frame */
+            for (uint32_t k = 0; k < chunk->animatedGidsLength && !chunk->isDirty; k++) {
+                uint32_t gid = chunk->animatedGids[k];
+                chunk->isDirty = map->gidsToTiles[gid].frameIndex != cache->frameIndexes[gid];
+            }
+            if (chunk->isDirty && chunk->target.id != 0)
+                RenderTMXChunk(map, cache, layerChunks, j % cache->columns, j / cache->columns, chunk);
+            chunk->isDirty = false;
+        }
+    }
+    
+    for (uint32_t i = 0; i < map->animatedGidsLength; i++) /* Frames of other tiles never change */
+        cache->frameIndexes[map->animatedGids[i]] = map->gidsToTiles[map->animatedGids[i]].frameIndex;
+}
+
+RAYTMX_DEC void UnloadTMXRenderCache(TmxMap* map) {
+    if (map == NULL || map->renderCache == NULL)
+        return;
+    
+    RaytmxRenderCache* cache = map->renderCache;
+    for (uint32_t i = 0; i < cache->layersLength; i++) {
+        for (uint32_t j = 0; j < cache->columns * cache->rows; j++) {
+            if (cache->layers[i].chunks[j].target.id != 0)
+                UnloadRenderTexture(cache->layers[i].chunks[j].target);
+        }
+    }
+    FreeArena(cache->arena); /* Includes the cache itself */
+    map->renderCache = NULL;
+}
+
+RAYTMX_DEC void UpdateTMXChunkResidency(TmxMap* map, Camera2D camera, uint32_t radius) {
+    if (map == NULL || map->tileWidth == 0 || map->tileHeight == 0)
+        return;
+    
+    UpdateLayerChunkResidency(map, map->layers, map->layersLength, camera.target, radius);
 }
 
 /**
@@ -1356,8 +2573,14 @@ RAYTMX_DEC bool CheckCollisionTMXObjectGroupRec(TmxObjectGroup group, Rectangle
     if (group.objectsLength == 0 || rec.width < 0.0f || rec.height < 0.0f)
         return false; /* Early-out opportunity. These cases would always return false. */
     
-    /* Check the rectangle against TMX objects in the group for collisions */
-    return CheckCollisionTMXObjectGroupObject(group, CreateRectangularTMXObject(rec), outputObject);
+    /* Check the rectangle against TMX objects in the group for collisions, several at a time if the group has bounds */
+    TmxObject recAsObject = CreateRectangularTMXObject(rec);
+    uint32_t index = FindTMXObjectGroupCollision(&group, &recAsObject);
+    if (index == TMX_NO_OBJECT)
+        return false;
+    if (outputObject != NULL)
+        *outputObject = group.objects[index];
+    return true;
 }
 
 RAYTMX_DEC bool CheckCollisionTMXObjectGroupCircle(TmxObjectGroup group, Vector2 center, float radius,
@@ -1373,8 +2596,14 @@ RAYTMX_DEC bool CheckCollisionTMXObjectGroupPoint(TmxObjectGroup group, Vector2
     if (group.objectsLength == 0)
         return false; /* Early-out opportunity. This case would always return false. */
     
-    /* Check the point against TMX objects in the group for collisions */
-    return CheckCollisionTMXObjectGroupObject(group, CreatePointTMXObject(point), outputObject);
+    /* Check the point against TMX objects in the group for collisions, several at a time if the group has bounds */
+    TmxObject pointAsObject = CreatePointTMXObject(point);
+    uint32_t index = FindTMXObjectGroupCollision(&group, &pointAsObject);
+    if (index == TMX_NO_OBJECT)
+        return false;
+    if (outputObject != NULL)
+        *outputObject = group.objects[index];
+    return true;
 }
 
 RAYTMX_DEC bool CheckCollisionTMXObjectGroupPoly(TmxObjectGroup group, Vector2* points, int pointCount,
@@ -1396,12 +2625,422 @@ RAYTMX_DEC bool CheckCollisionTMXObjectGroupPolyEx(TmxObjectGroup group, Vector2
     return CheckCollisionTMXObjectGroupObject(group, CreatePolygonTMXObject(points, pointCount, aabb), outputObject);
 }
 
+RAYTMX_DEC uint32_t CheckCollisionTMXObjectGroupRecs(const TmxObjectGroup* group, const Rectangle* recs,
+                                                     uint32_t recsLength, uint32_t* objectIndices) {
+    if (group == NULL || recs == NULL || objectIndices == NULL)
+        return 0;
+    
+    uint32_t hits = 0;
+    for (uint32_t i = 0; i < recsLength; i++) {
+        TmxObject recAsObject = CreateRectangularTMXObject(recs[i]);
+        if (recs[i].width < 0.0f || recs[i].height < 0.0f) { /* Never collides, as with the single-query check */
+            objectIndices[i] = TMX_NO_OBJECT;
+            continue;
+        }
+        objectIndices[i] = FindTMXObjectGroupCollision(group, &recAsObject);
+        if (objectIndices[i] != TMX_NO_OBJECT)
+            hits++;
+    }
+    
+    return hits;
+}
+
+RAYTMX_DEC uint32_t CheckCollisionTMXObjectGroupPoints(const TmxObjectGroup* group, const Vector2* points,
+                                                       uint32_t pointsLength, uint32_t* objectIndices) {
+    if (group == NULL || points == NULL || objectIndices == NULL)
+        return 0;
+    
+    uint32_t hits = 0;
+    for (uint32_t i = 0; i < pointsLength; i++) {
+        TmxObject pointAsObject = CreatePointTMXObject(points[i]);
+        objectIndices[i] = FindTMXObjectGroupCollision(group, &pointAsObject);
+        if (objectIndices[i] != TMX_NO_OBJECT)
+            hits++;
+    }
+    
+    return hits;
+}
+
+RAYTMX_DEC uint32_t QueryTMXObjectGroupBounds(const TmxObjectGroup* group, Rectangle rec, uint32_t* indices,
+                                              uint32_t indicesCapacity) {
+    if (group == NULL || group->objectsLength == 0)
+        return 0; /* Early-out opportunity. This case would never find anything. */
+    
+    /* The bounds' comparisons leave out AABBs that only touch, as CheckCollisionRecs() does. Moving each edge of the */
+    /* rectangle out by the smallest step a float can take brings exactly those back, so that this query finds the */
+    /* same objects as the others. */
+    float minX = nextafterf(rec.x, -INFINITY), minY = nextafterf(rec.y, -INFINITY),
+          maxX = nextafterf(rec.x + rec.width, INFINITY), maxY = nextafterf(rec.y + rec.height, INFINITY);
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < group->objectsLength; i++) {
+        if (group->bounds != NULL) { /* If the group has bounds, skip to the next object with an overlapping AABB */
+            i = NextOverlappingBounds(group->bounds, i, minX, minY, maxX, maxY);
+            if (i >= group->objectsLength)
+                break;
+        } else {
+            Rectangle aabb = group->objects[i].aabb;
+            if (aabb.x > rec.x + rec.width || aabb.x + aabb.width < rec.x || aabb.y > rec.y + rec.height ||
+                aabb.y + aabb.height < rec.y)
+                continue;
+        }
+        if (count < indicesCapacity)
+            indices[count] = i;
+        count++;
+    }
+    
+    return count;
+}
+
+RAYTMX_DEC void UpdateTMXObjectGroupBounds(TmxObjectGroup* group) {
+    if (group == NULL)
+        return;
+    
+    if (group->bounds != NULL && group->bounds->length >= group->objectsLength)
+        CopyObjectGroupBounds(group->bounds, group);
+    if (group->bvh != NULL && group->bvh->objectIndicesLength == group->objectsLength)
+        RefitObjectGroupBvh(group->bvh, group->objects);
+    /* The grid lists each object in the cells it covered when loaded. Moved objects may cover other cells, or more */
+    /* of them than there is room for, so rather than return stale objects the grid is let go. It lives in the map's */
+    /* arena, which frees it with the rest of the map. */
+    group->grid = NULL;
+}
+
+RAYTMX_DEC uint32_t QueryTMXObjectGroupGrid(const TmxObjectGroup* group, Rectangle rec, uint32_t* indices,
+                                            uint32_t indicesCapacity) {
+    if (group == NULL || group->objectsLength == 0)
+        return 0; /* Early-out opportunity. This case would never find anything. */
+
+    uint32_t count = 0;
+    const TmxObjectGrid* grid = group->grid;
+    if (grid == NULL) { /* If there is no spatial grid then fall back to testing every object's AABB */
+        for (uint32_t i = 0; i < group->objectsLength; i++) {
+            Rectangle aabb = group->objects[i].aabb;
+            if (aabb.x <= rec.x + rec.width && aabb.x + aabb.width >= rec.x &&
+                aabb.y <= rec.y + rec.height && aabb.y + aabb.height >= rec.y) {
+                if (count < indicesCapacity)
+                    indices[count] = i;
+                count++;
+            }
+        }
+        return count; /* Already in ascending order */
+    }
+
+    /* Determine the range of cells overlapped by the query rectangle, clamped to the grid */
+    float maxX = grid->originX + grid->cellWidth * grid->columns, maxY = grid->originY + grid->cellHeight * grid->rows;
+    if (rec.x > maxX || rec.x + rec.width < grid->originX || rec.y > maxY || rec.y + rec.height < grid->originY)
+        return 0; /* The rectangle is entirely outside of the grid and therefore outside of every AABB */
+    int32_t firstColumn = Clampi((int32_t)((rec.x - grid->originX) / grid->cellWidth), 0, (int)grid->columns - 1),
+        lastColumn = Clampi((int32_t)((rec.x + rec.width - grid->originX) / grid->cellWidth), 0, (int)grid->columns - 1),
+        firstRow = Clampi((int32_t)((rec.y - grid->originY) / grid->cellHeight), 0, (int)grid->rows - 1),
+        lastRow = Clampi((int32_t)((rec.y + rec.height - grid->originY) / grid->cellHeight), 0, (int)grid->rows - 1);
+
+    for (int32_t row = firstRow; row <= lastRow; row++) {
+        for (int32_t column = firstColumn; column <= lastColumn; column++) {
+            uint32_t cell = (uint32_t)row * grid->columns + (uint32_t)column;
+            for (uint32_t i = grid->cellStarts[cell]; i < grid->cellStarts[cell + 1]; i++) {
+                uint32_t index = grid->cellObjects[i];
+                Rectangle aabb = group->objects[index].aabb;
+                if (aabb.x > rec.x + rec.width || aabb.x + aabb.width < rec.x ||
+                    aabb.y > rec.y + rec.height || aabb.y + aabb.height < rec.y)
+                    continue; /* Shares a cell with the rectangle but doesn't overlap it */
+                /* An object spanning several cells is listed in each of them. Only report it from the first cell */
+                /* that both it and the query rectangle overlap so that it's reported exactly once. */
+                int32_t objectColumn = Clampi((int32_t)((aabb.x - grid->originX) / grid->cellWidth), 0,
+                                              (int)grid->columns - 1),
+                    objectRow = Clampi((int32_t)((aabb.y - grid->originY) / grid->cellHeight), 0, (int)grid->rows - 1);
+                if (column != (objectColumn > firstColumn ? objectColumn : firstColumn) ||
+                    row != (objectRow > firstRow ? objectRow : firstRow))
+                    continue;
+                if (count < indicesCapacity)
+                    indices[count] = index;
+                count++;
+            }
+        }
+    }
+
+    /* Cells are visited in spatial order so sort the results to give callers a consistent, index-based order */
+    uint32_t written = count < indicesCapacity ? count : indicesCapacity;
+    if (written > 1)
+        qsort(indices, written, sizeof(uint32_t), CompareObjectIndexes);
+
+    return count;
+}
+
+RAYTMX_DEC uint32_t QueryTMXObjectGroupBVH(const TmxObjectGroup* group, Rectangle rec, uint32_t* indices,
+                                           uint32_t indicesCapacity) {
+    if (group == NULL || group->objectsLength == 0)
+        return 0; /* Early-out opportunity. This case would never find anything. */
+    
+    uint32_t count = 0;
+    const TmxObjectBvh* bvh = group->bvh;
+    if (bvh == NULL) { /* If there is no hierarchy then fall back to testing every object's AABB */
+        for (uint32_t i = 0; i < group->objectsLength; i++) {
+            Rectangle aabb = group->objects[i].aabb;
+            if (aabb.x <= rec.x + rec.width && aabb.x + aabb.width >= rec.x &&
+                aabb.y <= rec.y + rec.height && aabb.y + aabb.height >= rec.y) {
+                if (count < indicesCapacity)
+                    indices[count] = i;
+                count++;
+            }
+        }
+        return count; /* Already in ascending order */
+    }
+    
+    uint32_t stack[TMX_BVH_STACK_SIZE], stackLength = 0;
+    stack[stackLength++] = 0; /* Start from the root */
+    while (stackLength > 0) {
+        const TmxObjectBvhNode* node = &bvh->nodes[stack[--stackLength]];
+        if (node->minX > rec.x + rec.width || node->maxX < rec.x || node->minY > rec.y + rec.height ||
+            node->maxY < rec.y)
+            continue; /* Nothing beneath this node can overlap the rectangle */
+        if (node->count == 0) { /* If this is an inner node, visit both of its children */
+            stack[stackLength++] = node->start;
+            stack[stackLength++] = (uint32_t)(node - bvh->nodes) + 1;
+            continue;
+        }
+        for (uint32_t i = node->start; i < node->start + node->count; i++) {
+            uint32_t index = bvh->objectIndices[i];
+            Rectangle aabb = group->objects[index].aabb;
+            if (aabb.x > rec.x + rec.width || aabb.x + aabb.width < rec.x ||
+                aabb.y > rec.y + rec.height || aabb.y + aabb.height < rec.y)
+                continue;
+            if (count < indicesCapacity)
+                indices[count] = index;
+            count++;
+        }
+    }
+    
+    /* Leaves are visited in spatial order so sort the results to give callers a consistent, index-based order */
+    uint32_t written = count < indicesCapacity ? count : indicesCapacity;
+    if (written > 1)
+        qsort(indices, written, sizeof(uint32_t), CompareObjectIndexes);
+    
+    return count;
+}
+
+RAYTMX_DEC bool RaycastTMXObjectGroup(const TmxObjectGroup* group, Vector2 from, Vector2 to, TmxRaycastHit* hit) {
+    if (group == NULL || group->objectsLength == 0)
+        return false; /* Early-out opportunity. This case would never hit anything. */
+    
+    Vector2 delta = (Vector2){to.x - from.x, to.y - from.y};
+    uint32_t nearestIndex = TMX_NO_OBJECT;
+    float nearestTime = 1.0f; /* Nothing past the end of the segment counts */
+    Vector2 nearestNormal = (Vector2){0.0f, 0.0f};
+    float time;
+    Vector2 normal;
+    const TmxObjectBvh* bvh = group->bvh;
+    if (bvh == NULL) { /* If there is no hierarchy then every object is checked */
+        /* The group's bounds, if it has them, rule out objects the segment's box misses without touching the objects */
+        const TmxObjectBounds* bounds = group->bounds;
+        float segmentMinX = from.x < to.x ? from.x : to.x, segmentMaxX = from.x < to.x ? to.x : from.x,
+            segmentMinY = from.y < to.y ? from.y : to.y, segmentMaxY = from.y < to.y ? to.y : from.y;
+        for (uint32_t i = 0; i < group->objectsLength; i++) {
+            if (bounds != NULL && (bounds->minX[i] > segmentMaxX || bounds->maxX[i] < segmentMinX ||
+                                   bounds->minY[i] > segmentMaxY || bounds->maxY[i] < segmentMinY))
+                continue;
+            if (IntersectSegmentTMXObject(&group->objects[i], from, to, &time, &normal) &&
+                (nearestIndex == TMX_NO_OBJECT || time < nearestTime)) {
+                nearestIndex = i;
+                nearestTime = time;
+                nearestNormal = normal;
+            }
+        }
+    } else {
+        /* Nodes are visited nearest first, each with the time the segment enters its box, so that once something is */
+        /* hit every node entered later than that can be skipped. Node boxes are unions of object boxes, so nodes are */
+        /* never entered later than the objects beneath them. */
+        uint32_t stack[TMX_BVH_STACK_SIZE], stackLength = 0;
+        float stackTimes[TMX_BVH_STACK_SIZE];
+        const TmxObjectBvhNode* root = &bvh->nodes[0];
+        if (IntersectSegmentBox(from, delta, root->minX, root->minY, root->maxX, root->maxY, &time, NULL)) {
+            stack[stackLength] = 0;
+            stackTimes[stackLength++] = time;
+        }
+        while (stackLength > 0) {
+            stackLength--;
+            if (nearestIndex != TMX_NO_OBJECT && stackTimes[stackLength] > nearestTime)
+                continue; /* Everything beneath this node is farther than what was already hit */
+            const TmxObjectBvhNode* node = &bvh->nodes[stack[stackLength]];
+            if (node->count == 0) { /* If this is an inner node, queue whichever children the segment enters */
+                uint32_t children[2] = {(uint32_t)(node - bvh->nodes) + 1, node->start};
+                float childTimes[2];
+                bool entered[2];
+                for (int i = 0; i < 2; i++) {
+                    const TmxObjectBvhNode* child = &bvh->nodes[children[i]];
+                    entered[i] = IntersectSegmentBox(from, delta, child->minX, child->minY, child->maxX, child->maxY,
+                                                     &childTimes[i], NULL);
+                }
+                int nearer = entered[1] && (!entered[0] || childTimes[1] < childTimes[0]) ? 1 : 0;
+                for (int i = 0; i < 2; i++) { /* The nearer child goes on last so that it comes off first */
+                    int which = i == 0 ? 1 - nearer : nearer;
+                    if (!entered[which])
+                        continue;
+                    stack[stackLength] = children[which];
+                    stackTimes[stackLength++] = childTimes[which];
+                }
+                continue;
+            }
+            for (uint32_t i = node->start; i < node->start + node->count; i++) {
+                uint32_t index = bvh->objectIndices[i];
+                if (IntersectSegmentTMXObject(&group->objects[index], from, to, &time, &normal) &&
+                    (nearestIndex == TMX_NO_OBJECT || time < nearestTime ||
+                     (time == nearestTime && index < nearestIndex))) {
+                    nearestIndex = index;
+                    nearestTime = time;
+                    nearestNormal = normal;
+                }
+            }
+        }
+    }
+    
+    if (nearestIndex == TMX_NO_OBJECT)
+        return false;
+    if (hit != NULL) {
+        hit->objectIndex = nearestIndex;
+        hit->time = nearestTime;
+        hit->point = (Vector2){from.x + delta.x * nearestTime, from.y + delta.y * nearestTime};
+        hit->normal = nearestNormal;
+    }
+    return true;
+}
+
+RAYTMX_DEC uint32_t EnumerateTMXObjectGroupCollisions(const TmxObjectGroup* group, TmxObject object,
+                                                      uint32_t* indices, uint32_t indicesCapacity) {
+    if (group == NULL || group->objectsLength == 0)
+        return 0; /* Early-out opportunity. This case would never find anything. */
+    
+    uint32_t count = 0;
+    const TmxObjectBvh* bvh = group->bvh;
+    if (bvh == NULL) { /* If there is no hierarchy then every object is checked */
+        for (uint32_t i = 0; i < group->objectsLength; i++) {
+            if (CheckCollisionTMXObjects(group->objects[i], object)) {
+                if (count < indicesCapacity)
+                    indices[count] = i;
+                count++;
+            }
+        }
+        return count; /* Already in ascending order */
+    }
+    
+    Rectangle aabb = object.aabb;
+    uint32_t stack[TMX_BVH_STACK_SIZE], stackLength = 0;
+    stack[stackLength++] = 0; /* Start from the root */
+    while (stackLength > 0) {
+        const TmxObjectBvhNode* node = &bvh->nodes[stack[--stackLength]];
+        if (node->minX > aabb.x + aabb.width || node->maxX < aabb.x || node->minY > aabb.y + aabb.height ||
+            node->maxY < aabb.y)
+            continue; /* Nothing beneath this node can collide with the object */
+        if (node->count == 0) { /* If this is an inner node, visit both of its children */
+            stack[stackLength++] = node->start;
+            stack[stackLength++] = (uint32_t)(node - bvh->nodes) + 1;
+            continue;
+        }
+        for (uint32_t i = node->start; i < node->start + node->count; i++) {
+            uint32_t index = bvh->objectIndices[i];
+            if (!CheckCollisionTMXObjects(group->objects[index], object))
+                continue;
+            if (count < indicesCapacity)
+                indices[count] = index;
+            count++;
+        }
+    }
+    
+    /* Leaves are visited in spatial order so sort the results to give callers a consistent, index-based order */
+    uint32_t written = count < indicesCapacity ? count : indicesCapacity;
+    if (written > 1)
+        qsort(indices, written, sizeof(uint32_t), CompareObjectIndexes);
+    
+    return count;
+}
+
+RAYTMX_DEC void SortTMXObjectGroup(TmxObjectGroup* group) {
+    if (group == NULL || group->objects == NULL || group->ySortedObjects == NULL)
+        return;
+    
+    /* Insertion sort: linear when nothing moved and each object only travels as far as its order actually changed */
+    uint32_t* ySortedObjects = group->ySortedObjects;
+    for (uint32_t i = 1; i < group->objectsLength; i++) {
+        uint32_t index = ySortedObjects[i];
+        double y = group->objects[index].y;
+        uint32_t j = i;
+        while (j > 0) {
+            uint32_t previousIndex = ySortedObjects[j - 1];
+            double previousY = group->objects[previousIndex].y;
+            if (previousY < y || (previousY == y && previousIndex < index))
+                break; /* Already in order */
+            ySortedObjects[j] = previousIndex;
+            j--;
+        }
+        ySortedObjects[j] = index;
+    }
+}
+
 static LoadTextureCallback loadTextureOverride = NULL;
 
 RAYTMX_DEC void SetLoadTextureTMX(LoadTextureCallback callback) {
     loadTextureOverride = callback;
 }
 
+static RaytmxTextureCache textureCache;
+
+/* Set only on the worker thread of a LoadTMXAsync() call, for as long as that thread is parsing */
+static RAYTMX_THREAD_LOCAL TmxAsyncLoad* asyncLoadOnThread = NULL;
+
+RAYTMX_DEC Texture2D LoadTextureTMX(const char* fileName) {
+    Texture2D texture;
+    memset(&texture, 0, sizeof(Texture2D));
+    if (fileName == NULL)
+        return texture;
+    
+    /* First try to find an already-loaded texture identified by the file name */
+    uint32_t fileNameHash = HashFileName(fileName);
+    int32_t index = FindCachedTexture(fileName, fileNameHash);
+    if (index >= 0) {
+        textureCache.textures[index].references++;
+        return textureCache.textures[index].texture;
+    }
+    
+    texture = loadTextureOverride ? loadTextureOverride(fileName) : LoadTexture(fileName);
+    if (texture.id == 0) /* If loading the texture failed */
+        return texture;
+    
+    /* Without room to cache it the texture is still usable. UnloadTextureTMX() unloads textures it doesn't know. */
+    AddCachedTexture(fileName, fileNameHash, texture);
+    
+    return texture;
+}
+
+RAYTMX_DEC void UnloadTextureTMX(Texture2D texture) {
+    if (texture.id == 0)
+        return;
+    
+    int32_t index = FindCachedTextureById(texture.id);
+    if (index < 0) { /* If the texture didn't come from the cache */
+        UnloadTexture(texture);
+        return;
+    }
+    
+    RaytmxCachedTexture* cachedTexture = &textureCache.textures[index];
+    if (--cachedTexture->references > 0)
+        return; /* Still in use by another map, tileset, or caller */
+    
+    UnloadTexture(cachedTexture->texture);
+    MemFree(cachedTexture->fileName);
+    
+    if (--textureCache.texturesLength == 0) { /* If that was the last texture then release the cache itself */
+        MemFree(textureCache.textures);
+        MemFree(textureCache.byFileName);
+        MemFree(textureCache.byTextureId);
+        memset(&textureCache, 0, sizeof(RaytmxTextureCache));
+        return;
+    }
+    
+    /* Fill the hole with the last texture. Textures are unloaded rarely, with their maps, so rebuilding the indexes */
+    /* costs less overall than having lookups step over deleted entries. */
+    textureCache.textures[index] = textureCache.textures[textureCache.texturesLength];
+    IndexTextureCache();
+}
+
 static int tmxLogFlags = 0;
 
 RAYTMX_DEC void TraceLogTMX(int logLevel, const TmxMap* map) {
@@ -1446,10 +3085,11 @@ RAYTMX_DEC void SetTraceLogFlagsTMX(int logFlags) {
 /**********************************************************************************************************************/
 /* Private implementation.                                                                                            */
 
-RaytmxExternalTileset LoadTSX(const char* fileName) {
+RaytmxExternalTileset LoadTSX(RaytmxArena** arena, const char* fileName) {
     RaytmxState raytmxState[1];
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TSX;
+    raytmxState->arena = arena; /* The tileset will become part of the map so allocate from the map's arena */
     
     /* Initialize an external tileset object */
     RaytmxExternalTileset externalTileset;
@@ -1458,17 +3098,19 @@ RaytmxExternalTileset LoadTSX(const char* fileName) {
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
     ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess)
+    if (!raytmxState->isSuccess) {
+        FreeState(raytmxState);
         return externalTileset; /* Will have 'isSuccess' set to false to indicate a failure */
+    }
     
     if (raytmxState->tilesetsRoot != NULL) { /* If there is at least one tileset */
         /* Copy the root tileset so it can be returned */
         externalTileset.tileset = raytmxState->tilesetsRoot->tileset;
         externalTileset.isSuccess = true;
-        /* TSX files should have only one tileset so any others will be freed/unloaded immediately */
+        /* TSX files should have only one tileset so any others will be unloaded immediately */
         RaytmxTilesetNode* tilesetIterator = raytmxState->tilesetsRoot->next;
         while (tilesetIterator != NULL) {
-            FreeTileset(tilesetIterator->tileset);
+            UnloadTilesetTextures(tilesetIterator->tileset);
             tilesetIterator = tilesetIterator->next;
         }
     } else
@@ -1480,10 +3122,11 @@ RaytmxExternalTileset LoadTSX(const char* fileName) {
     return externalTileset;
 }
 
-RaytmxObjectTemplate LoadTX(const char* fileName) {
+RaytmxObjectTemplate LoadTX(RaytmxArena** arena, const char* fileName) {
     RaytmxState raytmxState[1];
     memset(raytmxState, 0, sizeof(RaytmxState)); /* Initialize all values to zero, NULL, or an equivalent enum value */
     raytmxState->format = FORMAT_TX;
+    raytmxState->arena = arena; /* Instanced objects share the template's data so allocate from the map's arena */
     
     /* Initialize an object template object */
     RaytmxObjectTemplate objectTemplate;
@@ -1492,19 +3135,16 @@ RaytmxObjectTemplate LoadTX(const char* fileName) {
     /* Do format-agnostic parsing of the document. The state object will be populated with raytmx's models of the */
     /* equivalent TMX, TSX, and/or TX elements. */
     ParseDocument(raytmxState, fileName);
-    if (!raytmxState->isSuccess)
+    if (!raytmxState->isSuccess) {
+        FreeState(raytmxState);
         return objectTemplate; /* Will have 'isSuccess' set to false to indicate a failure */
+    }
     
     if (raytmxState->objectsRoot != NULL) { /* If there is at least one object */
         /* Copy the root object so it can be returned */
         objectTemplate.object = raytmxState->objectsRoot->object;
         objectTemplate.isSuccess = true;
-        /* TX files should have only one object so any others will be freed/unloaded immediately */
-        RaytmxObjectNode* objectIterator = raytmxState->objectsRoot->next;
-        while (objectIterator != NULL) {
-            FreeObject(objectIterator->object);
-            objectIterator = objectIterator->next;
-        }
+        /* TX files should have only one object. Any others are ignored. */
     } else
         TraceLog(LOG_WARNING, "RAYTMX: TX file (object template) \"%s\" does not contain any objects", fileName);
     
@@ -1513,10 +3153,10 @@ RaytmxObjectTemplate LoadTX(const char* fileName) {
         /* attribute is set).  Copy the root tileset so it can be returned */
         objectTemplate.tileset = raytmxState->tilesetsRoot->tileset;
         objectTemplate.hasTileset = true;
-        /* TX files should have at most one tileset so any others will be freed/unloaded immediately */
+        /* TX files should have at most one tileset so any others will be unloaded immediately */
         RaytmxTilesetNode* tilesetsIterator = raytmxState->tilesetsRoot->next;
         while (tilesetsIterator != NULL) {
-            FreeTileset(tilesetsIterator->tileset);
+            UnloadTilesetTextures(tilesetsIterator->tileset);
             tilesetsIterator = tilesetsIterator->next;
         }
     }
@@ -1652,6 +3292,9 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
         raytmxState->layer = AddGenericLayer(raytmxState, /* isGroup: */ false);
         raytmxState->layer->type = LAYER_TYPE_TILE_LAYER;
         raytmxState->tileLayer = &raytmxState->layer->exact.tileLayer;
+    } else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->tileLayer != NULL) /* Infinite maps' <data> elements hold <chunk>s rather than tiles */
+            raytmxState->tileChunk = AddTileChunk(raytmxState);
     } else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->tilesetTile != NULL) { /* If the object group is a child of a <tile>, it's collision info */
             raytmxState->objectGroup = &raytmxState->tilesetTile->objectGroup;
@@ -1692,7 +3335,7 @@ void HandleElementBegin(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext)
     } else if (strcmp(hoxmlContext->tag, "text") == 0) {
         if (raytmxState->object != NULL) {
             raytmxState->object->type = OBJECT_TYPE_TEXT;
-            raytmxState->object->text = (TmxText*)MemAllocZero(sizeof(TmxText));
+            raytmxState->object->text = (TmxText*)ArenaAlloc(raytmxState->arena, sizeof(TmxText));
             /* There are a couple non-zero default values for <text> attributes: */
             raytmxState->object->text->pixelSize = 16;
             raytmxState->object->text->color.a = 255; /* Full opacity black */
@@ -1756,7 +3399,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     else if (strcmp(hoxmlContext->tag, "property") == 0) {
         if (raytmxState->property != NULL) {
             if (strcmp(hoxmlContext->attribute, "name") == 0) {
-                raytmxState->property->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->property->name = (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->property->name, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "type") == 0) {
                 if (strcmp(hoxmlContext->value, "string") == 0)
@@ -1781,7 +3424,8 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 /* attribute. In that case, doing a cast/conversion now may not be possible. To avoid this, the raw */
                 /* string value is copied to 'stringValue' temporarily, or permanently for string and file types, and */
                 /* the cast/conversion will happen at the end of the element if needed. */
-                raytmxState->property->stringValue = (char*)MemAlloc((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->property->stringValue =
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->property->stringValue, hoxmlContext->value);
             } /* strcmp(hoxmlContext->attribute, "value") == 0 */
         } /* raytmxState->property != NULL */
@@ -1791,11 +3435,11 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (strcmp(hoxmlContext->attribute, "firstgid") == 0)
                 raytmxState->tileset->firstGid = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "source") == 0) {
-                raytmxState->tileset->source = (char*)MemAlloc((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->tileset->source = (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileset->source, hoxmlContext->value);
                 /* 'source' points to an external TSX file that defines the majority of the tileset. Try to load it. */
-                RaytmxExternalTileset externalTileset = LoadTSX(JoinPath(raytmxState->documentDirectory,
-                                                                         hoxmlContext->value));
+                RaytmxExternalTileset externalTileset =
+                LoadTSX(raytmxState->arena, JoinPath(raytmxState->documentDirectory, hoxmlContext->value));
                 if (externalTileset.isSuccess) {
                     /* A <tileset> within a <map> will have two attributes: 'firstgid' and 'source.' The rest of */
                     /* the tileset's details are in the external TSX that 'source' points to. They need to be merged. */
@@ -1810,10 +3454,11 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     raytmxState->tileset->source = tempSource;
                 }
             } else if (strcmp(hoxmlContext->attribute, "name") == 0) {
-                raytmxState->tileset->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->tileset->name = (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileset->name, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "class") == 0) {
-                raytmxState->tileset->classString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->tileset->classString =
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileset->classString, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "tilewidth") == 0)
                 raytmxState->tileset->tileWidth = atoi(hoxmlContext->value);
@@ -1862,11 +3507,9 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     else if (strcmp(hoxmlContext->tag, "image") == 0) {
         if (raytmxState->image != NULL) {
             if (strcmp(hoxmlContext->attribute, "source") == 0) {
-                raytmxState->image->source = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->image->source = (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->image->source, hoxmlContext->value);
-                RaytmxCachedTextureNode* cachedTexture = LoadCachedTexture(raytmxState, hoxmlContext->value);
-                if (cachedTexture != NULL)
-                    raytmxState->image->texture = cachedTexture->texture;
+                raytmxState->image->texture = LoadCachedTexture(raytmxState, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "trans") == 0) {
                 raytmxState->image->trans = GetColorFromHexString(hoxmlContext->value);
                 raytmxState->image->hasTrans = true;
@@ -1882,7 +3525,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 raytmxState->tilesetTile->id = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "type") == 0 || strcmp(hoxmlContext->attribute, "class") == 0) {
                 raytmxState->tilesetTile->classString =
-                (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tilesetTile->classString, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "x") == 0)
                 raytmxState->tilesetTile->x = atoi(hoxmlContext->value);
@@ -1917,11 +3560,12 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     else if (strcmp(hoxmlContext->tag, "data") == 0) {
         if (raytmxState->tileLayer != NULL) { /* If this <data> applies to a <layer> */
             if (strcmp(hoxmlContext->attribute, "encoding") == 0) {
-                raytmxState->tileLayer->encoding = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->tileLayer->encoding =
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileLayer->encoding, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "compression") == 0) {
                 raytmxState->tileLayer->compression =
-                (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->tileLayer->compression, hoxmlContext->value);
             }
         } else if (raytmxState->image != NULL) { /* If this <data> applies to an <image> */
@@ -1929,6 +3573,18 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* provide any more information than that. Tiled doesn't seem to have a feature for this either. */
         }
     } /* strcmp(hoxmlContext->tag, "data") == 0 */
+    else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->tileChunk != NULL) {
+            if (strcmp(hoxmlContext->attribute, "x") == 0)
+                raytmxState->tileChunk->x = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "y") == 0)
+                raytmxState->tileChunk->y = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "width") == 0)
+                raytmxState->tileChunk->width = atoi(hoxmlContext->value);
+            else if (strcmp(hoxmlContext->attribute, "height") == 0)
+                raytmxState->tileChunk->height = atoi(hoxmlContext->value);
+        }
+    } /* strcmp(hoxmlContext->tag, "chunk") == 0 */
     else if (strcmp(hoxmlContext->tag, "objectgroup") == 0) {
         if (raytmxState->objectGroup != NULL) {
             /* Check for attributes specific to <objectgroup> layers */
@@ -1952,10 +3608,11 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (strcmp(hoxmlContext->attribute, "id") == 0)
                 raytmxState->object->id = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "name") == 0) {
-                raytmxState->object->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->object->name = (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->object->name, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "type") == 0) {
-                raytmxState->object->typeString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->object->typeString =
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->object->typeString, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "x") == 0)
                 raytmxState->object->x = atof(hoxmlContext->value);
@@ -1975,7 +3632,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 raytmxState->object->visible = atoi(hoxmlContext->value) != 0 ? true : false;
             else if (strcmp(hoxmlContext->attribute, "template") == 0) {
                 raytmxState->object->templateString =
-                (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->object->templateString, hoxmlContext->value);
             }
         }
@@ -2019,7 +3676,8 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 StringCopyN(y, iterator, terminator - iterator); /* Copy 'iterator' up to but excluding 'terminator' */
                 y[terminator - iterator] = '\0';
                 /* Create a linked list node to hold the point and append it to the linked list */
-                RaytmxPolyPointNode* node = (RaytmxPolyPointNode*)MemAllocZero(sizeof(RaytmxPolyPointNode));
+                RaytmxPolyPointNode* node =
+                (RaytmxPolyPointNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxPolyPointNode));
                 /* Note: These values may be negative. A poly(gon|line) object's position is determined by the first */
                 /* vertex added leading to the first entry to be "0,0" and all other vertices relative to it. */
                 node->point.x = (float)atof(x);
@@ -2047,22 +3705,20 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     pointsLength += 1;
                 }
                 /* Allocate the array and assign NULL to every index to be safe */
-                Vector2* points = (Vector2*)MemAllocZero(sizeof(Vector2) * pointsLength);
+                Vector2* points = (Vector2*)ArenaAlloc(raytmxState->arena, sizeof(Vector2) * pointsLength);
                 if (isPolygon) { /* If the centroid should be included as a vertex */
                     /* Finish calculating the centroid by averaging the sum of the vertices keeping in mind that */
                     /* 'pointsLength' is equal to N + 2 */
                     points[0].x = vertexSum.x / (pointsLength - 2);
                     points[0].y = vertexSum.y / (pointsLength - 2);
                 }
-                /* Copy the points as Vector2s into the array and free the nodes while we're at it */
+                /* Copy the points as Vector2s into the array */
                 RaytmxPolyPointNode* iteratorNode = pointsRoot;
                 uint32_t i = isPolygon ? 1 : 0; /* Skip over the first element, the centroid, for polygons only */
                 while (iteratorNode != NULL) {
                     points[i] = iteratorNode->point;
-                    RaytmxPolyPointNode* parent = iteratorNode;
                     iteratorNode = iteratorNode->next;
                     i += 1;
-                    MemFree(parent);
                 }
                 /* End the list with the first point. Both polygons and polylines use this when drawing. */
                 points[pointsLength - 1].x = points[isPolygon ? 1 : 0].x;
@@ -2071,7 +3727,8 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 /* Add the points array to the element it applies to */
                 raytmxState->object->points = points;
                 raytmxState->object->pointsLength = pointsLength;
-                raytmxState->object->drawPoints = (Vector2*)MemAllocZero(sizeof(Vector2) * pointsLength);
+                raytmxState->object->drawPoints =
+                (Vector2*)ArenaAlloc(raytmxState->arena, sizeof(Vector2) * pointsLength);
             }
         } /* raytmxState->object != NULL && strcmp(hoxmlContext->attribute, "points") == 0 */
     } /* strcmp(hoxmlContext->tag, "polygon") == 0 || strcmp(hoxmlContext->tag, "polyline") == 0 */
@@ -2079,7 +3736,7 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         if (raytmxState->object != NULL && raytmxState->object->text != NULL) {
             if (strcmp(hoxmlContext->attribute, "fontfamily") == 0) {
                 raytmxState->object->text->fontFamily =
-                (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->object->text->fontFamily, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "pixelsize") == 0)
                 raytmxState->object->text->pixelSize = atoi(hoxmlContext->value);
@@ -2133,10 +3790,11 @@ void HandleAttribute(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (strcmp(hoxmlContext->attribute, "id") == 0)
                 raytmxState->layer->id = atoi(hoxmlContext->value);
             else if (strcmp(hoxmlContext->attribute, "name") == 0) {
-                raytmxState->layer->name = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->layer->name = (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->layer->name, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "class") == 0) {
-                raytmxState->layer->classString = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->value) + 1);
+                raytmxState->layer->classString =
+                (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->value) + 1);
                 StringCopy(raytmxState->layer->classString, hoxmlContext->value);
             } else if (strcmp(hoxmlContext->attribute, "opacity") == 0)
                 raytmxState->layer->opacity = atof(hoxmlContext->value);
@@ -2173,12 +3831,12 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (layer->name == NULL) { /* If this layer didn't have a 'name' attribute */
                 /* The default value for 'name' is "" (an empty string) */
-                layer->name = (char*)MemAlloc(1);
+                layer->name = (char*)ArenaAlloc(raytmxState->arena, 1);
                 layer->name[0] = '\0';
             }
             if (layer->classString == NULL) { /* If this layer didn't have a 'class' attribute */
                 /* The default value for 'class' is "" (an empty string) */
-                layer->classString = (char*)MemAlloc(1);
+                layer->classString = (char*)ArenaAlloc(raytmxState->arena, 1);
                 layer->classString[0] = '\0';
             }
         }
@@ -2195,14 +3853,13 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
         if (raytmxState->propertiesDepth > 0) /* If the outermost <properties> has not yet ended */
             return;
         /* Allocate the array and assign NULL to every index to be safe */
-        TmxProperty* properties = (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * raytmxState->propertiesLength);
-        /* Copy the TmxProperty pointers into the array and free the nodes while we're at it */
+        TmxProperty* properties =
+        (TmxProperty*)ArenaAlloc(raytmxState->arena, sizeof(TmxProperty) * raytmxState->propertiesLength);
+        /* Copy the TmxProperty pointers into the array */
         RaytmxPropertyNode* iterator = raytmxState->propertiesRoot;
         for (uint32_t i = 0; iterator != NULL; i++) {
             properties[i] = iterator->property;
-            RaytmxPropertyNode* parent = iterator;
             iterator = iterator->next;
-            MemFree(parent);
         }
         /* Add the properties array to the element it applies to */
         /* A <property>, or rather its parent <properties>, can be within 10+ other elements. The order of the checks */
@@ -2252,11 +3909,11 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         /* Tiled will write out the value as characters contained inside the property element rather */
                         /* than as the value attribute." */
                         raytmxState->property->stringValue =
-                        (char*)MemAlloc((unsigned int)strlen(hoxmlContext->content) + 1);
+                        (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->content) + 1);
                         StringCopy(raytmxState->property->stringValue, hoxmlContext->content);
                     } else { /* If the string's value was neither provided as an attribute nor content */
                         /* The default value for 'string' is an empty string */
-                        raytmxState->property->stringValue = (char*)MemAlloc(1);
+                        raytmxState->property->stringValue = (char*)ArenaAlloc(raytmxState->arena, 1);
                         raytmxState->property->stringValue[0] = '\0';
                     }
                 } break;
@@ -2287,7 +3944,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 case PROPERTY_TYPE_FILE:
                 /* The default value for 'file' is "." */
                 if (raytmxState->property->stringValue == NULL) {
-                    raytmxState->property->stringValue = (char*)MemAlloc(2);
+                    raytmxState->property->stringValue = (char*)ArenaAlloc(raytmxState->arena, 2);
                     raytmxState->property->stringValue[0] = '.';
                     raytmxState->property->stringValue[1] = '\0';
                 } break;
@@ -2297,8 +3954,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (raytmxState->property->type != PROPERTY_TYPE_STRING &&
                 raytmxState->property->type != PROPERTY_TYPE_FILE && raytmxState->property->stringValue != NULL) {
                 /* Properties of types other than 'string' and 'file' are placed in 'stringValue' temporarily. Now */
-                /* that they have been cast and assigned appropriately, 'stringValue' can be freed. */
-                MemFree(raytmxState->property->stringValue);
+                /* that they have been cast and assigned appropriately, 'stringValue' can be dropped. */
                 raytmxState->property->stringValue = NULL;
             }
         }
@@ -2309,12 +3965,12 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (raytmxState->tileset->name == NULL) { /* If this <tileset> didn't have a 'name' attribute */
                 /* The default value for 'name' is "" (an empty string) */
-                raytmxState->tileset->name = (char*)MemAlloc(1);
+                raytmxState->tileset->name = (char*)ArenaAlloc(raytmxState->arena, 1);
                 raytmxState->tileset->name[0] = '\0';
             }
             if (raytmxState->tileset->classString == NULL) { /* If this <tileset> didn't have a 'class' attribute */
                 /* The default value for 'class' is "" (an empty string) */
-                raytmxState->tileset->classString = (char*)MemAlloc(1);
+                raytmxState->tileset->classString = (char*)ArenaAlloc(raytmxState->arena, 1);
                 raytmxState->tileset->classString[0] = '\0';
             }
             if (raytmxState->tileset->objectAlignment == OBJECT_ALIGNMENT_UNSPECIFIED) {
@@ -2327,15 +3983,13 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             
             if (raytmxState->tilesetTilesRoot != NULL) {
                 /* Allocate the array and zeroize every index as initialization */
-                TmxTilesetTile* tiles = (TmxTilesetTile*)MemAllocZero(sizeof(TmxTilesetTile) *
-                                                                      raytmxState->tilesetTilesLength);
-                /* Copy the TmxTilesetTile pointers into the array and free the nodes while we're at it */
+                TmxTilesetTile* tiles = (TmxTilesetTile*)ArenaAlloc(raytmxState->arena, sizeof(TmxTilesetTile) *
+                                                                    raytmxState->tilesetTilesLength);
+                /* Copy the TmxTilesetTile pointers into the array */
                 RaytmxTilesetTileNode* iterator = raytmxState->tilesetTilesRoot;
                 for (uint32_t i = 0; i < raytmxState->tilesetTilesLength && iterator != NULL; i++) {
                     tiles[i] = iterator->tile;
-                    RaytmxTilesetTileNode* parent = iterator;
                     iterator = iterator->next;
-                    MemFree(parent);
                 }
                 /* Add the tiles array to the tileset */
                 raytmxState->tileset->tiles = tiles;
@@ -2355,15 +4009,13 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (raytmxState->animationFramesRoot == NULL)
                 return;
             /* Allocate the array and zeroize every index as initialization */
-            TmxAnimationFrame* frames = (TmxAnimationFrame*)MemAllocZero(sizeof(TmxAnimationFrame) *
-                                                                         raytmxState->animationFramesLength);
-            /* Copy the TmxAnimationFrame pointers into the array and free the nodes while we're at it */
+            TmxAnimationFrame* frames = (TmxAnimationFrame*)ArenaAlloc(raytmxState->arena, sizeof(TmxAnimationFrame) *
+                                                                       raytmxState->animationFramesLength);
+            /* Copy the TmxAnimationFrame pointers into the array */
             RaytmxAnimationFrameNode* iterator = raytmxState->animationFramesRoot;
             for (uint32_t i = 0; iterator != NULL; i++) {
                 frames[i] = iterator->frame;
-                RaytmxAnimationFrameNode* parent = iterator;
                 iterator = iterator->next;
-                MemFree(parent);
             }
             /* Add the frames array to the tile's animation */
             raytmxState->tilesetTile->animation.frames = frames;
@@ -2382,32 +4034,30 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (raytmxState->layerTilesRoot != NULL && raytmxState->tileLayer->tiles != NULL) {
                 TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles "
                          "for this layer will be dropped", raytmxState->layer->name);
-                /* Free the nodes and tiles therein */
-                RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
-                while (iterator != NULL) {
-                    RaytmxTileLayerTileNode* parent = iterator;
-                    iterator = iterator->next;
-                    MemFree(parent);
-                }
-            } else {
+                /* The nodes were allocated from the scratch arena and are simply abandoned */
+            } else if (raytmxState->layerTilesRoot != NULL) { /* If tiles weren't decoded directly into an array */
                 /* Allocate the array and zeroize every index as initialization */
-                uint32_t* tiles = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GID into the array and free the nodes while we're at it */
+                uint32_t* tiles =
+                (uint32_t*)ArenaAlloc(raytmxState->arena, sizeof(uint32_t) * raytmxState->layerTilesLength);
+                /* Copy the GID into the array */
                 RaytmxTileLayerTileNode* iterator = raytmxState->layerTilesRoot;
                 for (uint32_t i = 0;  iterator != NULL; i++) {
                     tiles[i] = iterator->gid;
-                    RaytmxTileLayerTileNode* parent = iterator;
                     iterator = iterator->next;
-                    MemFree(parent);
                 }
                 /* Add the tiles array to the tile layer */
                 raytmxState->tileLayer->tiles = tiles;
                 raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
             }
+            if (raytmxState->tileChunksRoot != NULL) /* If the layer is made of chunks, as those of infinite maps are */
+                BuildTileChunks(raytmxState);
             /* Clean up the state object */
             raytmxState->layerTilesRoot = NULL;
             raytmxState->layerTilesTail = NULL;
             raytmxState->layerTilesLength = 0;
+            raytmxState->tileChunksRoot = NULL;
+            raytmxState->tileChunksTail = NULL;
+            raytmxState->tileChunksLength = 0;
         }
         raytmxState->tileLayer = NULL;
         raytmxState->layer = NULL;
@@ -2417,7 +4067,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (raytmxState->tilesetTile->classString == NULL) { /* If this <tile> didn't have a 'class' attribute */
                 /* The default value for 'class' is "" (an empty string) */
-                raytmxState->tilesetTile->classString = (char*)MemAlloc(1);
+                raytmxState->tilesetTile->classString = (char*)ArenaAlloc(raytmxState->arena, 1);
                 raytmxState->tilesetTile->classString[0] = '\0';
             }
             if (raytmxState->tilesetTile->hasImage) {
@@ -2430,138 +4080,88 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             raytmxState->tilesetTile = NULL;
         }
     } /* strcmp(hoxmlContext->tag, "tile") == 0 */
+    else if (strcmp(hoxmlContext->tag, "chunk") == 0) {
+        if (raytmxState->tileChunk != NULL) {
+            if (raytmxState->tileLayer->encoding == NULL) {
+                TraceLog(LOG_WARNING, "RAYTMX: Layer \"%s\" has a chunk of unencoded tiles, which is unsupported - "
+                         "the chunk will be empty", raytmxState->layer->name);
+                raytmxState->layerTilesRoot = NULL; /* The nodes were allocated from the scratch arena */
+                raytmxState->layerTilesTail = NULL;
+                raytmxState->layerTilesLength = 0;
+            } else {
+                /* Keep the encoded tiles, without surrounding whitespace, so the chunk can be decoded when needed */
+                const char *contentStart = hoxmlContext->content != NULL ? hoxmlContext->content : "", *contentEnd;
+                while (isspace(*contentStart))
+                    contentStart++;
+                contentEnd = contentStart + strlen(contentStart);
+                while (contentEnd > contentStart && isspace(*(contentEnd - 1)))
+                    contentEnd--;
+                size_t contentLength = (size_t)(contentEnd - contentStart);
+                raytmxState->tileChunk->data = (char*)ArenaAlloc(raytmxState->arena, contentLength + 1);
+                memcpy(raytmxState->tileChunk->data, contentStart, contentLength);
+                raytmxState->tileChunk->data[contentLength] = '\0';
+            }
+            raytmxState->tileChunk = NULL;
+        }
+    } /* strcmp(hoxmlContext->tag, "chunk") == 0 */
     else if (strcmp(hoxmlContext->tag, "data") == 0) {
         if (raytmxState->image != NULL) {
             /* TODO (?): The TMX map format documentation says an <image> can contain a <data> element but doesn't */
             /* provide any more information than that. Tiled doesn't seem to have a feature for this either. */
+        } else if (raytmxState->tileChunksRoot != NULL) {
+            /* The tiles were within <chunk> elements, each one's kept as-is until it's needed */
         } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->tiles != NULL) {
             TraceLog(LOG_WARNING, "RAYTMX: layer \"%s\" has more than one source of tile data - the latter tiles for "
                      "this layer will be dropped", raytmxState->layer->name);
         } else if (raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL) {
-            RaytmxTileLayerTileNode* tiles = NULL;
+            /* The <layer>'s 'width' and 'height' attributes precede its <data> so the number of tiles is known ahead */
+            /* of time. When it is, GIDs are decoded straight into the layer's array. Otherwise, the linked list of */
+            /* tiles is used and converted into an array when the <layer> ends. */
+            uint32_t tilesCapacity = raytmxState->tileLayer->width * raytmxState->tileLayer->height;
+            if (tilesCapacity > 0) {
+                raytmxState->tileLayer->tiles = (uint32_t*)ArenaAlloc(raytmxState->arena,
+                                                                      sizeof(uint32_t) * tilesCapacity);
+                raytmxState->tileLayer->tilesLength = tilesCapacity;
+            }
+            uint32_t tilesDecoded = 0;
+            
             if (strcmp(raytmxState->tileLayer->encoding, "base64") == 0) {
-                /* The layer's data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML */
-                /* considers everything between <data> and </data> to be content meaning there is probably some */
-                /* whitespace on both ends of the content we need to ignore. So, find the actual start and stop: */
-                char *encodedStart = hoxmlContext->content, *encodedEnd;
-                while (isspace(*encodedStart))
-                    encodedStart++;
-                encodedEnd = encodedStart + strlen(encodedStart) - 1;
-                while (encodedEnd > encodedStart && isspace(*encodedEnd))
-                    encodedEnd--;
-                
-                /* With the string of encoded Base64 data trimmed, decode it */
-                int decodedLength;
-                unsigned char* decoded = DecodeDataBase64((const unsigned char*)encodedStart, &decodedLength);
-                if (decoded != NULL) {
-                    if (raytmxState->tileLayer->compression == NULL) { /* If the Base64-encoded data is uncompressed */
-                        /* Iterate through N bytes ('decodedLength') with every four bytes being a single GID */
-                        /* resulting in N / 4 tiles */
-                        uint32_t* iterator = (uint32_t*)decoded;
-                        for (int i = 0; i < decodedLength / 4; i++) {
-                            AddTileLayerTile(raytmxState, *iterator);
-                            iterator += 1; /* Point to the next unsigned, 32-bit integer in the decoded data */
-                        }
-                    } else { /* If the Base-64encoded data is also compressed */
-                        if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0 ||
-                            strcmp(raytmxState->tileLayer->compression, "zlib") == 0) {
-                            unsigned char* postHeaderDecoded = NULL;
-                            if (strcmp(raytmxState->tileLayer->compression, "gzip") == 0) {
-                                /* The first two bytes of a GZIP header are expected to be a magic number, 0x1F8B, */
-                                /* identifying the format and the third is expected to indicate the compression */
-                                /* method where 0x08 is DEFLATE. */
-                                /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x1F && decoded[1] == 0x8B && decoded[2] == 0x08) {
-                                    /* Skip past the GZIP header. The header is typically ten bytes. The bytes not */
-                                    /* checked are unimportant things like a timestamp and OS ID. Additional optional */
-                                    /* headers are possible but not used by Tiled so they are assumed to be missing. */
-                                    postHeaderDecoded = decoded + 10;
-                                } else { /* If the GZIP header doesn't match a decompressable one */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses GZIP compression but the stream's "
-                                             "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
-                                }
-                            } else /* if (strcmp(raytmxState->tileLayer->compression, "zlib") == 0) */ {
-                                /* The first byte of a ZLIB header is expected to be 0x78 where the 8 indicates the */
-                                /* DEFLATE compression method and the 7 is "compression info" that indicates a 32K */
-                                /* LZ77 window size and, in practice, cannot be anything else. */
-                                /* If these values are found, decompression can continue */
-                                if (decoded[0] == 0x78) {
-                                    /* Skip past the ZLIB header. The header is two bytes. */
-                                    postHeaderDecoded = decoded + 2;
-                                } else { /* If the ZLIB header doesn't match a decompressable one */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses ZLIB compression but the stream's "
-                                             "header doesn't indicate DEFLATE compression", raytmxState->layer->name);
-                                }
-                            }
-                            
-                            if (postHeaderDecoded != NULL) {
-                                /* "zlib" and "gzip" both use the DEFLATE algorithm and raylib provides a */
-                                /* decompression function when it's built with SUPPORT_COMPRESSION_API (default) */
-                                int decompressedLength;
-                                unsigned char* decompressed = DecompressData(postHeaderDecoded, decodedLength,
-                                                                             &decompressedLength);
-                                if (decompressed != NULL && decompressedLength > 0) {
-                                    uint32_t* iterator = (uint32_t*)decompressed;
-                                    for (int i = 0; i < decompressedLength / 4; i++) {
-                                        AddTileLayerTile(raytmxState, *iterator);
-                                        iterator += 1; /* Point to the next unsigned integer in the decompressed data */
-                                    }
-                                    MemFree(decompressed); /* Free the memory allocated by DecompressData() */
-                                } else { /* raylib wasn't built with compression or allocation failed */
-                                    TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed "
-                                             "because DEFLATE decompression failed - either raylib was not built with "
-                                             "SUPPORT_COMPRESSION_API or memory allocation failed", raytmxState->layer->name,
-                                             raytmxState->tileLayer->compression);
-                                }
-                            }
-                        } else {
-                            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method "
-                                     "\"%s\" is unsupported", raytmxState->layer->name, raytmxState->tileLayer->compression);
-                        }
-                    }
-                    MemFree(decoded); /* Free the memory allocated by DecodeDataBase64() */
-                } else {
-                    TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"",
-                             raytmxState->layer->name);
+                int dataLength;
+                unsigned char* data = DecodeTileData(raytmxState->layer->name, hoxmlContext->content,
+                                                     raytmxState->tileLayer->compression, &dataLength);
+                if (data != NULL) {
+                    /* Every four bytes of the N decoded bytes ('dataLength') are a single GID */
+                    tilesDecoded = AddTileLayerGids(raytmxState, data, dataLength);
+                    MemFree(data);
                 }
             } /* strcmp(raytmxState->tileLayer->encoding, "base64") == 0 */
             else if (strcmp(raytmxState->tileLayer->encoding, "csv") == 0) {
                 /* The Comma-Separated Value (CSV) list herein is a series of Global IDs (GIDs) of tiles in the form */
-                /* "31,32,33" where 31, 32, and 33 are GIDs */
-                char valueAsString[16]; /* Needs to fit all digits of a single value - should be more than enough */
-                char* iterator = hoxmlContext->content;
+                /* "31,32,33" where 31, 32, and 33 are GIDs. Tiled also places a newline after each row. Digits are */
+                /* accumulated in place, unsigned, because GIDs with flip flags exceed the range of a signed int. */
+                const char* iterator = hoxmlContext->content;
                 while (iterator != NULL && *iterator != '\0') { /* While not pointing to the end of the string */
-                    memset(valueAsString, '\0', 16); /* Reset the value-as-a-string buffer with all zeroes */
-                    /* Copy each character into the buffer until either a comma or the terminator is reached */
-                    for (int i = 0; *iterator != ',' && *iterator != '\0'; i++) {
-                        memcpy(valueAsString + i, iterator, 1);
+                    if (*iterator < '0' || *iterator > '9') { /* Skip over commas and whitespace */
+                        iterator++;
+                        continue;
+                    }
+                    uint32_t gid = 0;
+                    while (*iterator >= '0' && *iterator <= '9') {
+                        gid = (gid * 10) + (uint32_t)(*iterator - '0');
                         iterator++;
                     }
-                    if (*iterator == ',') /* If iteration was paused by a comma */
-                        iterator++; /* Advance one character so the comma isn't parsed with the value next iteration */
-                    AddTileLayerTile(raytmxState, atoi(valueAsString)); /* Read the value as an integer GID */
+                    if (tilesCapacity == 0)
+                        AddTileLayerTile(raytmxState, gid);
+                    else if (tilesDecoded < tilesCapacity)
+                        raytmxState->tileLayer->tiles[tilesDecoded] = gid;
+                    tilesDecoded++;
                 }
             } /* strcmp(raytmxState->tileLayer->encoding, "csv") == 0 */
             
-            if (tiles != NULL) { /* If there was no error in parsing the data and there's a linked list of tiles */
-                /* Allocate the array and assign 0 to every index to be safe */
-                uint32_t* tiles = (uint32_t*)MemAlloc(sizeof(uint32_t) * raytmxState->layerTilesLength);
-                memset(tiles, 0, sizeof(uint32_t) * raytmxState->layerTilesLength);
-                /* Copy the GIDs into the array and free the nodes while we're at it */
-                RaytmxTileLayerTileNode* layerTilesIterator = raytmxState->layerTilesRoot;
-                for (uint32_t i = 0; i < raytmxState->layerTilesLength && layerTilesIterator != NULL; i++) {
-                    tiles[i] = layerTilesIterator->gid;
-                    RaytmxTileLayerTileNode* layerTilesTemp = layerTilesIterator;
-                    layerTilesIterator = layerTilesIterator->next;
-                    MemFree(layerTilesTemp);
-                }
-                /* Add the tiles array to the element it applies to */
-                raytmxState->tileLayer->tiles = tiles;
-                raytmxState->tileLayer->tilesLength = raytmxState->layerTilesLength;
-                /* Clean up the state object */
-                raytmxState->layerTilesRoot = NULL;
-                raytmxState->layerTilesTail = NULL;
-                raytmxState->layerTilesLength = 0;
+            if (tilesCapacity > 0 && tilesDecoded != tilesCapacity) {
+                TraceLog(LOG_WARNING, "RAYTMX: Layer \"%s\" has %u tiles but its dimensions call for %u - missing tiles "
+                         "will be empty and extra tiles will be dropped", raytmxState->layer->name, tilesDecoded,
+                         tilesCapacity);
             }
         } /* raytmxState->tileLayer != NULL && raytmxState->tileLayer->encoding != NULL */
     } /* strcmp(hoxmlContext->tag, "data") == 0 */
@@ -2570,48 +4170,49 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             if (raytmxState->objectsRoot == NULL)
                 return;
             /* Allocate the arrays and zeroize every index as initialization */
-            TmxObject* objects = (TmxObject*)MemAllocZero(sizeof(TmxObject) * raytmxState->objectsLength);
-            uint32_t* ySortedObjects = (uint32_t*)MemAllocZero(sizeof(uint32_t) * raytmxState->objectsLength);
-            /* Create a contiguous array of TmxObjects, create a sorted linked list of indexes within that array of */
-            /* TmxObjects (sorted by ascending y-coordinate), and free the object linked list */
-            RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot, *objectsTemp;
-            RaytmxObjectSortingNode *sortingRoot = NULL, *sortingIterator, *sortingTemp, *newSortingNode;
+            TmxObject* objects =
+            (TmxObject*)ArenaAlloc(raytmxState->arena, sizeof(TmxObject) * raytmxState->objectsLength);
+            uint32_t* ySortedObjects =
+            (uint32_t*)ArenaAlloc(raytmxState->arena, sizeof(uint32_t) * raytmxState->objectsLength);
+            /* Create a contiguous array of TmxObjects along with a key, per object, to sort them by */
+            RaytmxObjectSortKey* sortKeys =
+            (RaytmxObjectSortKey*)MemAlloc((unsigned int)(sizeof(RaytmxObjectSortKey) * raytmxState->objectsLength));
+            RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot;
             for (uint32_t i = 0; objectsIterator != NULL; i++) {
                 objects[i] = objectsIterator->object;
-                /* Add a new node into the sorted list */
-                newSortingNode = (RaytmxObjectSortingNode*)MemAllocZero(sizeof(RaytmxObjectSortingNode));
-                newSortingNode->y = objects[i].y;
-                newSortingNode->index = i;
-                if (sortingRoot == NULL) /* If this is the first node */
-                    sortingRoot = newSortingNode;
-                else if (sortingRoot->y >= newSortingNode->y) { /* If replacing the root node */
-                    newSortingNode->next = sortingRoot;
-                    sortingRoot = newSortingNode;
-                } else { /* If inserting at some location after the root */
-                    sortingIterator = sortingRoot;
-                    while (sortingIterator->next != NULL && newSortingNode->y > sortingIterator->next->y)
-                        sortingIterator = sortingIterator->next;
-                    newSortingNode->next = sortingIterator->next;
-                    sortingIterator->next = newSortingNode;
+                if (sortKeys != NULL) {
+                    sortKeys[i].y = objects[i].y;
+                    sortKeys[i].index = i;
                 }
-                /* Free the object node */
-                objectsTemp = objectsIterator;
                 objectsIterator = objectsIterator->next;
-                MemFree(objectsTemp);
             }
-            /* Create a contiguous array from the sorted linked list such that index 0 of this array points to the */
-            /* TmxObject (via its index in 'objects') with the lowest (visually, highest) y-coordinate */
-            sortingIterator = sortingRoot;
-            for (uint32_t i = 0; sortingIterator != NULL; i++) {
-                ySortedObjects[i] = sortingIterator->index;
-                sortingTemp = sortingIterator;
-                sortingIterator = sortingIterator->next;
-                MemFree(sortingTemp);
+            /* Sort by ascending y-coordinate such that index 0 of ySortedObjects points to the TmxObject (via its */
+            /* index in 'objects') with the lowest (visually, highest) y-coordinate. Keys include the index so objects */
+            /* sharing a y-coordinate keep their document order, making the sort stable despite qsort() not being. */
+            if (sortKeys != NULL) {
+                qsort(sortKeys, raytmxState->objectsLength, sizeof(RaytmxObjectSortKey), CompareObjectSortKeys);
+                for (uint32_t i = 0; i < raytmxState->objectsLength; i++)
+                    ySortedObjects[i] = sortKeys[i].index;
+                MemFree(sortKeys);
+            } else { /* Without memory to sort with, fall back to document order */
+                for (uint32_t i = 0; i < raytmxState->objectsLength; i++)
+                    ySortedObjects[i] = i;
             }
             /* Add the objects and ySortedObjects array to the object layer */
             raytmxState->objectGroup->objects = objects;
             raytmxState->objectGroup->objectsLength = raytmxState->objectsLength;
             raytmxState->objectGroup->ySortedObjects = ySortedObjects;
+            /* Object layers get a spatial grid for broad collision queries. Cells span a few tiles each. */
+            if (raytmxState->tilesetTile == NULL) {
+                float cellWidth = (float)(raytmxState->mapTileWidth * TMX_GRID_CELL_TILES),
+                    cellHeight = (float)(raytmxState->mapTileHeight * TMX_GRID_CELL_TILES);
+                raytmxState->objectGroup->grid = BuildObjectGroupGrid(raytmxState->arena, raytmxState->objectGroup,
+                                                                      cellWidth, cellHeight);
+                raytmxState->objectGroup->bounds = BuildObjectGroupBounds(raytmxState->arena,
+                                                                          raytmxState->objectGroup);
+                if (raytmxState->objectGroup->objectsLength >= TMX_BVH_MIN_OBJECTS)
+                    raytmxState->objectGroup->bvh = BuildObjectGroupBvh(raytmxState->arena, raytmxState->objectGroup);
+            }
             /* Clean up the state object */
             raytmxState->objectsRoot = NULL;
             raytmxState->objectsTail = NULL;
@@ -2624,12 +4225,12 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             /* Apply default values for the attribute(s) that aren't covered by a simple memset(x, 0, sizeof(x)) */
             if (raytmxState->object->name == NULL) { /* If this <object> didn't have a 'name' attribute */
                 /* The default value for 'name' is "" (an empty string) */
-                raytmxState->object->name = (char*)MemAlloc(1);
+                raytmxState->object->name = (char*)ArenaAlloc(raytmxState->arena, 1);
                 raytmxState->object->name[0] = '\0';
             }
             if (raytmxState->object->typeString == NULL) { /* If this <object> didn't have a 'type' attribute */
                 /* The default value for 'type' is "" (an empty string) */
-                raytmxState->object->typeString = (char*)MemAlloc(1);
+                raytmxState->object->typeString = (char*)ArenaAlloc(raytmxState->arena, 1);
                 raytmxState->object->typeString[0] = '\0';
             }
             
@@ -2649,12 +4250,12 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                     /* <properties> and they need to be applied to the instanced <object> where none exist. */
                     if (objectTemplate.object.name != NULL && raytmxState->object->name == NULL) {
                         raytmxState->object->name =
-                        (char*)MemAllocZero((unsigned int)strlen(objectTemplate.object.name) + 1);
+                        (char*)ArenaAlloc(raytmxState->arena, strlen(objectTemplate.object.name) + 1);
                         StringCopy(raytmxState->object->name, objectTemplate.object.name);
                     }
                     if (objectTemplate.object.typeString != NULL && raytmxState->object->typeString != NULL) {
                         raytmxState->object->typeString =
-                        (char*)MemAllocZero((unsigned int)strlen(objectTemplate.object.typeString) + 1);
+                        (char*)ArenaAlloc(raytmxState->arena, strlen(objectTemplate.object.typeString) + 1);
                         StringCopy(raytmxState->object->typeString, objectTemplate.object.typeString);
                     }
                     if (objectTemplate.object.x != 0.0 && raytmxState->object->x == 0.0)
@@ -2691,7 +4292,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                             uint32_t propertiesLength = 0;
                             /* Add the properties from the instanced <object> */
                             for (uint32_t i = 0; i < raytmxState->object->propertiesLength; i++) {
-                                node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+                                node =
+                                (RaytmxPropertyNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxPropertyNode));
                                 node->property = raytmxState->object->properties[i];
                                 if (propertiesRoot == NULL)
                                     propertiesRoot = node;
@@ -2713,7 +4315,8 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                     propertiesIterator = propertiesIterator->next;
                                 }
                                 if (isNew) {
-                                    node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+                                    node =
+                                    (RaytmxPropertyNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxPropertyNode));
                                     node->property = objectTemplate.object.properties[i];
                                     if (propertiesRoot == NULL)
                                         propertiesRoot = node;
@@ -2723,19 +4326,15 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                     propertiesLength += 1;
                                 }
                             }
-                            /* Free the separate array that was previously allocated */
-                            MemFree(raytmxState->object->properties);
                             /* Allocate a new array to be populated with the merged properties */
                             raytmxState->object->properties =
-                            (TmxProperty*)MemAllocZero(sizeof(TmxProperty) * propertiesLength);
+                            (TmxProperty*)ArenaAlloc(raytmxState->arena, sizeof(TmxProperty) * propertiesLength);
                             raytmxState->object->propertiesLength = propertiesLength;
-                            /* Copy the TmxProperty entires into the array and free the nodes while we're at it */
+                            /* Copy the TmxProperty entires into the array */
                             RaytmxPropertyNode* propertiesIterator = propertiesRoot;
                             for (uint32_t i = 0; propertiesIterator != NULL; i++) {
                                 raytmxState->object->properties[i] = propertiesIterator->property;
-                                RaytmxPropertyNode* propertiesTemp = propertiesIterator;
                                 propertiesIterator = propertiesIterator->next;
-                                MemFree(propertiesTemp);
                             }
                         }
                     }
@@ -2801,13 +4400,13 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
             TmxObject* object = raytmxState->object;
             TmxText* objectText = object->text;
             if (hoxmlContext->content != NULL) { /* If the element had content e.g. <text>Content here</text> */
-                objectText->content = (char*)MemAllocZero((unsigned int)strlen(hoxmlContext->content) + 1);
+                objectText->content = (char*)ArenaAlloc(raytmxState->arena, strlen(hoxmlContext->content) + 1);
                 StringCopy(objectText->content, hoxmlContext->content);
             }
             
             if (objectText->fontFamily == NULL) { /* If this <text> didn't have a 'fontfamily' attribute */
                 /* The default value for 'fontfamily' is "sans-serif" */
-                objectText->fontFamily = (char*)MemAllocZero((unsigned int)strlen("sans-serif") + 1);
+                objectText->fontFamily = (char*)ArenaAlloc(raytmxState->arena, strlen("sans-serif") + 1);
                 StringCopy(objectText->fontFamily, "sans-serif");
             }
             
@@ -2894,13 +4493,14 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         end = start;
                         
                         TmxTextLine line;
-                        line.content = (char*)MemAllocZero((unsigned int)strlen(sourceBuffer) + 1);
+                        line.content = (char*)ArenaAlloc(raytmxState->arena, strlen(sourceBuffer) + 1);
                         StringCopy(line.content, sourceBuffer);
                         line.font = font;
                         line.spacing = spacing;
                         /* Note: The number of lines is not yet known but needs to be for Y positioning */
                         
-                        RaytmxTextLineNode* node = (RaytmxTextLineNode*)MemAllocZero(sizeof(RaytmxTextLineNode));
+                        RaytmxTextLineNode* node =
+                        (RaytmxTextLineNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxTextLineNode));
                         node->line = line;
                         if (linesRoot == NULL)
                             linesRoot = node;
@@ -2930,8 +4530,9 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                 
                 if (linesRoot != NULL) {
                     /* Allocate the array and zero out every value as initialization */
-                    TmxTextLine* lines = (TmxTextLine*)MemAllocZero(sizeof(TmxTextLine) * linesLength);
-                    /* Copy the TmxTextLines into the array and free the nodes while we're at it */
+                    TmxTextLine* lines =
+                    (TmxTextLine*)ArenaAlloc(raytmxState->arena, sizeof(TmxTextLine) * linesLength);
+                    /* Copy the TmxTextLines into the array */
                     RaytmxTextLineNode* iterator = linesRoot;
                     for (uint32_t i = 0; i < linesLength && iterator != NULL; i++) {
                         lines[i] = iterator->line;
@@ -2968,7 +4569,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                 (uint32_t)floor((idealNumAdditionalSpaces - (float)numSpaces) / (float)numSpaces);
                                 /* Create a new string with the additional space */
                                 size_t justifiedLength = length + (numSpacesToAddPer * numSpaces);
-                                char* justifiedContent = (char*)MemAllocZero((unsigned int)justifiedLength + 1);
+                                char* justifiedContent = (char*)ArenaAlloc(raytmxState->arena, justifiedLength + 1);
                                 uint32_t sourceIndex = 0, destinationIndex = 0;
                                 while (lines[i].content[sourceIndex] != '\0') {
                                     justifiedContent[destinationIndex++] = lines[i].content[sourceIndex];
@@ -2981,8 +4582,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                                     }
                                     sourceIndex++;
                                 }
-                                /* Free the original content buffer and replace it with the justified one */
-                                MemFree(lines[i].content);
+                                /* Replace the original content buffer with the justified one */
                                 lines[i].content = justifiedContent;
                                 length = justifiedLength;
                             }
@@ -3007,9 +4607,7 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
                         } else /* if (objectText->valign == VERTICAL_ALIGNMENT_TOP) */
                             lines[i].position.y = (float)object->y + (float)(objectText->pixelSize * i);
                         
-                        RaytmxTextLineNode* parent = iterator;
                         iterator = iterator->next;
-                        MemFree(parent);
                     }
                     /* Add the lines array to the text object */
                     objectText->lines = lines;
@@ -3028,42 +4626,15 @@ void HandleElementEnd(RaytmxState* raytmxState, hoxml_context_t* hoxmlContext) {
     }
 }
 
-void FreeStateLayers(RaytmxLayerNode* layers) {
-    RaytmxLayerNode *layersIterator = layers, *layersTemp;
-    while (layersIterator != NULL) {
-        /* Group layers may have children, forming a tree-like structure. Free the children. */
-        FreeStateLayers(layersIterator->childrenRoot);
-        /* Iterate to the next node and free this one */
-        layersTemp = layersIterator;
-        layersIterator = layersIterator->next;
-        MemFree(layersTemp);
-    }
-}
-
 void FreeState(RaytmxState* raytmxState) {
     if (raytmxState == NULL)
         return;
     
-    /* Clear the caches. These allow for quick lookups of previously-loaded textures and object templates. They */
-    /* aren't needed once loading is complete. */
-    RaytmxCachedTextureNode *cachedTextureIterator = raytmxState->texturesRoot, *cachedTextureTemp;
-    while (cachedTextureIterator != NULL) {
-        cachedTextureTemp = cachedTextureIterator;
-        cachedTextureIterator = cachedTextureIterator->next;
-        if (cachedTextureTemp->fileName != NULL) /* Just in case. Should always be set. */
-            MemFree(cachedTextureTemp->fileName);
-        MemFree(cachedTextureTemp);
-    }
-    raytmxState->texturesRoot = NULL;
-    RaytmxCachedTemplateNode *cachedTemplateIterator = raytmxState->templatesRoot, *cachedTemplateTemp;
-    while (cachedTemplateIterator != NULL) {
-        cachedTemplateTemp = cachedTemplateIterator;
-        cachedTemplateIterator = cachedTemplateIterator->next;
-        FreeObject(cachedTemplateTemp->objectTemplate.object);
-        if (cachedTemplateTemp->fileName != NULL) /* Just in case. Should always be set. */
-            MemFree(cachedTemplateTemp->fileName);
-        MemFree(cachedTemplateTemp);
-    }
+    /* Every linked list node, including those of the template cache, was allocated from the scratch arena so */
+    /* they're all released at once. The cache allows for quick lookups of previously-loaded object templates but */
+    /* isn't needed once loading is complete. Textures are cached process-wide instead, see LoadTextureTMX(). */
+    FreeArena(raytmxState->scratch);
+    raytmxState->scratch = NULL;
     raytmxState->templatesRoot = NULL;
     
     raytmxState->property = NULL;
@@ -3075,175 +4646,170 @@ void FreeState(RaytmxState* raytmxState) {
     /* raytmxState->wangColor = NULL; */ /* TODO:  Wang sets. Low priority. */
     raytmxState->layer = NULL;
     raytmxState->tileLayer = NULL;
+    raytmxState->tileChunk = NULL;
     raytmxState->objectGroup = NULL;
     raytmxState->imageLayer = NULL;
     raytmxState->object = NULL;
     
-    /* Free each property in the linked list of properties */
-    RaytmxPropertyNode *propertiesIterator = raytmxState->propertiesRoot, *propertiesTemp;
-    while (propertiesIterator != NULL) {
-        propertiesTemp = propertiesIterator;
-        propertiesIterator = propertiesIterator->next;
-        MemFree(propertiesTemp);
-    }
-    /* Zeroize this linked list's properties */
+    /* Zeroize the linked lists' properties */
     raytmxState->propertiesRoot = NULL;
     raytmxState->propertiesTail = NULL;
     raytmxState->propertiesLength = 0;
-    
-    /* Free each node in the linked list of tilesets */
-    RaytmxTilesetNode *tilesetsIterator = raytmxState->tilesetsRoot, *tilesetsTemp;
-    while (tilesetsIterator != NULL) {
-        tilesetsTemp = tilesetsIterator;
-        tilesetsIterator = tilesetsIterator->next;
-        MemFree(tilesetsTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->tilesetsRoot = NULL;
     raytmxState->tilesetsTail = NULL;
     raytmxState->tilesetsLength = 0;
-    
-    /* Free each node in the linked list of tileset tiles */
-    RaytmxTilesetTileNode *tilesetTilesIterator = raytmxState->tilesetTilesRoot, *tilesetTilesTemp;
-    while (tilesetTilesIterator != NULL) {
-        tilesetTilesTemp = tilesetTilesIterator;
-        tilesetTilesIterator = tilesetTilesIterator->next;
-        MemFree(tilesetTilesTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->tilesetTilesRoot = NULL;
     raytmxState->tilesetTilesTail = NULL;
     raytmxState->tilesetTilesLength = 0;
-    
-    /* Free each node in the linked list of animation frames */
-    RaytmxAnimationFrameNode *animationFramesIterator = raytmxState->animationFramesRoot, *animationFramesTemp;
-    while (animationFramesIterator != NULL) {
-        animationFramesTemp = animationFramesIterator;
-        animationFramesIterator = animationFramesIterator->next;
-        MemFree(animationFramesTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->animationFramesRoot = NULL;
     raytmxState->animationFramesTail = NULL;
     raytmxState->animationFramesLength = 0;
-    
-    /* Layers may be groups. The resulting collection isn't a link list as much as it is a tree. So freeing layers is */
-    /* best done with a recursive approach. */
-    FreeStateLayers(raytmxState->layersRoot);
-    /* Zeroize this linked list's properties */
     raytmxState->layersRoot = NULL;
     raytmxState->layersTail = NULL;
     raytmxState->layersLength = 0;
-    
-    /* Free each node in the linked list of layer tiles */
-    RaytmxTileLayerTileNode *layerTilesIterator = raytmxState->layerTilesRoot, *layerTilesTemp;
-    while (layerTilesIterator != NULL) {
-        layerTilesTemp = layerTilesIterator;
-        layerTilesIterator = layerTilesIterator->next;
-        MemFree(layerTilesTemp);
-    }
-    /* Zeroize this linked list's properties */
     raytmxState->layerTilesRoot = NULL;
     raytmxState->layerTilesTail = NULL;
     raytmxState->layerTilesLength = 0;
-    
-    /* Free each node in the linked list of objects */
-    RaytmxObjectNode *objectsIterator = raytmxState->objectsRoot, *objectsTemp;
-    while (objectsIterator != NULL) {
-        objectsTemp = objectsIterator;
-        objectsIterator = objectsIterator->next;
-        MemFree(objectsTemp);
-    }
-    /* Zeroize this linked list's properties */
+    raytmxState->tileChunksRoot = NULL;
+    raytmxState->tileChunksTail = NULL;
+    raytmxState->tileChunksLength = 0;
     raytmxState->objectsRoot = NULL;
     raytmxState->objectsTail = NULL;
     raytmxState->objectsLength = 0;
 }
 
-void inline FreeString(char* str) {
-    if (str != NULL)
-        MemFree(str);
+void UnloadTilesetTextures(TmxTileset tileset) {
+    if (tileset.hasImage)
+        UnloadTextureTMX(tileset.image.texture);
+    for (uint32_t i = 0; i < tileset.tilesLength; i++) {
+        if (tileset.tiles[i].hasImage)
+            UnloadTextureTMX(tileset.tiles[i].image.texture);
+    }
 }
 
-void FreeTileset(TmxTileset tileset) {
-    FreeString(tileset.source);
-    FreeString(tileset.name);
-    FreeString(tileset.classString);
-    if (tileset.hasImage) {
-        FreeString(tileset.image.source);
-        UnloadTexture(tileset.image.texture);
-    }
-    if (tileset.properties != NULL) {
-        for (uint32_t i = 0; i < tileset.propertiesLength; i++)
-            FreeProperty(tileset.properties[i]);
-        MemFree(tileset.properties);
-    }
-    for (uint32_t i = 0; i < tileset.tilesLength; i++) {
-        TmxTilesetTile tile = tileset.tiles[i];
-        FreeString(tile.classString);
-        if (tile.hasImage) {
-            FreeString(tile.image.source);
-            UnloadTexture(tile.image.texture);
-            if (tile.properties != NULL) {
-                for (uint32_t j = 0; j < tile.propertiesLength; j++)
-                    FreeProperty(tile.properties[j]);
-                MemFree(tile.properties);
+void UnloadLayerTextures(TmxLayer layer) {
+    if (layer.type == LAYER_TYPE_IMAGE_LAYER && layer.exact.imageLayer.hasImage)
+        UnloadTextureTMX(layer.exact.imageLayer.image.texture);
+    /* <group> layers are expected to have child layers, or child <group>s, so recursively unload them too */
+    for (uint32_t i = 0; i < layer.layersLength; i++)
+        UnloadLayerTextures(layer.layers[i]);
+}
+
+void UnloadLayerChunks(TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+        if (layers[i].type == LAYER_TYPE_TILE_LAYER) {
+            for (uint32_t j = 0; j < tileLayer->chunksLength; j++) {
+                if (tileLayer->chunks[j].tiles != NULL)
+                    MemFree(tileLayer->chunks[j].tiles);
+                tileLayer->chunks[j].tiles = NULL;
             }
         }
-        if (tile.animation.frames != NULL)
-            MemFree(tile.animation.frames);
+        /* <group> layers are expected to have child layers, or child <group>s, so recursively unload them too */
+        UnloadLayerChunks(layers[i].layers, layers[i].layersLength);
     }
 }
 
-void FreeProperty(TmxProperty property) {
-    FreeString(property.name);
-    FreeString(property.stringValue);
+void UpdateLayerChunkResidency(const TmxMap* map, TmxLayer* layers, uint32_t layersLength, Vector2 target,
+                               uint32_t radius) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        const TmxLayer* layer = &layers[i];
+        TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+        if (layer->type == LAYER_TYPE_GROUP) {
+            /* Children's offsets are relative to their group's */
+            Vector2 childTarget = target;
+            childTarget.x -= (float)layer->offsetX;
+            childTarget.y -= (float)layer->offsetY;
+            UpdateLayerChunkResidency(map, layers[i].layers, layers[i].layersLength, childTarget, radius);
+            continue;
+        }
+        if (layer->type != LAYER_TYPE_TILE_LAYER || tileLayer->chunksLength == 0)
+            continue;
+        
+        /* The chunk containing the target, which may be outside of the layer's bounds, and the chunks around it */
+        int tileX = (int)floorf((target.x - (float)layer->offsetX) / (float)map->tileWidth);
+        int tileY = (int)floorf((target.y - (float)layer->offsetY) / (float)map->tileHeight);
+        int chunkX = FloorDivi(tileX, (int)tileLayer->chunkWidth);
+        int chunkY = FloorDivi(tileY, (int)tileLayer->chunkHeight);
+        int32_t minX = chunkX - (int32_t)radius, minY = chunkY - (int32_t)radius;
+        int32_t maxX = chunkX + (int32_t)radius, maxY = chunkY + (int32_t)radius;
+        
+        /* Evict the chunks made resident last time that are now too far away. Only the previous window needs to be */
+        /* checked so this costs the same however many chunks the layer has. */
+        for (int32_t y = tileLayer->residentMinY; y <= tileLayer->residentMaxY; y++) {
+            for (int32_t x = tileLayer->residentMinX; x <= tileLayer->residentMaxX; x++) {
+                if (x >= minX && x <= maxX && y >= minY && y <= maxY)
+                    continue;
+                TmxTileChunk* chunk = FindTileChunk(tileLayer, x, y);
+                if (chunk != NULL && chunk->tiles != NULL) {
+                    MemFree(chunk->tiles);
+                    chunk->tiles = NULL;
+                }
+            }
+        }
+        /* Decode the chunks that are now close enough but weren't already */
+        for (int32_t y = Clampi(minY, tileLayer->chunksMinY, tileLayer->chunksMaxY + 1);
+             y <= maxY && y <= tileLayer->chunksMaxY; y++) {
+            for (int32_t x = Clampi(minX, tileLayer->chunksMinX, tileLayer->chunksMaxX + 1);
+                 x <= maxX && x <= tileLayer->chunksMaxX; x++) {
+                TmxTileChunk* chunk = FindTileChunk(tileLayer, x, y);
+                if (chunk != NULL && chunk->tiles == NULL)
+                    LoadTileChunk(layer, chunk);
+            }
+        }
+        tileLayer->residentMinX = minX;
+        tileLayer->residentMinY = minY;
+        tileLayer->residentMaxX = maxX;
+        tileLayer->residentMaxY = maxY;
+    }
 }
 
-void FreeLayer(TmxLayer layer) {
-    FreeString(layer.name);
-    FreeString(layer.classString);
-    if (layer.properties != NULL) {
-        for (uint32_t i = 0; i < layer.propertiesLength; i++)
-            FreeProperty(layer.properties[i]);
-        MemFree(layer.properties);
+void LoadTileChunk(const TmxLayer* layer, TmxTileChunk* chunk) {
+    const TmxTileLayer* tileLayer = &layer->exact.tileLayer;
+    uint32_t tilesLength = chunk->width * chunk->height;
+    if (chunk->data == NULL || tileLayer->encoding == NULL || tilesLength == 0)
+        return;
+    
+    /* The chunk is given its tiles even if decoding fails so it isn't attempted again every frame */
+    chunk->tiles = (uint32_t*)MemAllocZero((unsigned int)(sizeof(uint32_t) * tilesLength));
+    uint32_t tilesDecoded = 0;
+    if (strcmp(tileLayer->encoding, "base64") == 0) {
+        int dataLength;
+        unsigned char* data = DecodeTileData(layer->name, chunk->data, tileLayer->compression, &dataLength);
+        if (data != NULL) {
+            /* raylib's platforms are all little-endian so the bytes already have the in-memory layout of the GIDs */
+            tilesDecoded = (uint32_t)dataLength / 4;
+            memcpy(chunk->tiles, data, sizeof(uint32_t) * (tilesDecoded < tilesLength ? tilesDecoded : tilesLength));
+            MemFree(data);
+        }
+    } else if (strcmp(tileLayer->encoding, "csv") == 0)
+        tilesDecoded = DecodeTileDataCsv(chunk->data, chunk->tiles, tilesLength);
+    
+    if (tilesDecoded != tilesLength) {
+        TraceLog(LOG_WARNING, "RAYTMX: Chunk at (%d, %d) of layer \"%s\" has %u tiles but its dimensions call for %u "
+                 "- missing tiles will be empty and extra tiles will be dropped", chunk->x, chunk->y, layer->name,
+                 tilesDecoded, tilesLength);
     }
-    switch (layer.type) {
-        case LAYER_TYPE_TILE_LAYER:
-        FreeString(layer.exact.tileLayer.encoding);
-        FreeString(layer.exact.tileLayer.compression);
-        MemFree(layer.exact.tileLayer.tiles);
-        break;
-        case LAYER_TYPE_OBJECT_GROUP:
-        for (uint32_t j = 0; j < layer.exact.objectGroup.objectsLength; j++)
-            FreeObject(layer.exact.objectGroup.objects[j]);
-        MemFree(layer.exact.objectGroup.objects);
-        break;
-        case LAYER_TYPE_IMAGE_LAYER:
-        if (layer.exact.imageLayer.hasImage)
-            UnloadTexture(layer.exact.imageLayer.image.texture);
-        break;
-        case LAYER_TYPE_GROUP: break; /* Nothing to do for this case but compilers like to complain */
+}
+
+TmxTileChunk* FindTileChunk(const TmxTileLayer* tileLayer, int32_t chunkX, int32_t chunkY) {
+    if (tileLayer->chunkTableCapacity == 0)
+        return NULL;
+    
+    uint32_t mask = tileLayer->chunkTableCapacity - 1;
+    for (uint32_t slot = HashChunkCoordinates(chunkX, chunkY) & mask; ; slot = (slot + 1) & mask) {
+        uint32_t entry = tileLayer->chunkTable[slot];
+        if (entry == 0) /* An empty slot ends the probe sequence */
+            return NULL;
+        TmxTileChunk* chunk = &tileLayer->chunks[entry - 1];
+        if (chunk->x == chunkX * (int32_t)tileLayer->chunkWidth && chunk->y == chunkY * (int32_t)tileLayer->chunkHeight)
+            return chunk;
     }
-    /* <group> layers are expected to have child layers, or child <group>s, so recursively free them too */
-    for (uint32_t i = 0; i < layer.layersLength; i++)
-        FreeLayer(layer.layers[i]);
 }
 
-void FreeObject(TmxObject object) {
-    FreeString(object.name);
-    FreeString(object.typeString);
-    FreeString(object.templateString);
-    if (object.points != NULL)
-        MemFree(object.points);
-    if (object.text != NULL) {
-        if (object.text->lines != NULL) {
-            for (uint32_t j = 0; j < object.text->linesLength; j++)
-                FreeString(object.text->lines[j].content);
-            MemFree(object.text->lines);
-        } /* object.text->lines != NULL */
-        MemFree(object.text);
-    } /* object.text != NULL */
+uint32_t HashChunkCoordinates(int32_t chunkX, int32_t chunkY) {
+    uint32_t hash = ((uint32_t)chunkX * 73856093u) ^ ((uint32_t)chunkY * 19349663u);
+    return hash ^ (hash >> 16);
 }
 
 #define SIGN(x) (x < 0 ? -1 : +1)
@@ -3265,104 +4831,132 @@ int Clampi(int value, int minimum, int maximum) {
     return value;
 }
 
-/**
- * Scary-looking helper function that does something kind of simple: iterates through the tiles of the given tile layer
- * overlapping with the given viewport, one tile per call. This function returns true while iteration is still ongoing
- * and false when done. This allows the function to be used e.g. "while (IterateTileLayer( { ...} ))". Details of the
- * current tile are returned to the caller with output parameters. Iteration is done row-by-row.
- *
- * @param map A loaded map model containing the given tile layer.
- * @param layer The tile layer within the given map whose tiles will be iterated.
- * @param viewport A rectangle representing the region being drawn to. This could also be considered a search area.
- * @param rawGid Optional output. The Global ID (GID) with possible flip flags. Pass NULL if not wanted.
- * @param tile Optional output. Metadata of the current tile. Pass NULL if not wanted.
- * @param tileRect Optional output. The destination rectangle, in pixels, of the current tile. Pass NULL if not wanted.
- * @return True if the next tile is being provided via the output parameters, or false if iteration is done.
- */
-bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle viewport, uint32_t* rawGid, TmxTile* tile,
-                      Rectangle* tileRect) {
-    /* Static variables whose values will persist between calls. These are needed to initialize and iterate. */
-    static const TmxTileLayer* currentLayer = NULL; /* Tile layer being iterated */
-    static int fromX = 0; /* Initial X position, tile not pixel, that row-by-row iteration begins at */
-    static int fromY = 0; /* Initial Y position, tile not pixel, that row-by-row iteration begins at */
-    static int toX = 0; /* Final X position, tile not pixel, that iteration ends at */
-    static int toY = 0; /* Final Y position, tile not pixel, that iteration ends at */
-    static int currentX = 0; /* Current tile X position (column) within the iteration */
-    static int currentY = 0; /* Current tile Y position (row) within the iteration */
-    
-    if (map == NULL || map->width == 0 || map->height == 0 || map->tileWidth == 0 || map->tileHeight == 0 ||
-        layer == NULL || layer->tilesLength == 0)
-        return false;
+/* Integer division rounding toward negative infinity, rather than zero, for positions left of or above the origin */
+int FloorDivi(int dividend, int divisor) {
+    int quotient = dividend / divisor;
+    if ((dividend % divisor != 0) && ((dividend < 0) != (divisor < 0)))
+        quotient -= 1;
+    return quotient;
+}
+
+RAYTMX_DEC void InitTMXTileLayerIterator(TmxTileLayerIterator* iterator, const TmxMap* map,
+                                         const TmxTileLayer* layer, Rectangle viewport) {
+    if (iterator == NULL)
+        return;
     
-    if (currentLayer != layer) { /* If the layer has changed (i.e. iteration should initialize) */
-        currentLayer = layer; /* Remember this layer */
-        switch (map->renderOrder) {
-            case RENDER_ORDER_RIGHT_DOWN:
-            /* Start at the top-left, iterate right, then iterate down, ending at the bottom-right. */
-            /* In other words, this is the order in which English is read. */
-            fromX = (int)viewport.x / (int)map->tileWidth;
-            fromY = (int)viewport.y / (int)map->tileHeight;
-            toX = (int)(viewport.x + viewport.width) / (int)map->tileWidth;
-            toY = (int)(viewport.y + viewport.height) / (int)map->tileHeight;
-            break;
-            case RENDER_ORDER_RIGHT_UP:
-            /* Start at the bottom-left, iterate right, then iterate up, ending at the top-right */
-            fromX = (int)viewport.x / (int)map->tileWidth;
-            fromY = (int)(viewport.y + viewport.height) / (int)map->tileHeight;
-            toX = (int)(viewport.x + viewport.width) / (int)map->tileWidth;
-            toY = (int)viewport.y / (int)map->tileHeight;
-            break;
-            case RENDER_ORDER_LEFT_DOWN:
-            /* Start at the top-right, iterate left, then iterate down, ending at the bottom-left */
-            fromX = (int)(viewport.x + viewport.width) / (int)map->tileWidth;
-            fromY = (int)viewport.y / (int)map->tileHeight;
-            toX = (int)viewport.x / (int)map->tileWidth;
-            toY = (int)(viewport.y + viewport.height) / (int)map->tileHeight;
-            break;
-            case RENDER_ORDER_LEFT_UP:
-            /* Start at the bottom-right, iterate left, then iterate up, ending at the top-left */
-            fromX = (int)(viewport.x + viewport.width) / (int)map->tileWidth;
-            fromY = (int)(viewport.y + viewport.height) / (int)map->tileHeight;
-            toX = (int)viewport.x / (int)map->tileWidth;
-            toY = (int)viewport.y / (int)map->tileHeight;
-            break;
-        } /* switch (map->renderOrder) */
-        /* Restrain the the tile positions to those within the map in case of rounding mistakes */
-        fromX = Clampi(fromX, 0, (int)map->width - 1);
-        fromY = Clampi(fromY, 0, (int)map->height - 1);
-        toX = Clampi(toX, 0, (int)map->width - 1);
-        toY = Clampi(toY, 0, (int)map->height - 1);
-        /* Begin iteration from both "from" tile positions */
-        currentX = fromX;
-        currentY = fromY;
-    } else if (currentX == toX) { /* If the end of the current row was reached */
-        /* Rendering is done row-by-row. This row is done so move to the next one. */
-        currentX = fromX;
-        currentY += SIGN(toY - fromY); /* Either +1 or -1 */
-    } else { /* If still iterating through the current row */
-        /* Move to the right or left by one tile */
-        currentX += SIGN(toX - fromX); /* Either +1 or -1 */
+    memset(iterator, 0, sizeof(TmxTileLayerIterator));
+    iterator->map = map;
+    iterator->layer = layer;
+    if (map == NULL || map->tileWidth == 0 || map->tileHeight == 0 || layer == NULL ||
+        (layer->chunksLength == 0 && (map->width == 0 || map->height == 0 || layer->tilesLength == 0))) {
+        iterator->isDone = true;
+        return;
     }
     
-    /* If iteration has gone beyond the final row */
-    if ((toY - fromY > 0 && currentY > toY) || (toY - fromY < 0 && currentY < toY)) {
-        /* This is the termination condition. Zero all values and return false so the caller exits its loop. */
-        currentLayer = NULL;
-        fromX = fromY = toX = toY = currentX = currentY = 0;
-        return false;
+    /* Tile positions, not pixels, of the viewport's edges. Chunks of infinite maps may be left of or above the */
+    /* origin so these are rounded down rather than toward zero. */
+    int left = (int)floorf(viewport.x / (float)map->tileWidth);
+    int top = (int)floorf(viewport.y / (float)map->tileHeight);
+    int right = (int)floorf((viewport.x + viewport.width) / (float)map->tileWidth);
+    int bottom = (int)floorf((viewport.y + viewport.height) / (float)map->tileHeight);
+    int fromY = top;
+    switch (map->renderOrder) {
+        case RENDER_ORDER_RIGHT_DOWN:
+        /* Start at the top-left, iterate right, then iterate down, ending at the bottom-right. */
+        /* In other words, this is the order in which English is read. */
+        iterator->fromX = left;
+        iterator->toX = right;
+        fromY = top;
+        iterator->toY = bottom;
+        break;
+        case RENDER_ORDER_RIGHT_UP:
+        /* Start at the bottom-left, iterate right, then iterate up, ending at the top-right */
+        iterator->fromX = left;
+        iterator->toX = right;
+        fromY = bottom;
+        iterator->toY = top;
+        break;
+        case RENDER_ORDER_LEFT_DOWN:
+        /* Start at the top-right, iterate left, then iterate down, ending at the bottom-left */
+        iterator->fromX = right;
+        iterator->toX = left;
+        fromY = top;
+        iterator->toY = bottom;
+        break;
+        case RENDER_ORDER_LEFT_UP:
+        /* Start at the bottom-right, iterate left, then iterate up, ending at the top-left */
+        iterator->fromX = right;
+        iterator->toX = left;
+        fromY = bottom;
+        iterator->toY = top;
+        break;
+    } /* switch (map->renderOrder) */
+    /* Restrain the the tile positions to those within the map, or within the layer's chunks, in case of rounding */
+    /* mistakes */
+    int minX = 0, minY = 0, maxX = (int)map->width - 1, maxY = (int)map->height - 1;
+    if (layer->chunksLength > 0) {
+        minX = layer->chunksMinX * (int)layer->chunkWidth;
+        minY = layer->chunksMinY * (int)layer->chunkHeight;
+        maxX = ((layer->chunksMaxX + 1) * (int)layer->chunkWidth) - 1;
+        maxY = ((layer->chunksMaxY + 1) * (int)layer->chunkHeight) - 1;
     }
+    iterator->fromX = Clampi(iterator->fromX, minX, maxX);
+    iterator->toX = Clampi(iterator->toX, minX, maxX);
+    fromY = Clampi(fromY, minY, maxY);
+    iterator->toY = Clampi(iterator->toY, minY, maxY);
+    /* The directions are fixed here so that a single row or column ends where it should */
+    iterator->stepX = SIGN(iterator->toX - iterator->fromX); /* Either +1 or -1 */
+    iterator->stepY = SIGN(iterator->toY - fromY); /* Either +1 or -1 */
+    /* Begin one step before the first tile so that the first NextTMXTileLayerTile() call lands on it */
+    iterator->currentX = iterator->fromX - iterator->stepX;
+    iterator->currentY = fromY;
+}
+
+RAYTMX_DEC bool NextTMXTileLayerTile(TmxTileLayerIterator* iterator, uint32_t* rawGid, TmxTile* tile,
+                                     Rectangle* tileRect) {
+    if (iterator == NULL || iterator->isDone)
+        return false;
     
-    /* Calculate the index in the tile layer from knowing the tile's X and Y position (in tiles, not pixels) */
-    int index = (currentY * (int)map->width) + currentX;
-    if (index < 0 || index >= (int)layer->tilesLength) { /* Bounds check */
-        currentLayer = NULL;
-        fromX = fromY = toX = toY = currentX = currentY = 0;
+    if (iterator->currentX == iterator->toX) { /* If the end of the current row was reached */
+        /* Iteration is done row-by-row. This row is done so move to the next one. */
+        iterator->currentX = iterator->fromX;
+        iterator->currentY += iterator->stepY;
+    } else /* If still iterating through the current row */
+        iterator->currentX += iterator->stepX; /* Move to the right or left by one tile */
+    
+    /* If iteration has gone beyond the final row */
+    if ((iterator->currentY - iterator->toY) * iterator->stepY > 0) {
+        iterator->isDone = true;
         return false;
     }
     
-    /* Get the raw Global ID (GID) of the tile at this position from the layer's list of tiles. This list's order */
-    /* matches the map's render order. */
-    uint32_t localRawGid = layer->tiles[index];
+    const TmxMap* map = iterator->map;
+    const TmxTileLayer* layer = iterator->layer;
+    uint32_t localRawGid = 0;
+    
+    if (layer->chunksLength > 0) { /* If the layer is made of chunks, as those of infinite maps are */
+        int x = iterator->currentX, y = iterator->currentY;
+        const TmxTileChunk* chunk = iterator->chunk;
+        if (chunk == NULL || x < chunk->x || x >= chunk->x + (int)chunk->width || y < chunk->y ||
+            y >= chunk->y + (int)chunk->height) { /* If the tile isn't within the last tile's chunk */
+            chunk = FindTileChunk(layer, FloorDivi(x, (int)layer->chunkWidth), FloorDivi(y, (int)layer->chunkHeight));
+            iterator->chunk = chunk;
+        }
+        /* Positions without a chunk, and chunks that aren't resident (see UpdateTMXChunkResidency()), are empty */
+        if (chunk != NULL && chunk->tiles != NULL)
+            localRawGid = chunk->tiles[((y - chunk->y) * (int)chunk->width) + (x - chunk->x)];
+    } else {
+        /* Calculate the index in the tile layer from knowing the tile's X and Y position (in tiles, not pixels) */
+        int index = (iterator->currentY * (int)map->width) + iterator->currentX;
+        if (index < 0 || index >= (int)layer->tilesLength) { /* Bounds check */
+            iterator->isDone = true;
+            return false;
+        }
+        
+        /* Get the raw Global ID (GID) of the tile at this position from the layer's list of tiles. This list's */
+        /* order matches the map's render order. */
+        localRawGid = layer->tiles[index];
+    }
     if (rawGid != NULL)
         *rawGid = localRawGid; /* Assign the value to he output parameter */
     if (tile != NULL) {
@@ -3375,8 +4969,8 @@ bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle vi
     if (tileRect != NULL) {
         /* Calculate the tile's destination rectangle, in pixels */
         *tileRect = (Rectangle) {
-            .x = (float)((uint32_t)currentX * map->tileWidth),
-            .y = (float)((uint32_t)currentY * map->tileHeight),
+            .x = (float)(iterator->currentX * (int)map->tileWidth),
+            .y = (float)(iterator->currentY * (int)map->tileHeight),
             .width = (float)map->tileWidth,
             .height = (float)map->tileHeight
         };
@@ -3386,40 +4980,424 @@ bool IterateTileLayer(const TmxMap* map, const TmxTileLayer* layer, Rectangle vi
 }
 
 void DrawTMXTileLayer(const TmxMap* map, Rectangle viewport, TmxLayer layer, int posX, int posY, Color tint) {
-    if (map == NULL || layer.type != LAYER_TYPE_TILE_LAYER || layer.exact.tileLayer.tilesLength == 0)
+    if (map == NULL || layer.type != LAYER_TYPE_TILE_LAYER ||
+        (layer.exact.tileLayer.tilesLength == 0 && layer.exact.tileLayer.chunksLength == 0))
+        return;
+    
+    /* If the layer was pre-rendered by LoadTMXRenderCache(), draw its chunks instead */
+    if (DrawTMXLayerChunks(map, viewport, &layer.exact.tileLayer, posX, posY, tint))
+        return;
+    
+    if (tint.a == 0)
         return;
     
-    /* Iterate through each tile that the screen rectangle overlaps with */
+    /* Iterate through each tile that the screen rectangle overlaps with, buffering them to be drawn in order */
+    RaytmxTileBatch batch;
+    batch.quadsLength = 0;
+    batch.tint = tint;
+    TmxTileLayerIterator iterator;
+    InitTMXTileLayerIterator(&iterator, map, &layer.exact.tileLayer, viewport);
     uint32_t rawGid;
     Rectangle tileRect;
-    while (IterateTileLayer(/* map: */ map, /* layer: */ &layer.exact.tileLayer, /* viewport: */ viewport,
-                            /* rawGid: */ &rawGid, /* tile: */ NULL, /* tileRect: */ &tileRect)) {
-        DrawTMXLayerTile(/* map: */ map, /* viewport: */ viewport, /* rawGid: */ rawGid,
-                         /* posX: */ posX + (int)tileRect.x, /* posY: */ posY + (int)tileRect.y, /* tint: */ tint);
+    while (NextTMXTileLayerTile(/* iterator: */ &iterator, /* rawGid: */ &rawGid, /* tile: */ NULL,
+                                /* tileRect: */ &tileRect)) {
+        BatchTMXLayerTile(/* batch: */ &batch, /* map: */ map, /* viewport: */ viewport, /* rawGid: */ rawGid,
+                          /* posX: */ posX + (int)tileRect.x, /* posY: */ posY + (int)tileRect.y);
+    }
+    DrawTileBatch(&batch);
+}
+
+bool DrawTMXLayerChunks(const TmxMap* map, Rectangle viewport, const TmxTileLayer* tileLayer, int posX, int posY,
+                        Color tint) {
+    const RaytmxRenderCache* cache = map->renderCache;
+    if (cache == NULL)
+        return false;
+    
+    /* Layers are passed by value so they're identified by their tiles, which aren't copied */
+    const RaytmxLayerChunks* layerChunks = NULL;
+    for (uint32_t i = 0; i < cache->layersLength && layerChunks == NULL; i++) {
+        if (cache->layers[i].tiles == tileLayer->tiles)
+            layerChunks = &cache->layers[i];
+    }
+    if (layerChunks == NULL)
+        return false;
+    
+    /* Determine the range of chunks, including their padding, that the viewport overlaps */
+    float chunkWidth = (float)(cache->chunkTiles * map->tileWidth);
+    float chunkHeight = (float)(cache->chunkTiles * map->tileHeight);
+    int fromX = (int)floorf((viewport.x - (float)posX - (float)cache->padRight) / chunkWidth);
+    int fromY = (int)floorf((viewport.y - (float)posY - (float)cache->padBottom) / chunkHeight);
+    int toX = (int)floorf((viewport.x + viewport.width - (float)posX + (float)cache->padLeft) / chunkWidth);
+    int toY = (int)floorf((viewport.y + viewport.height - (float)posY + (float)cache->padTop) / chunkHeight);
+    fromX = Clampi(fromX, 0, (int)cache->columns - 1);
+    fromY = Clampi(fromY, 0, (int)cache->rows - 1);
+    toX = Clampi(toX, 0, (int)cache->columns - 1);
+    toY = Clampi(toY, 0, (int)cache->rows - 1);
+    
+    /* Chunks hold premultiplied colors (see RenderTMXChunk()) so the tint's color must be premultiplied as well */
+    Color premultipliedTint;
+    premultipliedTint.r = (unsigned char)((tint.r * tint.a) / 255);
+    premultipliedTint.g = (unsigned char)((tint.g * tint.a) / 255);
+    premultipliedTint.b = (unsigned char)((tint.b * tint.a) / 255);
+    premultipliedTint.a = tint.a;
+    
+    BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+    for (int y = fromY; y <= toY; y++) {
+        for (int x = fromX; x <= toX; x++) {
+            const RaytmxChunk* chunk = &layerChunks->chunks[(y * (int)cache->columns) + x];
+            if (chunk->target.id == 0) /* If the chunk has no tiles */
+                continue;
+            
+            /* Render textures are upside-down so the source rectangle's height is negated to flip it back */
+            Rectangle source;
+            source.x = 0.0f;
+            source.y = 0.0f;
+            source.width = (float)chunk->target.texture.width;
+            source.height = -(float)chunk->target.texture.height;
+            Vector2 position;
+            position.x = (float)posX + ((float)x * chunkWidth) - (float)cache->padLeft;
+            position.y = (float)posY + ((float)y * chunkHeight) - (float)cache->padTop;
+            DrawTextureRec(chunk->target.texture, source, position, premultipliedTint);
+        }
+    }
+    EndBlendMode();
+    
+    return true;
+}
+
+void RenderTMXChunk(const TmxMap* map, const RaytmxRenderCache* cache, const RaytmxLayerChunks* layerChunks,
+                    uint32_t chunkX, uint32_t chunkY, RaytmxChunk* chunk) {
+    Rectangle viewport; /* The whole render texture */
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = (float)chunk->target.texture.width;
+    viewport.height = (float)chunk->target.texture.height;
+    
+    /* Iterate through the chunk's tiles in the map's render order so overlapping tiles are layered as they would be */
+    /* when drawn individually */
+    int stepX = 1, stepY = 1;
+    if (map->renderOrder == RENDER_ORDER_LEFT_DOWN || map->renderOrder == RENDER_ORDER_LEFT_UP)
+        stepX = -1;
+    if (map->renderOrder == RENDER_ORDER_RIGHT_UP || map->renderOrder == RENDER_ORDER_LEFT_UP)
+        stepY = -1;
+    int fromX = (int)(chunkX * cache->chunkTiles), fromY = (int)(chunkY * cache->chunkTiles);
+    int toX = Clampi(fromX + (int)cache->chunkTiles - 1, 0, (int)map->width - 1);
+    int toY = Clampi(fromY + (int)cache->chunkTiles - 1, 0, (int)map->height - 1);
+    if (stepX < 0) {
+        int temp = fromX;
+        fromX = toX;
+        toX = temp;
+    }
+    if (stepY < 0) {
+        int temp = fromY;
+        fromY = toY;
+        toY = temp;
+    }
+    
+    BeginTextureMode(chunk->target);
+    ClearBackground(BLANK);
+    /* Blending color as usual but alpha additively leaves the render texture with premultiplied colors. Drawing */
+    /* tiles with any transparency into the transparent texture would otherwise square their alpha. */
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD,
+                              RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    RaytmxTileBatch batch;
+    batch.quadsLength = 0;
+    batch.tint = WHITE;
+    for (int y = fromY; y != toY + stepY; y += stepY) {
+        for (int x = fromX; x != toX + stepX; x += stepX) {
+            int posX = cache->padLeft + ((x - (int)(chunkX * cache->chunkTiles)) * (int)map->tileWidth);
+            int posY = cache->padTop + ((y - (int)(chunkY * cache->chunkTiles)) * (int)map->tileHeight);
+            uint32_t index = (uint32_t)((y * (int)map->width) + x);
+            if (index < layerChunks->tilesLength)
+                BatchTMXLayerTile(&batch, map, viewport, layerChunks->tiles[index], posX, posY);
+        }
+    }
+    DrawTileBatch(&batch);
+    EndBlendMode();
+    EndTextureMode();
+}
+
+bool BuildGidsToTiles(TmxMap* map, uint32_t gidsToTilesLength) {
+    /* Every tileset's image, then every one of its tiles' images, gets a slot in the tile textures array. The slots */
+    /* are numbered here and filled by PackTileDraws() which walks the tilesets in the same order. Only the tiles of */
+    /* tilesets with shared images can be animated. */
+    uint32_t tileTexturesLength = 0, animationsLength = 0;
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        if (map->tilesets[i].hasImage)
+            tileTexturesLength++;
+        for (uint32_t j = 0; j < map->tilesets[i].tilesLength; j++) {
+            if (map->tilesets[i].tiles[j].hasImage)
+                tileTexturesLength++;
+            if (map->tilesets[i].hasImage && map->tilesets[i].tiles[j].hasAnimation)
+                animationsLength++;
+        }
+    }
+    if (tileTexturesLength > UINT16_MAX) { /* If there are more images than a TmxTileDraw can reference */
+        TraceLog(LOG_WARNING, "RAYTMX: Tiles of images past the first %d are not drawn in tile layers", UINT16_MAX);
+        tileTexturesLength = UINT16_MAX;
+    }
+    
+    /* Everything is allocated before the map or its tilesets are touched so that running out of memory leaves them */
+    /* as they were. The extra tile texture slot, past the end, is never filled. It's used by tiles without one. */
+    TmxTile* gidsToTiles = (TmxTile*)ArenaAlloc(&map->arena, sizeof(TmxTile) * gidsToTilesLength);
+    TmxTileDraw* tileDraws = (TmxTileDraw*)ArenaAlloc(&map->arena, sizeof(TmxTileDraw) * gidsToTilesLength);
+    Texture2D* tileTextures = (Texture2D*)ArenaAlloc(&map->arena, sizeof(Texture2D) * (tileTexturesLength + 1));
+    uint32_t* animatedGids = NULL;
+    uint32_t* changedGids = NULL;
+    if (animationsLength > 0) {
+        animatedGids = (uint32_t*)ArenaAlloc(&map->arena, sizeof(uint32_t) * animationsLength);
+        changedGids = (uint32_t*)ArenaAlloc(&map->arena, sizeof(uint32_t) * animationsLength);
+    }
+    if (gidsToTiles == NULL || tileDraws == NULL || tileTextures == NULL ||
+        (animationsLength > 0 && (animatedGids == NULL || changedGids == NULL)))
+        return false;
+    map->tileTextures = tileTextures;
+    map->tileTexturesLength = tileTexturesLength;
+    for (uint32_t gid = 0; gid < gidsToTilesLength; gid++)
+        tileDraws[gid].textureIndex = (uint16_t)tileTexturesLength;
+    uint32_t textureIndex = 0;
+    
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        TmxTileset* tileset = &map->tilesets[i];
+        if (tileset->hasImage) { /* If the tileset has a shared image (i.e. not a "collection of images") */
+            uint16_t tilesetTextureIndex = (uint16_t)(textureIndex < tileTexturesLength ? textureIndex :
+                                                      tileTexturesLength);
+            textureIndex++;
+            /* First, iterate through the explicit tiles. These are explicitly defined with <tile> elements and */
+            /* are used to, among other things, provide animations and specific source rectangles. Note: Their */
+            /* IDs may exceed the tileset's tile count. */
+            for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+                TmxTilesetTile tilesetTile = tileset->tiles[j];
+                uint32_t gid = tileset->firstGid + tilesetTile.id;
+                if (tilesetTile.hasAnimation) { /* If the tile is meta, pointing to a series of other tiles */
+                    gidsToTiles[gid].hasAnimation = true;
+                    gidsToTiles[gid].animation = tilesetTile.animation;
+                    /* Frames' tile (G)IDs are initially set with local values. Now that all tilesets are known */
+                    /* and this tileset's first global ID is available, update the ID to be global. */
+                    for (uint32_t k = 0; k < gidsToTiles[gid].animation.framesLength; k++)
+                        gidsToTiles[gid].animation.frames[k].gid += tileset->firstGid;
+                }
+                if (tilesetTile.x != 0 || tilesetTile.y != 0 || tilesetTile.width != 0 || tilesetTile.height != 0) {
+                    /* This tile directly tells us the area within the tileset's image to use when drawing, */
+                    /* overriding the implicit dimensions derived from the map's tile width and height. */
+                    gidsToTiles[gid].sourceRect.x = (float)tilesetTile.x;
+                    gidsToTiles[gid].sourceRect.y = (float)tilesetTile.y;
+                    gidsToTiles[gid].sourceRect.width = (float)tilesetTile.width;
+                    gidsToTiles[gid].sourceRect.height = (float)tilesetTile.height;
+                }
+                /* Tiles may have child object groups. These objects are a form of collision information. The */
+                /* object group may be empty or may have objects. A simple assignment covers both. */
+                gidsToTiles[gid].objectGroup = tilesetTile.objectGroup;
+                gidsToTiles[gid].gid = gid; /* Tell the tile its GID */
+            } /* for (uint32_t j = 0; j < tileset->tilesLength; j++) */
+            /* Second, loop through the implicit tiles. These are inferred from knowing the dimensions of the */
+            /* tileset's image, dimensiosn of tiles, and the (right-down) order of tiles within the image. */
+            for (uint32_t id = 0; id < tileset->tileCount; id++) {
+                uint32_t gid = id + tileset->firstGid, x = id % tileset->columns, y = id / tileset->columns;
+                gidsToTiles[gid].gid = gid; /* Tell the tile its GID */
+                /* If that source renctangle within the image was NOT explicitly defined. */
+                /* Note: Float comparisons like this are typically unreliable but the GIDs-to-tiles array is */
+                /* initialized with zeroes making this accurate. */
+                if (gidsToTiles[gid].sourceRect.x == 0.0f && gidsToTiles[gid].sourceRect.y == 0.0f &&
+                    gidsToTiles[gid].sourceRect.width == 0.0f && gidsToTiles[gid].sourceRect.height == 0.0f) {
+                    /* Calculate the area within the texture to be drawn from contextual information */
+                    gidsToTiles[gid].sourceRect.x = (float)(tileset->margin + (x * tileset->tileWidth) +
+                                                            (x * tileset->spacing));
+                    gidsToTiles[gid].sourceRect.y = (float)(tileset->margin + (y * tileset->tileHeight) +
+                                                            (y * tileset->spacing));
+                    gidsToTiles[gid].sourceRect.width = (float)tileset->tileWidth;
+                    gidsToTiles[gid].sourceRect.height = (float)tileset->tileHeight;
+                }
+                gidsToTiles[gid].texture = tileset->image.texture;
+                tileDraws[gid].textureIndex = tilesetTextureIndex;
+                gidsToTiles[gid].offset.x = (float)tileset->tileOffsetX;
+                gidsToTiles[gid].offset.y = (float)tileset->tileOffsetY;
+            } /* for (uint32_t id = 0; id < tileset->tileCount; id++) */
+            for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+                if (tileset->tiles[j].hasImage) /* Images of tiles within tilesets with shared images go unused */
+                    textureIndex++;
+            }
+        } else { /* If the tileset is a collection of images where each tile has its own image */
+            for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+                TmxTilesetTile tilesetTile = tileset->tiles[j];
+                if (!tilesetTile.hasImage) {
+                    TraceLog(LOG_WARNING, "RAYTMX: Skipping tile %d of image collection tileset \"%s\" because "
+                             "it has no image", tilesetTile.id, tileset->name);
+                    continue;
+                }
+                uint16_t tileTextureIndex = (uint16_t)(textureIndex < tileTexturesLength ? textureIndex :
+                                                       tileTexturesLength);
+                textureIndex++;
+                
+                int32_t gid = tileset->firstGid + tilesetTile.id;
+                gidsToTiles[gid].gid = gid;
+                gidsToTiles[gid].sourceRect.x = (float)tilesetTile.x; /* Defaults to and probably is zero */
+                gidsToTiles[gid].sourceRect.y = (float)tilesetTile.y; /* Defaults to and probably is zero */
+                if (tilesetTile.width != tilesetTile.image.width)
+                    gidsToTiles[gid].sourceRect.width = (float)tilesetTile.width;
+                else
+                    gidsToTiles[gid].sourceRect.width = (float)tilesetTile.image.width;
+                if (tilesetTile.height != tilesetTile.image.height)
+                    gidsToTiles[gid].sourceRect.height = (float)tilesetTile.height;
+                else
+                    gidsToTiles[gid].sourceRect.height = (float)tilesetTile.image.height;
+                gidsToTiles[gid].texture = tilesetTile.image.texture;
+                tileDraws[gid].textureIndex = tileTextureIndex;
+            }
+        }
+    }
+    
+    map->gidsToTiles = gidsToTiles;
+    map->gidsToTilesLength = gidsToTilesLength;
+    map->tileDraws = tileDraws;
+    
+    /* Index the animated tiles so that animating the map doesn't mean searching every GID for them. There are at */
+    /* most as many as the tiles counted above, fewer if any of those share a GID. */
+    map->animatedGids = animatedGids;
+    map->changedGids = changedGids;
+    map->animatedGidsLength = 0;
+    map->changedGidsLength = 0;
+    for (uint32_t gid = 1; gid < gidsToTilesLength && animationsLength > 0; gid++) {
+        if (gidsToTiles[gid].gid != 0 && gidsToTiles[gid].hasAnimation && map->animatedGidsLength < animationsLength)
+            map->animatedGids[map->animatedGidsLength++] = gid;
+    }
+    CalculateTileTexCoords(map);
+    PackTileDraws(map);
+    return true;
+}
+
+/* Switches the GIDs of the frames of animated tiles, within tilesets with shared images, between global and local */
+void OffsetAnimationFrameGids(TmxMap* map, bool toGlobal) {
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        TmxTileset* tileset = &map->tilesets[i];
+        for (uint32_t j = 0; j < tileset->tilesLength && tileset->hasImage; j++) {
+            if (!tileset->tiles[j].hasAnimation)
+                continue;
+            TmxAnimation animation = tileset->tiles[j].animation;
+            for (uint32_t k = 0; k < animation.framesLength; k++) {
+                if (toGlobal)
+                    animation.frames[k].gid += tileset->firstGid;
+                else
+                    animation.frames[k].gid -= tileset->firstGid;
+            }
+        }
+    }
+}
+
+/* Advances an animated tile's frame for as long as the current frame has been displayed for its whole duration, or */
+/* longer, but by no more than one cycle in case the durations are all zero */
+void StepTileAnimation(TmxTile* tile) {
+    for (uint32_t i = 0; i < tile->animation.framesLength &&
+         tile->frameTime > tile->animation.frames[tile->frameIndex].duration; i++) {
+        tile->frameTime -= tile->animation.frames[tile->frameIndex].duration;
+        /* Increment the frame index to display the next one... */
+        tile->frameIndex += 1;
+        /* ...unless the last frame was "last" in both senses */
+        if (tile->frameIndex == tile->animation.framesLength)
+            tile->frameIndex = 0; /* Wrap around to the first frame */
+    }
+}
+
+void CalculateTileTexCoords(TmxMap* map) {
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        TmxTile* tile = &map->gidsToTiles[gid];
+        float textureWidth = (float)tile->texture.width, textureHeight = (float)tile->texture.height;
+        if (textureWidth <= 0.0f || textureHeight <= 0.0f) /* If the texture is invalid */
+            continue;
+        tile->texCoordsMin.x = tile->sourceRect.x / textureWidth;
+        tile->texCoordsMin.y = tile->sourceRect.y / textureHeight;
+        tile->texCoordsMax.x = (tile->sourceRect.x + tile->sourceRect.width) / textureWidth;
+        tile->texCoordsMax.y = (tile->sourceRect.y + tile->sourceRect.height) / textureHeight;
+    }
+}
+
+/* Refreshes the tile textures and everything in the tile draws that's derived from 'gidsToTiles'. Only the texture */
+/* indexes, assigned by BuildGidsToTiles(), are left as they are. */
+void PackTileDraws(TmxMap* map) {
+    uint32_t textureIndex = 0;
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        const TmxTileset* tileset = &map->tilesets[i];
+        if (tileset->hasImage && textureIndex < map->tileTexturesLength)
+            map->tileTextures[textureIndex++] = tileset->image.texture;
+        for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+            if (tileset->tiles[j].hasImage && textureIndex < map->tileTexturesLength)
+                map->tileTextures[textureIndex++] = tileset->tiles[j].image.texture;
+        }
+    }
+    
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++) {
+        const TmxTile* tile = &map->gidsToTiles[gid];
+        TmxTileDraw* tileDraw = &map->tileDraws[gid];
+        tileDraw->frameGid = gid;
+        tileDraw->flags = 0;
+        if (tile->gid != 0)
+            tileDraw->flags |= TILE_DRAW_EXISTS;
+        if (tile->hasAnimation && tile->frameIndex < tile->animation.framesLength) {
+            tileDraw->flags |= TILE_DRAW_ANIMATED;
+            tileDraw->frameGid = tile->animation.frames[tile->frameIndex].gid;
+        }
+        tileDraw->texCoords[0] = PackTexCoord(tile->texCoordsMin.x);
+        tileDraw->texCoords[1] = PackTexCoord(tile->texCoordsMin.y);
+        tileDraw->texCoords[2] = PackTexCoord(tile->texCoordsMax.x);
+        tileDraw->texCoords[3] = PackTexCoord(tile->texCoordsMax.y);
+        tileDraw->offsetX = (int16_t)tile->offset.x;
+        tileDraw->offsetY = (int16_t)tile->offset.y;
+        tileDraw->width = (uint16_t)tile->sourceRect.width;
+        tileDraw->height = (uint16_t)tile->sourceRect.height;
+    }
+}
+
+uint16_t PackTexCoord(float texCoord) {
+    if (texCoord <= 0.0f)
+        return 0;
+    if (texCoord >= 1.0f)
+        return UINT16_MAX;
+    return (uint16_t)(texCoord * (float)UINT16_MAX + 0.5f);
+}
+
+uint32_t CollectTileLayers(const TmxLayer* layers, uint32_t layersLength, const TmxLayer** output) {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_TILE_LAYER && layers[i].exact.tileLayer.tilesLength > 0) {
+            if (output != NULL)
+                output[count] = &layers[i];
+            count++;
+        } else if (layers[i].type == LAYER_TYPE_GROUP)
+            count += CollectTileLayers(layers[i].layers, layers[i].layersLength, output != NULL ? output + count : NULL);
+    }
+    return count;
+}
+
+void DrawTextureTile(Texture2D texture, Vector2 texCoordsMin, Vector2 texCoordsMax, Rectangle dest, bool flipX,
+                     bool flipY, bool flipDiag, Color tint) {
+    if (texture.id == 0) /* If the texture is invalid */
+        return;
+    
+    rlSetTexture(texture.id);
+    rlBegin(RL_QUADS);
+    {
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f); /* Normal vector pointing towards viewer */
+        EmitTileQuad(texCoordsMin, texCoordsMax, dest, flipX, flipY, flipDiag);
     }
+    rlEnd();
+    rlSetTexture(0);
 }
 
-void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool flipX, bool flipY, bool flipDiag,
-                     Color tint) {
-    if (texture.id == 0) /* If the texture is invalid */
-        return;
-    
-    float textureWidth = (float)texture.width;
-    float textureHeight = (float)texture.height;
-    
+void EmitTileQuad(Vector2 texCoordsMin, Vector2 texCoordsMax, Rectangle dest, bool flipX, bool flipY, bool flipDiag) {
     /* Determine the area within the texture to be drawn */
     /* Note: The coordinates here are in the [0.0, 1.0] range where (0.0, 0.0) is the bottom-left corner of the */
     /* texture, (1.0, 0.0) is the bottom-right, and (1.0, 1.0) is the top-right. In other words, the coordinates are */
-    /* a ratio of the dimensions making (0.5, 0.5) the center of the texture regardless of its aspect ratio. */
+    /* a ratio of the dimensions making (0.5, 0.5) the center of the texture regardless of its aspect ratio. These */
+    /* were calculated once per tile by CalculateTileTexCoords() so only the flips are applied here. */
     Vector2 sourceTopLeft, sourceTopRight, sourceBottomLeft, sourceBottomRight;
-    sourceTopLeft.x = source.x / textureWidth;
-    sourceTopLeft.y = source.y / textureHeight;
-    sourceTopRight.x = (source.x + source.width) / textureWidth;
-    sourceTopRight.y = source.y / textureHeight;
-    sourceBottomLeft.x = source.x / textureWidth;
-    sourceBottomLeft.y = (source.y + source.height) / textureHeight;
-    sourceBottomRight.x = (source.x + source.width) / textureWidth;
-    sourceBottomRight.y = (source.y + source.height) / textureHeight;
+    sourceTopLeft = texCoordsMin;
+    sourceTopRight.x = texCoordsMax.x;
+    sourceTopRight.y = texCoordsMin.y;
+    sourceBottomLeft.x = texCoordsMin.x;
+    sourceBottomLeft.y = texCoordsMax.y;
+    sourceBottomRight = texCoordsMax;
     if (flipDiag) { /* If the tile uses a diagonal flip */
         /* "The diagonal flip should flip the bottom left and top right corners of the tile..." */
         Vector2 temp = sourceBottomLeft;
@@ -3438,66 +5416,82 @@ void DrawTextureTile(Texture2D texture, Rectangle source, Rectangle dest, bool f
     destBottomRight.x = dest.x + dest.width;
     destBottomRight.y = dest.y + dest.height;
     
-    rlSetTexture(texture.id);
-    rlBegin(RL_QUADS);
-    {
-        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
-        rlNormal3f(0.0f, 0.0f, 1.0f); /* Normal vector pointing towards viewer */
-        
-        /* Top-left corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        else
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        if (flipX && flipY)
-            rlVertex2f(destBottomRight.x, destBottomRight.y);
-        else
-            rlVertex2f(destTopLeft.x, destTopLeft.y);
-        
-        /* Bottom-left corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        else
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        if (flipX && flipY)
-            rlVertex2f(destTopRight.x, destTopRight.y);
-        else
-            rlVertex2f(destBottomLeft.x, destBottomLeft.y);
-        
-        /* Bottom-right corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        else
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        if (flipX && flipY)
-            rlVertex2f(destTopLeft.x, destTopLeft.y);
-        else
-            rlVertex2f(destBottomRight.x, destBottomRight.y);
-        
-        /* Top-right corner of the quad */
-        if (flipX && !flipY)
-            rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
-        else if (flipY && !flipX)
-            rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
-        else
-            rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
-        if (flipX && flipY)
-            rlVertex2f(destBottomLeft.x, destBottomLeft.y);
-        else
-            rlVertex2f(destTopRight.x, destTopRight.y);
+    /* Top-left corner of the quad */
+    if (flipX && !flipY)
+        rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
+    else if (flipY && !flipX)
+        rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
+    else
+        rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
+    if (flipX && flipY)
+        rlVertex2f(destBottomRight.x, destBottomRight.y);
+    else
+        rlVertex2f(destTopLeft.x, destTopLeft.y);
+    
+    /* Bottom-left corner of the quad */
+    if (flipX && !flipY)
+        rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
+    else if (flipY && !flipX)
+        rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
+    else
+        rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
+    if (flipX && flipY)
+        rlVertex2f(destTopRight.x, destTopRight.y);
+    else
+        rlVertex2f(destBottomLeft.x, destBottomLeft.y);
+    
+    /* Bottom-right corner of the quad */
+    if (flipX && !flipY)
+        rlTexCoord2f(sourceBottomLeft.x, sourceBottomLeft.y);
+    else if (flipY && !flipX)
+        rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
+    else
+        rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
+    if (flipX && flipY)
+        rlVertex2f(destTopLeft.x, destTopLeft.y);
+    else
+        rlVertex2f(destBottomRight.x, destBottomRight.y);
+    
+    /* Top-right corner of the quad */
+    if (flipX && !flipY)
+        rlTexCoord2f(sourceTopLeft.x, sourceTopLeft.y);
+    else if (flipY && !flipX)
+        rlTexCoord2f(sourceBottomRight.x, sourceBottomRight.y);
+    else
+        rlTexCoord2f(sourceTopRight.x, sourceTopRight.y);
+    if (flipX && flipY)
+        rlVertex2f(destBottomLeft.x, destBottomLeft.y);
+    else
+        rlVertex2f(destTopRight.x, destTopRight.y);
+}
+
+void DrawTileBatch(RaytmxTileBatch* batch) {
+    /* Draw the quads in the order they were batched so that overlapping tiles keep their render order. A texture */
+    /* is only bound, and a new run of quads only begun, where the texture changes. rlgl merges each run into one */
+    /* draw call, and tiles of a layer mostly come from one tileset, so runs are long in practice. */
+    unsigned int textureId = 0;
+    for (uint32_t i = 0; i < batch->quadsLength; i++) {
+        const RaytmxTileQuad* quad = &batch->quads[i];
+        if (quad->textureId != textureId) { /* If this quad starts a new run */
+            if (textureId != 0)
+                rlEnd();
+            textureId = quad->textureId;
+            rlSetTexture(textureId);
+            rlBegin(RL_QUADS);
+            rlColor4ub(batch->tint.r, batch->tint.g, batch->tint.b, batch->tint.a);
+            rlNormal3f(0.0f, 0.0f, 1.0f); /* Normal vector pointing towards viewer */
+        }
+        EmitTileQuad(quad->texCoordsMin, quad->texCoordsMax, quad->dest, quad->flipX, quad->flipY, quad->flipDiag);
     }
-    rlEnd();
+    if (textureId != 0)
+        rlEnd();
     rlSetTexture(0);
+    batch->quadsLength = 0;
 }
 
-void DrawTMXLayerTile(const TmxMap* map, Rectangle viewport, uint32_t rawGid, int posX, int posY, Color tint) {
-    if (map == NULL || tint.a == 0)
+void BatchTMXLayerTile(RaytmxTileBatch* batch, const TmxMap* map, Rectangle viewport, uint32_t rawGid, int posX,
+                       int posY) {
+    if (map == NULL)
         return;
     
     bool isFlippedHorizontally, isFlippedVertically, isFlippedDiagonally, isRotatedHexagonal120;
@@ -3507,17 +5501,13 @@ void DrawTMXLayerTile(const TmxMap* map, Rectangle viewport, uint32_t rawGid, in
                           &isRotatedHexagonal120);
     if (gid >= map->gidsToTilesLength) /* If the GID is outside the range of known GIDs */
         return; /* Do not attempt to draw this time */
-    /* With the GID, grab the relevant tile information (texture, animation, etc.) from the global mapping */
-    TmxTile tile = map->gidsToTiles[gid];
-    if (tile.gid == 0) /* If the GID is not known to exist in any tilesets within the map */
+    /* With the GID, grab the few bytes needed to draw the tile from the compact counterpart of the global mapping */
+    const TmxTileDraw* tileDraw = &map->tileDraws[gid];
+    if ((tileDraw->flags & TILE_DRAW_EXISTS) == 0) /* If the GID is not known to exist in any tilesets within the map */
         return; /* Do not attempt to draw this tile */
-    if (tile.hasAnimation && tile.frameIndex < tile.animation.framesLength &&
-        tile.animation.frames[tile.frameIndex].gid < map->gidsToTilesLength) { /* If the tile is/has an animation */
-        /* Animation tiles are meta; they contain a list of other GIDs to be drawn. Get the actual tile to draw this */
-        /* frame from that list. */
-        gid = tile.animation.frames[tile.frameIndex].gid;
-        if (gid < map->gidsToTilesLength)
-            tile = map->gidsToTiles[gid];
+    if (tileDraw->frameGid != gid && tileDraw->frameGid < map->gidsToTilesLength) { /* If the tile is an animation */
+        /* Animation tiles are meta. The GID of the tile to draw this frame is kept up to date by AnimateTMX(). */
+        tileDraw = &map->tileDraws[tileDraw->frameGid];
     }
     
     /* Determine where the tile will be drawn. raylib's coordinates consider [x, y] to be the top-left corner of the */
@@ -3526,16 +5516,27 @@ void DrawTMXLayerTile(const TmxMap* map, Rectangle viewport, uint32_t rawGid, in
     /* The simplest way to reconcile the Y coordinate differences is to substract the texture's height at Y + 1. This */
     /* way, tiles larger than the map's tile height values will be drawn further up (negative Y direction). */
     Rectangle destRect;
-    destRect.x = posX + tile.offset.x;
-    destRect.y = posY + tile.offset.y + map->tileHeight - tile.sourceRect.height;
-    destRect.width = tile.sourceRect.width;
-    destRect.height = tile.sourceRect.height;
+    destRect.x = (float)(posX + tileDraw->offsetX);
+    destRect.y = (float)(posY + tileDraw->offsetY) + (float)map->tileHeight - (float)tileDraw->height;
+    destRect.width = (float)tileDraw->width;
+    destRect.height = (float)tileDraw->height;
     
     /* If the viewport and destination rectangles are overlapping to any degree (i.e. if the tile is visible) */
-    if (CheckCollisionRecs(viewport, destRect)) {
-        DrawTextureTile(/* texture: */ tile.texture, /* source: */ tile.sourceRect, /* dest: */ destRect,
-                        /* flipX: */ isFlippedHorizontally, /* flipY: */ isFlippedVertically, /* flipDiag: */ isFlippedDiagonally,
-                        /* tint: */ tint);
+    unsigned int textureId = map->tileTextures[tileDraw->textureIndex].id;
+    if (textureId != 0 && CheckCollisionRecs(viewport, destRect)) {
+        if (batch->quadsLength == TMX_TILE_BATCH_SIZE) /* If the batch is full */
+            DrawTileBatch(batch);
+        const float scale = 1.0f / (float)UINT16_MAX; /* Texture coordinates are packed into 16 bits each */
+        RaytmxTileQuad* quad = &batch->quads[batch->quadsLength++];
+        quad->textureId = textureId;
+        quad->dest = destRect;
+        quad->texCoordsMin.x = (float)tileDraw->texCoords[0] * scale;
+        quad->texCoordsMin.y = (float)tileDraw->texCoords[1] * scale;
+        quad->texCoordsMax.x = (float)tileDraw->texCoords[2] * scale;
+        quad->texCoordsMax.y = (float)tileDraw->texCoords[3] * scale;
+        quad->flipX = isFlippedHorizontally;
+        quad->flipY = isFlippedVertically;
+        quad->flipDiag = isFlippedDiagonally;
     }
 }
 
@@ -3575,7 +5576,8 @@ void DrawTMXObjectTile(const TmxMap* map, Rectangle viewport, uint32_t rawGid, i
     
     /* If the viewport and destination rectangles are overlapping to any degree (i.e. if the tile is visible) */
     if (CheckCollisionRecs(viewport, destRect)) {
-        DrawTextureTile(/* texture: */ tile.texture, /* source: */ tile.sourceRect, /* dest: */ destRect,
+        DrawTextureTile(/* texture: */ tile.texture, /* texCoordsMin: */ tile.texCoordsMin,
+                        /* texCoordsMax: */ tile.texCoordsMax, /* dest: */ destRect,
                         /* flipX: */ isFlippedHorizontally, /* flipY: */ isFlippedVertically, /* flipDiag: */ isFlippedDiagonally,
                         /* tint: */ tint);
     }
@@ -3964,23 +5966,23 @@ bool CheckCollisionTMXTileLayerObject(const TmxMap* map, const TmxLayer* layers,
     /* Iterate through each layer and check their tiles for collisions with the given object */
     for (uint32_t i = 0; i < layersLength; i++) {
         if (layers[i].type == LAYER_TYPE_TILE_LAYER) { /* If the layer has tiles */
+            const TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+            if (tileLayer->solidBits != NULL) { /* If the layer's collision bitmaps were baked */
+                if (CheckCollisionTMXTileLayerBits(map, tileLayer, object, outputObject))
+                    return true;
+                continue;
+            }
             /* Iterate through each tile that the object's Axis-Aligned Bounding Box (AABB) overlaps with */
-            TmxTile tile;
+            TmxTileLayerIterator iterator;
+            InitTMXTileLayerIterator(&iterator, map, tileLayer, object.aabb);
+            uint32_t rawGid;
             Rectangle tileRect;
-            while (IterateTileLayer(/* map: */ map, /* layer: */ &layers[i].exact.tileLayer,
-                                    /* viewport: */ object.aabb, /* rawGid: */ NULL, /* tile: */ &tile, /* tileRect: */ &tileRect)) {
-                /* Iterate through each object associated with the tile */
-                for (uint32_t j = 0; j < tile.objectGroup.objectsLength; j++) {
-                    /* This object, the tile's collision information, has a relative position so this object must be */
-                    /* translated to the position of the tile as it would be drawn with the layer */
-                    TmxObject positionedObject = TranslateObject(tile.objectGroup.objects[j], tileRect.x, tileRect.y);
-                    /* If this tile's object collides with the given object */
-                    if (CheckCollisionTMXObjects(positionedObject, object)) {
-                        if (outputObject != NULL)
-                            *outputObject = positionedObject;
-                        return true; /* Found a collision. Exit now to save some CPU cycles. */
-                    }
-                }
+            while (NextTMXTileLayerTile(/* iterator: */ &iterator, /* rawGid: */ &rawGid, /* tile: */ NULL,
+                                        /* tileRect: */ &tileRect)) {
+                uint32_t gid = GetGid(rawGid, NULL, NULL, NULL, NULL);
+                if (gid < map->gidsToTilesLength &&
+                    CheckCollisionTMXTileObjects(&map->gidsToTiles[gid], tileRect, object, outputObject))
+                    return true; /* Found a collision. Exit now to save some CPU cycles. */
             }
         } else if (layers[i].type == LAYER_TYPE_GROUP) { /* If the layer contains other layers */
             if (CheckCollisionTMXTileLayerObject(map, layers[i].layers, layers[i].layersLength, object, outputObject))
@@ -3988,28 +5990,877 @@ bool CheckCollisionTMXTileLayerObject(const TmxMap* map, const TmxLayer* layers,
         }
     }
     
-    return false;
+    return false;
+}
+
+/**
+ * Helper function for checking for collisions between a tile layer, using its baked collision bitmaps, and an object
+ * of arbitrary type. Tiles are visited in the same order, and with the same results, as with an iterator over the
+ * object's Axis-Aligned Bounding Box (AABB). Rows and words of the bitmaps without set bits are skipped.
+ *
+ * @param map A loaded map model containing the given layer.
+ * @param layer A tile layer whose 'solidBits' and 'shapeBits' are not NULL.
+ * @param object A TMX <object> to be checked for a collision.
+ * @param outputObject Output parameter assigned with the object in the tile layer that the given object collided with.
+ *                     NULL if not wanted.
+ * @return True if the tile layer collides with the given object, or false if there is no collision.
+ */
+bool CheckCollisionTMXTileLayerBits(const TmxMap* map, const TmxTileLayer* layer, TmxObject object,
+                                    TmxObject* outputObject) {
+    if (map->width == 0 || map->height == 0 || map->tileWidth == 0 || map->tileHeight == 0)
+        return false;
+    
+    /* The tiles an iterator would visit: those the AABB overlaps, or touches, restrained to the layer */
+    Rectangle aabb = object.aabb;
+    int maxX = (int)map->width - 1, maxY = (int)map->height - 1;
+    int tileWidth = (int)map->tileWidth, tileHeight = (int)map->tileHeight;
+    int left = Clampi((int)floorf(aabb.x / (float)tileWidth), 0, maxX);
+    int top = Clampi((int)floorf(aabb.y / (float)tileHeight), 0, maxY);
+    int right = Clampi((int)floorf((aabb.x + aabb.width) / (float)tileWidth), 0, maxX);
+    int bottom = Clampi((int)floorf((aabb.y + aabb.height) / (float)tileHeight), 0, maxY);
+    if (right < left || bottom < top)
+        return false;
+    
+    /* A box or point collides with a solid tile exactly when it overlaps the tile's cell, not counting the cell's */
+    /* edges. When the object colliding with isn't wanted, that's a bit test, a word at a time, of the cells within. */
+    bool isBox = object.type == OBJECT_TYPE_RECTANGLE || object.type == OBJECT_TYPE_ELLIPSE ||
+                 object.type == OBJECT_TYPE_TEXT || object.type == OBJECT_TYPE_TILE || object.type == OBJECT_TYPE_POINT;
+    bool testSolid = !isBox || outputObject != NULL;
+    if (!testSolid) {
+        int solidLeft = left, solidTop = top, solidRight = right, solidBottom = bottom;
+        if ((float)((solidLeft + 1) * tileWidth) <= aabb.x) /* If the AABB only touches the first column */
+            solidLeft++;
+        if ((float)((solidTop + 1) * tileHeight) <= aabb.y) /* If the AABB only touches the first row */
+            solidTop++;
+        if ((float)(solidRight * tileWidth) >= aabb.x + aabb.width) /* If the AABB only touches the last column */
+            solidRight--;
+        if ((float)(solidBottom * tileHeight) >= aabb.y + aabb.height) /* If the AABB only touches the last row */
+            solidBottom--;
+        if (solidLeft <= solidRight) {
+            for (int y = solidTop; y <= solidBottom; y++) {
+                if (AnyTileBits(&layer->solidBits[(size_t)y * layer->bitsStride], solidLeft, solidRight))
+                    return true;
+            }
+        }
+    }
+    
+    /* Every other tile with collision shapes has them tested, in render order so that the first collision found is */
+    /* the one the iterator would find */
+    int fromX = left, toX = right, fromY = top, toY = bottom;
+    if (map->renderOrder == RENDER_ORDER_LEFT_DOWN || map->renderOrder == RENDER_ORDER_LEFT_UP) {
+        fromX = right;
+        toX = left;
+    }
+    if (map->renderOrder == RENDER_ORDER_RIGHT_UP || map->renderOrder == RENDER_ORDER_LEFT_UP) {
+        fromY = bottom;
+        toY = top;
+    }
+    int stepX = SIGN(toX - fromX), stepY = SIGN(toY - fromY);
+    for (int y = fromY; (y - toY) * stepY <= 0; y += stepY) {
+        const uint64_t* solidRow = &layer->solidBits[(size_t)y * layer->bitsStride];
+        const uint64_t* shapeRow = &layer->shapeBits[(size_t)y * layer->bitsStride];
+        if (!AnyTileBits(shapeRow, left, right) && !(testSolid && AnyTileBits(solidRow, left, right)))
+            continue; /* Nothing in this row to test */
+        for (int x = fromX; (x - toX) * stepX <= 0; x += stepX) {
+            uint64_t bit = (uint64_t)1 << (x & 63);
+            if ((shapeRow[x >> 6] & bit) == 0 && !(testSolid && (solidRow[x >> 6] & bit) != 0))
+                continue;
+            size_t index = ((size_t)y * map->width) + (size_t)x;
+            if (index >= layer->tilesLength)
+                return false;
+            Rectangle tileRect = {(float)(x * tileWidth), (float)(y * tileHeight), (float)tileWidth,
+                                  (float)tileHeight};
+            if (CheckCollisionTMXTileObjects(&map->gidsToTiles[GetGid(layer->tiles[index], NULL, NULL, NULL, NULL)],
+                                             tileRect, object, outputObject))
+                return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * Helper function for checking for collisions between a tile's collision shapes, placed in the given cell, and an
+ * object of arbitrary type.
+ *
+ * @param tile The tile whose object group will be checked for collisions.
+ * @param tileRect The tile's destination rectangle, in pixels, within its layer.
+ * @param object A TMX <object> to be checked for a collision.
+ * @param outputObject Output parameter assigned with the translated object of the tile that the given object collided
+ *                     with. NULL if not wanted.
+ * @return True if one of the tile's objects collides with the given object, or false if there is no collision.
+ */
+bool CheckCollisionTMXTileObjects(const TmxTile* tile, Rectangle tileRect, TmxObject object, TmxObject* outputObject) {
+    /* Iterate through each object associated with the tile */
+    for (uint32_t i = 0; i < tile->objectGroup.objectsLength; i++) {
+        /* This object, the tile's collision information, has a relative position so this object must be translated */
+        /* to the position of the tile as it would be drawn with the layer */
+        TmxObject positionedObject = TranslateObject(tile->objectGroup.objects[i], tileRect.x, tileRect.y);
+        /* If this tile's object collides with the given object */
+        if (CheckCollisionTMXObjects(positionedObject, object)) {
+            if (outputObject != NULL)
+                *outputObject = positionedObject;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/* Whether any bit for the tiles from 'fromX' to 'toX', inclusive, is set within a row of a collision bitmap */
+bool AnyTileBits(const uint64_t* row, int fromX, int toX) {
+    int firstWord = fromX >> 6, lastWord = toX >> 6;
+    uint64_t firstMask = ~(uint64_t)0 << (fromX & 63), lastMask = ~(uint64_t)0 >> (63 - (toX & 63));
+    if (firstWord == lastWord)
+        return (row[firstWord] & firstMask & lastMask) != 0;
+    if ((row[firstWord] & firstMask) != 0 || (row[lastWord] & lastMask) != 0)
+        return true;
+    for (int i = firstWord + 1; i < lastWord; i++) {
+        if (row[i] != 0)
+            return true;
+    }
+    return false;
+}
+
+/* Classifies every GID by its collision shapes, then bakes each tile layer's bitmaps of solid tiles and tiles with */
+/* other shapes from those classes */
+void BakeTileCollisionBits(TmxMap* map) {
+    if (map->gidsToTilesLength == 0)
+        return;
+    
+    uint8_t* gidShapes = (uint8_t*)MemAllocZero((unsigned int)map->gidsToTilesLength);
+    float tileWidth = (float)map->tileWidth, tileHeight = (float)map->tileHeight;
+    for (uint32_t gid = 1; gid < map->gidsToTilesLength; gid++) {
+        const TmxObjectGroup* objectGroup = &map->gidsToTiles[gid].objectGroup;
+        if (objectGroup->objectsLength == 0)
+            continue;
+        /* A tile is solid if one of its rectangles covers the cell it's drawn in and none of its shapes reach past */
+        /* the cell. Shapes that reach past it can collide with things that merely touch the cell. */
+        bool fillsCell = false, withinCell = true;
+        for (uint32_t i = 0; i < objectGroup->objectsLength; i++) {
+            Rectangle aabb = objectGroup->objects[i].aabb;
+            if (objectGroup->objects[i].type == OBJECT_TYPE_RECTANGLE && aabb.x <= 0.0f && aabb.y <= 0.0f &&
+                aabb.x + aabb.width >= tileWidth && aabb.y + aabb.height >= tileHeight)
+                fillsCell = true;
+            if (aabb.x < 0.0f || aabb.y < 0.0f || aabb.x + aabb.width > tileWidth || aabb.y + aabb.height > tileHeight)
+                withinCell = false;
+        }
+        gidShapes[gid] = (uint8_t)(fillsCell && withinCell ? TILE_SHAPES_SOLID : TILE_SHAPES_PARTIAL);
+    }
+    
+    BakeLayerCollisionBits(map, map->layers, map->layersLength, gidShapes);
+    MemFree(gidShapes);
+}
+
+void BakeLayerCollisionBits(TmxMap* map, TmxLayer* layers, uint32_t layersLength, const uint8_t* gidShapes) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_GROUP) {
+            BakeLayerCollisionBits(map, layers[i].layers, layers[i].layersLength, gidShapes);
+            continue;
+        }
+        TmxTileLayer* tileLayer = &layers[i].exact.tileLayer;
+        /* Chunks of infinite maps are decoded and evicted at runtime so their tiles are left to the iterator */
+        if (layers[i].type != LAYER_TYPE_TILE_LAYER || tileLayer->tiles == NULL || tileLayer->chunksLength > 0 ||
+            map->width == 0 || map->height == 0)
+            continue;
+        
+        uint32_t stride = (map->width + 63) / 64;
+        size_t bitmapSize = sizeof(uint64_t) * stride * map->height;
+        tileLayer->solidBits = (uint64_t*)ArenaAlloc(&map->arena, bitmapSize);
+        tileLayer->shapeBits = (uint64_t*)ArenaAlloc(&map->arena, bitmapSize);
+        if (tileLayer->solidBits == NULL || tileLayer->shapeBits == NULL) { /* Collisions check tile by tile instead */
+            tileLayer->solidBits = tileLayer->shapeBits = NULL;
+            continue;
+        }
+        tileLayer->bitsStride = stride;
+        for (uint32_t y = 0; y < map->height; y++) {
+            for (uint32_t x = 0; x < map->width; x++) {
+                size_t index = ((size_t)y * map->width) + x;
+                if (index >= tileLayer->tilesLength)
+                    break;
+                uint32_t gid = GetGid(tileLayer->tiles[index], NULL, NULL, NULL, NULL);
+                if (gid >= map->gidsToTilesLength || gidShapes[gid] == TILE_SHAPES_NONE)
+                    continue;
+                uint64_t* bitmap = gidShapes[gid] == TILE_SHAPES_SOLID ? tileLayer->solidBits : tileLayer->shapeBits;
+                bitmap[((size_t)y * stride) + (x >> 6)] |= (uint64_t)1 << (x & 63);
+            }
+        }
+    }
+}
+
+/**
+ * Helper function for checking for collisions between an object group and an object of arbitrary type.
+ *
+ * @param group The object group whose 0+ objects will be checked for collisions.
+ * @param object A TMX <object> to be checked for collision.
+ * @param outputObject Output parameter assigned with the object in the object group that the given object collided
+ *                     with. NULL if not wanted.
+ * @return True if an object in the object group collides with the given object, or false if there is no collision.
+ */
+bool CheckCollisionTMXObjectGroupObject(TmxObjectGroup group, TmxObject object, TmxObject* outputObject) {
+    if (group.bvh != NULL) { /* If the group has a hierarchy, only walk down the branches near the object */
+        uint32_t index = FindTMXObjectGroupBvhCollision(&group, &object);
+        if (index == TMX_NO_OBJECT)
+            return false;
+        if (outputObject != NULL)
+            *outputObject = group.objects[index];
+        return true;
+    }
+    
+    for (size_t i = 0; i < group.objectsLength; i++) {
+        if (CheckCollisionTMXObjects(group.objects[i], object)) {
+            if (outputObject != NULL)
+                *outputObject = group.objects[i];
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/**
+ * Build a uniform grid over the Axis-Aligned Bounding Boxes (AABBs) of the given object group's objects. The grid covers
+ * the union of all AABBs. Objects are bucketed by counting sort so each cell's indexes are contiguous and ascending.
+ *
+ * @param arena The arena the grid and its arrays are allocated from.
+ * @param group The object group whose objects' AABBs will be indexed.
+ * @param cellWidth Desired width of a cell in pixels. Enlarged if the grid would exceed TMX_GRID_MAX_CELLS.
+ * @param cellHeight Desired height of a cell in pixels. Enlarged if the grid would exceed TMX_GRID_MAX_CELLS.
+ * @return A grid that lives as long as the arena, or NULL if the group has no objects or memory ran out.
+ */
+TmxObjectGrid* BuildObjectGroupGrid(RaytmxArena** arena, const TmxObjectGroup* group, float cellWidth,
+                                    float cellHeight) {
+    if (group->objectsLength == 0)
+        return NULL;
+    if (cellWidth <= 0.0f)
+        cellWidth = 128.0f;
+    if (cellHeight <= 0.0f)
+        cellHeight = 128.0f;
+
+    /* Find the union of all AABBs. This is the area the grid needs to cover. */
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (uint32_t i = 0; i < group->objectsLength; i++) {
+        Rectangle aabb = group->objects[i].aabb;
+        if (minX > aabb.x)
+            minX = aabb.x;
+        if (minY > aabb.y)
+            minY = aabb.y;
+        if (maxX < aabb.x + aabb.width)
+            maxX = aabb.x + aabb.width;
+        if (maxY < aabb.y + aabb.height)
+            maxY = aabb.y + aabb.height;
+    }
+
+    /* Size the grid, doubling the cell dimensions while the cell count is unreasonable for the given area */
+    uint32_t columns, rows;
+    while (true) {
+        columns = (uint32_t)((maxX - minX) / cellWidth) + 1;
+        rows = (uint32_t)((maxY - minY) / cellHeight) + 1;
+        if ((uint64_t)columns * rows <= TMX_GRID_MAX_CELLS)
+            break;
+        cellWidth *= 2.0f;
+        cellHeight *= 2.0f;
+    }
+
+    TmxObjectGrid* grid = (TmxObjectGrid*)ArenaAlloc(arena, sizeof(TmxObjectGrid));
+    if (grid == NULL)
+        return NULL;
+    grid->originX = minX;
+    grid->originY = minY;
+    grid->cellWidth = cellWidth;
+    grid->cellHeight = cellHeight;
+    grid->columns = columns;
+    grid->rows = rows;
+    grid->cellStarts = (uint32_t*)ArenaAlloc(arena, sizeof(uint32_t) * (columns * rows + 1));
+    if (grid->cellStarts == NULL)
+        return NULL;
+
+    /* First pass: count the objects overlapping each cell. Counts are stored one index ahead of their cell so that */
+    /* a prefix sum turns them directly into start offsets. */
+    for (uint32_t i = 0; i < group->objectsLength; i++) {
+        Rectangle aabb = group->objects[i].aabb;
+        uint32_t firstColumn = (uint32_t)((aabb.x - minX) / cellWidth),
+            lastColumn = (uint32_t)((aabb.x + aabb.width - minX) / cellWidth),
+            firstRow = (uint32_t)((aabb.y - minY) / cellHeight),
+            lastRow = (uint32_t)((aabb.y + aabb.height - minY) / cellHeight);
+        for (uint32_t row = firstRow; row <= lastRow && row < rows; row++) {
+            for (uint32_t column = firstColumn; column <= lastColumn && column < columns; column++)
+                grid->cellStarts[row * columns + column + 1]++;
+        }
+    }
+    for (uint32_t cell = 0; cell < columns * rows; cell++)
+        grid->cellStarts[cell + 1] += grid->cellStarts[cell];
+    grid->cellObjectsLength = grid->cellStarts[columns * rows];
+    grid->cellObjects = (uint32_t*)ArenaAlloc(arena, sizeof(uint32_t) * grid->cellObjectsLength);
+
+    /* Second pass: write each object's index into every cell it overlaps. Objects are visited in ascending order */
+    /* so every cell's indexes are in ascending order too. */
+    uint32_t* cellCursors = (uint32_t*)MemAllocZero(sizeof(uint32_t) * columns * rows);
+    if (grid->cellObjects == NULL || cellCursors == NULL) {
+        MemFree(cellCursors);
+        return NULL;
+    }
+    memcpy(cellCursors, grid->cellStarts, sizeof(uint32_t) * columns * rows);
+    for (uint32_t i = 0; i < group->objectsLength; i++) {
+        Rectangle aabb = group->objects[i].aabb;
+        uint32_t firstColumn = (uint32_t)((aabb.x - minX) / cellWidth),
+            lastColumn = (uint32_t)((aabb.x + aabb.width - minX) / cellWidth),
+            firstRow = (uint32_t)((aabb.y - minY) / cellHeight),
+            lastRow = (uint32_t)((aabb.y + aabb.height - minY) / cellHeight);
+        for (uint32_t row = firstRow; row <= lastRow && row < rows; row++) {
+            for (uint32_t column = firstColumn; column <= lastColumn && column < columns; column++)
+                grid->cellObjects[cellCursors[row * columns + column]++] = i;
+        }
+    }
+    MemFree(cellCursors);
+
+    return grid;
+}
+
+/**
+ * Build a structure-of-arrays copy of the Axis-Aligned Bounding Boxes (AABBs) of the given object group's objects.
+ *
+ * @param arena The arena the bounds and their arrays are allocated from.
+ * @param group The object group whose objects' AABBs will be copied.
+ * @return Bounds that live as long as the arena, or NULL if the group has no objects or memory ran out.
+ */
+TmxObjectBounds* BuildObjectGroupBounds(RaytmxArena** arena, const TmxObjectGroup* group) {
+    if (group->objectsLength == 0)
+        return NULL;
+    
+    /* Pad the arrays so that SIMD comparisons can always load whole vectors. The padding's boxes are inside out, */
+    /* with their minimums above their maximums, so that no comparison finds them overlapping anything. */
+    uint32_t length = (group->objectsLength + TMX_BOUNDS_PADDING - 1) / TMX_BOUNDS_PADDING * TMX_BOUNDS_PADDING;
+    TmxObjectBounds* bounds = (TmxObjectBounds*)ArenaAlloc(arena, sizeof(TmxObjectBounds));
+    if (bounds == NULL)
+        return NULL;
+    bounds->minX = (float*)ArenaAlloc(arena, sizeof(float) * length);
+    bounds->minY = (float*)ArenaAlloc(arena, sizeof(float) * length);
+    bounds->maxX = (float*)ArenaAlloc(arena, sizeof(float) * length);
+    bounds->maxY = (float*)ArenaAlloc(arena, sizeof(float) * length);
+    if (bounds->minX == NULL || bounds->minY == NULL || bounds->maxX == NULL || bounds->maxY == NULL)
+        return NULL;
+    bounds->length = length;
+    for (uint32_t i = group->objectsLength; i < length; i++) {
+        bounds->minX[i] = bounds->minY[i] = INFINITY;
+        bounds->maxX[i] = bounds->maxY[i] = -INFINITY;
+    }
+    
+    CopyObjectGroupBounds(bounds, group);
+    
+    return bounds;
+}
+
+void CopyObjectGroupBounds(TmxObjectBounds* bounds, const TmxObjectGroup* group) {
+    bounds->rectanglesOnly = true;
+    for (uint32_t i = 0; i < group->objectsLength; i++) {
+        if (group->objects[i].type != OBJECT_TYPE_RECTANGLE)
+            bounds->rectanglesOnly = false;
+        Rectangle aabb = group->objects[i].aabb;
+        bounds->minX[i] = aabb.x;
+        bounds->minY[i] = aabb.y;
+        bounds->maxX[i] = aabb.x + aabb.width;
+        bounds->maxY[i] = aabb.y + aabb.height;
+    }
+}
+
+/**
+ * Build a bounding volume hierarchy over the Axis-Aligned Bounding Boxes (AABBs) of the given object group's objects.
+ *
+ * @param arena The arena the hierarchy and its arrays are allocated from.
+ * @param group The object group whose objects' AABBs will be indexed.
+ * @return A hierarchy that lives as long as the arena, or NULL if the group has no objects or memory ran out.
+ */
+TmxObjectBvh* BuildObjectGroupBvh(RaytmxArena** arena, const TmxObjectGroup* group) {
+    if (group->objectsLength == 0)
+        return NULL;
+    
+    /* Every leaf lists at least one object so a tree over N objects never has more than 2N - 1 nodes */
+    TmxObjectBvh* bvh = (TmxObjectBvh*)ArenaAlloc(arena, sizeof(TmxObjectBvh));
+    if (bvh == NULL)
+        return NULL;
+    bvh->nodes = (TmxObjectBvhNode*)ArenaAlloc(arena, sizeof(TmxObjectBvhNode) * (2 * group->objectsLength - 1));
+    bvh->objectIndices = (uint32_t*)ArenaAlloc(arena, sizeof(uint32_t) * group->objectsLength);
+    if (bvh->nodes == NULL || bvh->objectIndices == NULL)
+        return NULL;
+    bvh->objectIndicesLength = group->objectsLength;
+    for (uint32_t i = 0; i < group->objectsLength; i++)
+        bvh->objectIndices[i] = i;
+    
+    BuildBvhNode(bvh, group->objects, 0, group->objectsLength, 0);
+    
+    return bvh;
+}
+
+/**
+ * Add a node, and everything beneath it, to a bounding volume hierarchy being built. The objects are split by binning
+ * their AABBs' centers along each axis and keeping the split with the lowest Surface Area Heuristic (SAH) cost, with
+ * perimeters standing in for areas. Past TMX_BVH_SAH_DEPTH, or when all centers coincide, they're split in half.
+ *
+ * @param bvh The hierarchy being built, whose 'nodes' array has room for the node and its descendants.
+ * @param objects The object group's 'objects' array.
+ * @param start Index into the hierarchy's 'objectIndices' of the first object beneath the node.
+ * @param count Number of objects beneath the node. At least one.
+ * @param depth Number of nodes above this one.
+ * @return The index of the new node within the 'nodes' array.
+ */
+uint32_t BuildBvhNode(TmxObjectBvh* bvh, const TmxObject* objects, uint32_t start, uint32_t count, uint32_t depth) {
+    uint32_t nodeIndex = bvh->nodesLength++;
+    TmxObjectBvhNode* node = &bvh->nodes[nodeIndex];
+    node->start = start;
+    node->count = count;
+    FitBvhNode(bvh, nodeIndex, objects);
+    if (count <= TMX_BVH_LEAF_OBJECTS)
+        return nodeIndex;
+    
+    uint32_t* indices = &bvh->objectIndices[start];
+    float centerMin[2] = {INFINITY, INFINITY}, centerMax[2] = {-INFINITY, -INFINITY};
+    for (uint32_t i = 0; i < count; i++) {
+        Rectangle aabb = objects[indices[i]].aabb;
+        float center[2] = {aabb.x + aabb.width * 0.5f, aabb.y + aabb.height * 0.5f};
+        for (int axis = 0; axis < 2; axis++) {
+            if (centerMin[axis] > center[axis])
+                centerMin[axis] = center[axis];
+            if (centerMax[axis] < center[axis])
+                centerMax[axis] = center[axis];
+        }
+    }
+    
+    /* Find the axis and the bin boundary along it with the cheapest split. Both sides of it hold objects. */
+    int bestAxis = -1;
+    uint32_t bestBin = 0;
+    float bestCost = INFINITY;
+    for (int axis = 0; axis < 2 && depth < TMX_BVH_SAH_DEPTH; axis++) {
+        float extent = centerMax[axis] - centerMin[axis];
+        float scale = (float)TMX_BVH_BINS / extent;
+        if (!(extent > 0.0f) || !(scale < INFINITY))
+            continue; /* Every center is at the same position along this axis so it can't be split along */
+        uint32_t binCounts[TMX_BVH_BINS] = {0};
+        float binMin[TMX_BVH_BINS][2], binMax[TMX_BVH_BINS][2];
+        for (int bin = 0; bin < TMX_BVH_BINS; bin++) {
+            binMin[bin][0] = binMin[bin][1] = INFINITY;
+            binMax[bin][0] = binMax[bin][1] = -INFINITY;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            Rectangle aabb = objects[indices[i]].aabb;
+            float center = axis == 0 ? aabb.x + aabb.width * 0.5f : aabb.y + aabb.height * 0.5f;
+            int bin = (int)((center - centerMin[axis]) * scale);
+            if (bin > TMX_BVH_BINS - 1)
+                bin = TMX_BVH_BINS - 1;
+            binCounts[bin]++;
+            float minimums[2] = {aabb.x, aabb.y}, maximums[2] = {aabb.x + aabb.width, aabb.y + aabb.height};
+            for (int side = 0; side < 2; side++) {
+                if (binMin[bin][side] > minimums[side])
+                    binMin[bin][side] = minimums[side];
+                if (binMax[bin][side] < maximums[side])
+                    binMax[bin][side] = maximums[side];
+            }
+        }
+        
+        /* Sweep from the right to learn the cost of everything after each boundary, then from the left */
+        float rightCosts[TMX_BVH_BINS];
+        uint32_t rightCount = 0;
+        float boxMin[2] = {INFINITY, INFINITY}, boxMax[2] = {-INFINITY, -INFINITY};
+        for (int bin = TMX_BVH_BINS - 1; bin > 0; bin--) {
+            rightCount += binCounts[bin];
+            for (int side = 0; side < 2; side++) {
+                boxMin[side] = binMin[bin][side] < boxMin[side] ? binMin[bin][side] : boxMin[side];
+                boxMax[side] = binMax[bin][side] > boxMax[side] ? binMax[bin][side] : boxMax[side];
+            }
+            rightCosts[bin] = rightCount == 0 ? 0.0f :
+                              (boxMax[0] - boxMin[0] + boxMax[1] - boxMin[1]) * (float)rightCount;
+        }
+        uint32_t leftCount = 0;
+        boxMin[0] = boxMin[1] = INFINITY;
+        boxMax[0] = boxMax[1] = -INFINITY;
+        for (int bin = 0; bin < TMX_BVH_BINS - 1; bin++) {
+            leftCount += binCounts[bin];
+            for (int side = 0; side < 2; side++) {
+                boxMin[side] = binMin[bin][side] < boxMin[side] ? binMin[bin][side] : boxMin[side];
+                boxMax[side] = binMax[bin][side] > boxMax[side] ? binMax[bin][side] : boxMax[side];
+            }
+            if (leftCount == 0 || leftCount == count)
+                continue; /* One side of this boundary would be empty */
+            float cost = (boxMax[0] - boxMin[0] + boxMax[1] - boxMin[1]) * (float)leftCount + rightCosts[bin + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = (uint32_t)bin;
+            }
+        }
+    }
+    
+    /* Move the objects left of the boundary to the front, or when there's no boundary just split them in half */
+    uint32_t leftCount = count / 2;
+    if (bestAxis >= 0) {
+        float scale = (float)TMX_BVH_BINS / (centerMax[bestAxis] - centerMin[bestAxis]);
+        uint32_t front = 0, back = count;
+        while (front < back) {
+            Rectangle aabb = objects[indices[front]].aabb;
+            float center = bestAxis == 0 ? aabb.x + aabb.width * 0.5f : aabb.y + aabb.height * 0.5f;
+            int bin = (int)((center - centerMin[bestAxis]) * scale);
+            if (bin > TMX_BVH_BINS - 1)
+                bin = TMX_BVH_BINS - 1;
+            if ((uint32_t)bin <= bestBin) {
+                front++;
+            } else {
+                uint32_t swap = indices[front];
+                indices[front] = indices[--back];
+                indices[back] = swap;
+            }
+        }
+        if (front > 0 && front < count) /* Always true unless rounding put a center in a different bin this time */
+            leftCount = front;
+    }
+    
+    /* The first child directly follows this node, so only the second child's index needs remembering */
+    BuildBvhNode(bvh, objects, start, leftCount, depth + 1);
+    node->start = BuildBvhNode(bvh, objects, start + leftCount, count - leftCount, depth + 1);
+    node->count = 0;
+    
+    return nodeIndex;
+}
+
+/* Set a leaf's box to the union of its objects' AABBs, or an inner node's to the union of its children's boxes */
+void FitBvhNode(TmxObjectBvh* bvh, uint32_t nodeIndex, const TmxObject* objects) {
+    TmxObjectBvhNode* node = &bvh->nodes[nodeIndex];
+    if (node->count == 0) { /* If this is an inner node, its children have already been fit */
+        const TmxObjectBvhNode *first = &bvh->nodes[nodeIndex + 1], *second = &bvh->nodes[node->start];
+        node->minX = first->minX < second->minX ? first->minX : second->minX;
+        node->minY = first->minY < second->minY ? first->minY : second->minY;
+        node->maxX = first->maxX > second->maxX ? first->maxX : second->maxX;
+        node->maxY = first->maxY > second->maxY ? first->maxY : second->maxY;
+        node->lowestObject = first->lowestObject < second->lowestObject ? first->lowestObject : second->lowestObject;
+        return;
+    }
+    
+    node->minX = node->minY = INFINITY;
+    node->maxX = node->maxY = -INFINITY;
+    node->lowestObject = TMX_NO_OBJECT;
+    for (uint32_t i = node->start; i < node->start + node->count; i++) {
+        uint32_t index = bvh->objectIndices[i];
+        Rectangle aabb = objects[index].aabb;
+        if (node->minX > aabb.x)
+            node->minX = aabb.x;
+        if (node->minY > aabb.y)
+            node->minY = aabb.y;
+        if (node->maxX < aabb.x + aabb.width)
+            node->maxX = aabb.x + aabb.width;
+        if (node->maxY < aabb.y + aabb.height)
+            node->maxY = aabb.y + aabb.height;
+        if (node->lowestObject > index)
+            node->lowestObject = index;
+    }
+}
+
+/* Refit every node's box to the objects' current AABBs. Children follow their parents so this goes back to front. */
+void RefitObjectGroupBvh(TmxObjectBvh* bvh, const TmxObject* objects) {
+    for (uint32_t i = bvh->nodesLength; i > 0; i--)
+        FitBvhNode(bvh, i - 1, objects);
+}
+
+/**
+ * Find the first object of an object group that collides with the given object, by walking down the group's bounding
+ * volume hierarchy. The same object is found as with CheckCollisionTMXObjectGroupObject(): branches whose objects all
+ * come after one already found are skipped, and of the two children the one with the earlier objects goes first.
+ *
+ * @param group An object group whose 'bvh' is not NULL.
+ * @param object A TMX <object> of any type to be checked for collisions.
+ * @return The index into the group's 'objects' array of the object collided with, or TMX_NO_OBJECT.
+ */
+uint32_t FindTMXObjectGroupBvhCollision(const TmxObjectGroup* group, const TmxObject* object) {
+    const TmxObjectBvh* bvh = group->bvh;
+    Rectangle aabb = object->aabb;
+    /* Box-shaped objects collide with boxes and points as their AABBs do, so only other shapes need further checks */
+    bool isBox = IsBoxObjectType(object->type) || object->type == OBJECT_TYPE_POINT;
+    uint32_t found = TMX_NO_OBJECT;
+    uint32_t stack[TMX_BVH_STACK_SIZE], stackLength = 0;
+    stack[stackLength++] = 0; /* Start from the root */
+    while (stackLength > 0) {
+        uint32_t nodeIndex = stack[--stackLength];
+        const TmxObjectBvhNode* node = &bvh->nodes[nodeIndex];
+        if (node->lowestObject >= found)
+            continue; /* Nothing beneath this node comes before what was already found */
+        if (node->minX > aabb.x + aabb.width || node->maxX < aabb.x || node->minY > aabb.y + aabb.height ||
+            node->maxY < aabb.y)
+            continue; /* Nothing beneath this node can collide with the object */
+        if (node->count == 0) { /* If this is an inner node, the child with the earlier objects goes on last */
+            uint32_t first = nodeIndex + 1, second = node->start;
+            bool secondIsEarlier = bvh->nodes[second].lowestObject < bvh->nodes[first].lowestObject;
+            stack[stackLength++] = secondIsEarlier ? first : second;
+            stack[stackLength++] = secondIsEarlier ? second : first;
+            continue;
+        }
+        for (uint32_t i = node->start; i < node->start + node->count; i++) {
+            uint32_t index = bvh->objectIndices[i];
+            const TmxObject* candidate = &group->objects[index];
+            if (index >= found || !CheckCollisionRecs(candidate->aabb, aabb))
+                continue;
+            if ((isBox && IsBoxObjectType(candidate->type)) || CheckCollisionTMXObjects(*candidate, *object))
+                found = index;
+        }
+    }
+    
+    return found;
+}
+
+/**
+ * Find when a line segment enters an axis-aligned box, with the same edge cases as CheckCollisionRecs() inverted:
+ * a segment along an edge enters, as does one that begins inside.
+ *
+ * @param from The point the segment begins at.
+ * @param delta The segment's end minus its beginning.
+ * @param minX Left edge of the box.
+ * @param minY Top edge of the box.
+ * @param maxX Right edge of the box.
+ * @param maxY Bottom edge of the box.
+ * @param entryTime Output parameter assigned with the fraction of the way along the segment at which it enters.
+ * @param normal Output parameter assigned with the normal of the edge entered through, or zero if the segment begins
+ *               inside. NULL if not wanted.
+ * @return True if the segment enters or begins inside the box.
+ */
+bool IntersectSegmentBox(Vector2 from, Vector2 delta, float minX, float minY, float maxX, float maxY,
+                         float* entryTime, Vector2* normal) {
+    float entry = 0.0f, exit = 1.0f;
+    Vector2 entryNormal = (Vector2){0.0f, 0.0f};
+    if (delta.x == 0.0f) {
+        if (from.x < minX || from.x > maxX)
+            return false;
+    } else {
+        /* Moving right enters through the left edge, and the other way around */
+        float nearTime = ((delta.x > 0.0f ? minX : maxX) - from.x) / delta.x;
+        float farTime = ((delta.x > 0.0f ? maxX : minX) - from.x) / delta.x;
+        if (nearTime > entry) {
+            entry = nearTime;
+            entryNormal = (Vector2){delta.x > 0.0f ? -1.0f : 1.0f, 0.0f};
+        }
+        if (farTime < exit)
+            exit = farTime;
+        if (entry > exit)
+            return false;
+    }
+    if (delta.y == 0.0f) {
+        if (from.y < minY || from.y > maxY)
+            return false;
+    } else {
+        float nearTime = ((delta.y > 0.0f ? minY : maxY) - from.y) / delta.y;
+        float farTime = ((delta.y > 0.0f ? maxY : minY) - from.y) / delta.y;
+        if (nearTime > entry) {
+            entry = nearTime;
+            entryNormal = (Vector2){0.0f, delta.y > 0.0f ? -1.0f : 1.0f};
+        }
+        if (farTime < exit)
+            exit = farTime;
+        if (entry > exit)
+            return false;
+    }
+    
+    *entryTime = entry;
+    if (normal != NULL)
+        *normal = entryNormal;
+    return true;
+}
+
+/**
+ * Find when a line segment first hits an object. Polygons and polylines are hit by their edges, or immediately for a
+ * polygon the segment begins inside of. Points are never hit. Every other type is hit by its AABB.
+ *
+ * @param object The TMX <object> the segment may hit.
+ * @param from The point the segment begins at.
+ * @param to The point the segment ends at.
+ * @param hitTime Output parameter assigned with the fraction of the way along the segment at which it hits.
+ * @param hitNormal Output parameter assigned with the unit normal, facing back along the segment, of the edge hit.
+ * @return True if the segment hits the object.
+ */
+bool IntersectSegmentTMXObject(const TmxObject* object, Vector2 from, Vector2 to, float* hitTime, Vector2* hitNormal) {
+    if (object->type == OBJECT_TYPE_POINT)
+        return false;
+    Rectangle aabb = object->aabb;
+    if ((from.x < aabb.x && to.x < aabb.x) || (from.x > aabb.x + aabb.width && to.x > aabb.x + aabb.width) ||
+        (from.y < aabb.y && to.y < aabb.y) || (from.y > aabb.y + aabb.height && to.y > aabb.y + aabb.height))
+        return false; /* Both ends are past the same edge of the AABB. Cheaper to rule out than by dividing. */
+    Vector2 delta = (Vector2){to.x - from.x, to.y - from.y};
+    float entryTime;
+    if (!IntersectSegmentBox(from, delta, aabb.x, aabb.y, aabb.x + aabb.width, aabb.y + aabb.height, &entryTime,
+                             hitNormal))
+        return false; /* Misses the AABB so it can't hit the shape within */
+    if (object->type != OBJECT_TYPE_POLYGON && object->type != OBJECT_TYPE_POLYLINE) {
+        *hitTime = entryTime;
+        return true;
+    }
+    
+    /* Polygon and polyline vertices are relative to the object's position. As loaded, a polygon's points are its */
+    /* centroid, its vertices, then its first vertex again, and a polyline's are its vertices then its first vertex */
+    /* again. Those extras are for drawing. The centroid isn't on the outline and a polyline doesn't close. */
+    Vector2 position = (Vector2){(float)object->x, (float)object->y};
+    uint32_t pointsLength = object->pointsLength;
+    bool isPolygon = object->type == OBJECT_TYPE_POLYGON;
+    if (isPolygon && pointsLength >= 4 &&
+        CheckCollisionPointPoly((Vector2){from.x - position.x, from.y - position.y}, object->points + 1,
+                                (int)pointsLength - 1)) {
+        *hitTime = entryTime; /* Zero, since beginning inside the polygon means beginning inside its AABB */
+        *hitNormal = (Vector2){0.0f, 0.0f};
+        return true;
+    }
+    
+    /* Each edge joins a point to the next. A polygon's start after the centroid and end back at its first vertex. A */
+    /* polyline's end at its last vertex, short of the repeated first one. */
+    uint32_t firstEdge = isPolygon ? 1 : 0;
+    uint32_t edgesEnd = pointsLength < 2 ? 0 : (isPolygon ? pointsLength - 1 : pointsLength - 2);
+    bool hit = false;
+    for (uint32_t i = firstEdge; i < edgesEnd; i++) {
+        Vector2 start = object->points[i], end = object->points[i + 1];
+        Vector2 edge = (Vector2){end.x - start.x, end.y - start.y};
+        float denominator = delta.x * edge.y - delta.y * edge.x;
+        if (denominator == 0.0f)
+            continue; /* Parallel, so the segment can at most slide along the edge without crossing it */
+        Vector2 offset = (Vector2){position.x + start.x - from.x, position.y + start.y - from.y};
+        float time = (offset.x * edge.y - offset.y * edge.x) / denominator;
+        float along = (offset.x * delta.y - offset.y * delta.x) / denominator;
+        if (time < 0.0f || time > 1.0f || along < 0.0f || along > 1.0f || (hit && time >= *hitTime))
+            continue;
+        hit = true;
+        *hitTime = time;
+        float length = sqrtf(edge.x * edge.x + edge.y * edge.y);
+        Vector2 normal = (Vector2){edge.y / length, -edge.x / length};
+        if (normal.x * delta.x + normal.y * delta.y > 0.0f)
+            normal = (Vector2){-normal.x, -normal.y};
+        *hitNormal = normal;
+    }
+    /* The edge can't be hit before the AABB is entered. Rounding can say otherwise, which would let a walk down a */
+    /* hierarchy skip a node whose box is entered after the hit. */
+    if (hit && *hitTime < entryTime)
+        *hitTime = entryTime;
+    
+    return hit;
 }
 
 /**
- * Helper function for checking for collisions between an object group and an object of arbitrary type.
+ * Find the first object of an object group that collides with the given rectangle or point. The same object is found
+ * as with CheckCollisionTMXObjectGroupObject() but the AABBs are compared using the group's hierarchy or bounds, if it
+ * has them, and box-shaped objects need no further checks.
  *
  * @param group The object group whose 0+ objects will be checked for collisions.
- * @param object A TMX <object> to be checked for collision.
- * @param outputObject Output parameter assigned with the object in the object group that the given object collided
- *                     with. NULL if not wanted.
- * @return True if an object in the object group collides with the given object, or false if there is no collision.
+ * @param object A rectangular or point TMX <object> to be checked for collisions.
+ * @return The index into the group's 'objects' array of the object collided with, or TMX_NO_OBJECT.
  */
-bool CheckCollisionTMXObjectGroupObject(TmxObjectGroup group, TmxObject object, TmxObject* outputObject) {
-    for (size_t i = 0; i < group.objectsLength; i++) {
-        if (CheckCollisionTMXObjects(group.objects[i], object)) {
-            if (outputObject != NULL)
-                *outputObject = group.objects[i];
-            return true;
-        }
+uint32_t FindTMXObjectGroupCollision(const TmxObjectGroup* group, TmxObject* object) {
+    if (group->bvh != NULL) /* Large groups have a hierarchy, which rules out far more objects at once */
+        return FindTMXObjectGroupBvhCollision(group, object);
+    
+    const TmxObjectBounds* bounds = group->bounds;
+    for (uint32_t i = 0; i < group->objectsLength; i++) {
+        if (bounds != NULL) { /* If the group has bounds, skip straight to the next object with an overlapping AABB */
+            i = NextOverlappingBounds(bounds, i, object->aabb.x, object->aabb.y, object->aabb.x + object->aabb.width,
+                                      object->aabb.y + object->aabb.height);
+            if (i >= group->objectsLength)
+                break;
+        } else if (!CheckCollisionRecs(group->objects[i].aabb, object->aabb))
+            continue;
+        /* The AABBs overlap, which is all it takes for a box to collide with a box or a point. Other shapes need */
+        /* their own checks. */
+        if ((bounds != NULL && bounds->rectanglesOnly) || IsBoxObjectType(group->objects[i].type) ||
+            CheckCollisionTMXObjects(group->objects[i], *object))
+            return i;
     }
     
-    return false;
+    return TMX_NO_OBJECT;
+}
+
+/**
+ * Find the first object, at or after the given index, whose AABB overlaps the given box in an object group's bounds.
+ * Overlapping means as CheckCollisionRecs() does: edges that only touch don't count.
+ *
+ * @param bounds The object group's bounds.
+ * @param start Index of the first object to compare.
+ * @param minX Left edge of the box to compare with. A point is a box with equal minimums and maximums.
+ * @param minY Top edge of the box.
+ * @param maxX Right edge of the box.
+ * @param maxY Bottom edge of the box.
+ * @return The index of the first overlapping object, or the bounds' 'length' if there is none.
+ */
+uint32_t NextOverlappingBounds(const TmxObjectBounds* bounds, uint32_t start, float minX, float minY, float maxX,
+                               float maxY) {
+#if defined(RAYTMX_AVX2)
+    __m256 queryMinX = _mm256_set1_ps(minX), queryMinY = _mm256_set1_ps(minY), queryMaxX = _mm256_set1_ps(maxX),
+        queryMaxY = _mm256_set1_ps(maxY);
+    for (uint32_t block = start & ~(uint32_t)7; block < bounds->length; block += 8) {
+        __m256 overlapsX = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&bounds->minX[block]), queryMaxX, _CMP_LT_OQ),
+                                         _mm256_cmp_ps(_mm256_loadu_ps(&bounds->maxX[block]), queryMinX, _CMP_GT_OQ));
+        __m256 overlapsY = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&bounds->minY[block]), queryMaxY, _CMP_LT_OQ),
+                                         _mm256_cmp_ps(_mm256_loadu_ps(&bounds->maxY[block]), queryMinY, _CMP_GT_OQ));
+        /* One bit per object of the block, ignoring those before the start */
+        uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_and_ps(overlapsX, overlapsY)) &
+                        ((uint32_t)0xFF << (start > block ? start - block : 0));
+        if (mask != 0)
+            return block + LowestSetBit(mask);
+    }
+#elif defined(RAYTMX_SSE)
+    __m128 queryMinX = _mm_set1_ps(minX), queryMinY = _mm_set1_ps(minY), queryMaxX = _mm_set1_ps(maxX),
+        queryMaxY = _mm_set1_ps(maxY);
+    for (uint32_t block = start & ~(uint32_t)3; block < bounds->length; block += 4) {
+        __m128 overlapsX = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&bounds->minX[block]), queryMaxX),
+                                      _mm_cmpgt_ps(_mm_loadu_ps(&bounds->maxX[block]), queryMinX));
+        __m128 overlapsY = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(&bounds->minY[block]), queryMaxY),
+                                      _mm_cmpgt_ps(_mm_loadu_ps(&bounds->maxY[block]), queryMinY));
+        /* One bit per object of the block, ignoring those before the start */
+        uint32_t mask = (uint32_t)_mm_movemask_ps(_mm_and_ps(overlapsX, overlapsY)) &
+                        ((uint32_t)0xF << (start > block ? start - block : 0));
+        if (mask != 0)
+            return block + LowestSetBit(mask);
+    }
+#elif defined(RAYTMX_NEON)
+    float32x4_t queryMinX = vdupq_n_f32(minX), queryMinY = vdupq_n_f32(minY), queryMaxX = vdupq_n_f32(maxX),
+        queryMaxY = vdupq_n_f32(maxY);
+    /* NEON has no movemask so each lane's all-ones or all-zeroes result is masked with that lane's bit, then summed */
+    static const uint32_t laneBits[4] = {1, 2, 4, 8};
+    uint32x4_t laneMasks = vld1q_u32(laneBits);
+    for (uint32_t block = start & ~(uint32_t)3; block < bounds->length; block += 4) {
+        uint32x4_t overlapsX = vandq_u32(vcltq_f32(vld1q_f32(&bounds->minX[block]), queryMaxX),
+                                         vcgtq_f32(vld1q_f32(&bounds->maxX[block]), queryMinX));
+        uint32x4_t overlapsY = vandq_u32(vcltq_f32(vld1q_f32(&bounds->minY[block]), queryMaxY),
+                                         vcgtq_f32(vld1q_f32(&bounds->maxY[block]), queryMinY));
+        /* One bit per object of the block, ignoring those before the start */
+        uint32_t mask = vaddvq_u32(vandq_u32(vandq_u32(overlapsX, overlapsY), laneMasks)) &
+                        ((uint32_t)0xF << (start > block ? start - block : 0));
+        if (mask != 0)
+            return block + LowestSetBit(mask);
+    }
+#else
+    for (uint32_t i = start; i < bounds->length; i++) {
+        if (bounds->minX[i] < maxX && bounds->maxX[i] > minX && bounds->minY[i] < maxY && bounds->maxY[i] > minY)
+            return i;
+    }
+#endif
+    return bounds->length;
+}
+
+/* Index of the lowest set bit of a non-zero mask */
+uint32_t LowestSetBit(uint32_t mask) {
+    uint32_t index = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+}
+
+/* Whether objects of the given type collide as their AABBs do, at least as far as CheckCollisionTMXObjects() goes */
+bool IsBoxObjectType(TmxObjectType type) {
+    return type == OBJECT_TYPE_RECTANGLE || type == OBJECT_TYPE_ELLIPSE || type == OBJECT_TYPE_TEXT ||
+           type == OBJECT_TYPE_TILE;
+}
+
+int CompareObjectIndexes(const void* a, const void* b) {
+    uint32_t indexA = *(const uint32_t*)a, indexB = *(const uint32_t*)b;
+    return (indexA > indexB) - (indexA < indexB);
+}
+
+int CompareObjectSortKeys(const void* a, const void* b) {
+    const RaytmxObjectSortKey *keyA = (const RaytmxObjectSortKey*)a, *keyB = (const RaytmxObjectSortKey*)b;
+    if (keyA->y != keyB->y)
+        return (keyA->y > keyB->y) - (keyA->y < keyB->y);
+    return (keyA->index > keyB->index) - (keyA->index < keyB->index);
 }
 
 void TraceLogTMXTilesets(int logLevel, TmxOrientation orientation, TmxTileset* tilesets, uint32_t tilesetsLength,
@@ -4205,6 +7056,10 @@ void TraceLogTMXLayers(int logLevel, TmxLayer* layers, uint32_t layersLength, in
                     TraceLog(logLevel, "%s    width: %u", padding, layer.exact.tileLayer.width);
                 if (layer.exact.tileLayer.height != 0)
                     TraceLog(logLevel, "%s    height: %u", padding, layer.exact.tileLayer.height);
+                if (layer.exact.tileLayer.chunksLength != 0) {
+                    TraceLog(logLevel, "%s    chunks: %u of %ux%u tiles", padding, layer.exact.tileLayer.chunksLength,
+                             layer.exact.tileLayer.chunkWidth, layer.exact.tileLayer.chunkHeight);
+                }
                 if (tmxLogFlags & LOG_SKIP_TILES)
                     TraceLog(logLevel, "%s    skipping %u tiles", padding, layer.exact.tileLayer.tilesLength);
                 else {
@@ -4368,7 +7223,7 @@ void TraceLogTMXObject(int logLevel, TmxObject object, int numSpaces) {
 }
 
 TmxProperty* AddProperty(RaytmxState* raytmxState) {
-    RaytmxPropertyNode* node = (RaytmxPropertyNode*)MemAllocZero(sizeof(RaytmxPropertyNode));
+    RaytmxPropertyNode* node = (RaytmxPropertyNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxPropertyNode));
     
     if (raytmxState->propertiesRoot == NULL)
         raytmxState->propertiesRoot = node;
@@ -4381,7 +7236,8 @@ TmxProperty* AddProperty(RaytmxState* raytmxState) {
 }
 
 void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid) {
-    RaytmxTileLayerTileNode* node = (RaytmxTileLayerTileNode*)MemAllocZero(sizeof(RaytmxTileLayerTileNode));
+    RaytmxTileLayerTileNode* node =
+    (RaytmxTileLayerTileNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxTileLayerTileNode));
     node->gid = gid;
     
     if (raytmxState->layerTilesRoot == NULL)
@@ -4392,8 +7248,215 @@ void AddTileLayerTile(RaytmxState* raytmxState, uint32_t gid) {
     raytmxState->layerTilesLength += 1;
 }
 
+/**
+ * Add the GIDs of decoded, and possibly decompressed, Base64 tile data to the current tile layer. The data is a series
+ * of little-endian, unsigned, 32-bit integers. If the layer's array was preallocated then the data is copied straight
+ * into it, otherwise a linked list node is added per GID.
+ *
+ * @param raytmxState The state of the parsing of the TMX document.
+ * @param data The decoded bytes.
+ * @param dataLength The number of decoded bytes. Four per GID.
+ * @return The number of GIDs found in the data. May differ from the number stored if the layer's array is too small.
+ */
+uint32_t AddTileLayerGids(RaytmxState* raytmxState, const unsigned char* data, int dataLength) {
+    uint32_t gidsLength = (uint32_t)dataLength / 4;
+    TmxTileLayer* tileLayer = raytmxState->tileLayer;
+    
+    if (tileLayer->tiles != NULL) {
+        /* raylib's platforms are all little-endian so the bytes already have the in-memory layout of the GIDs */
+        uint32_t copyLength = gidsLength < tileLayer->tilesLength ? gidsLength : tileLayer->tilesLength;
+        memcpy(tileLayer->tiles, data, sizeof(uint32_t) * copyLength);
+    } else {
+        for (uint32_t i = 0; i < gidsLength; i++) {
+            uint32_t gid;
+            memcpy(&gid, data + (i * 4), sizeof(uint32_t)); /* memcpy() as the data may not be aligned */
+            AddTileLayerTile(raytmxState, gid);
+        }
+    }
+    
+    return gidsLength;
+}
+
+TmxTileChunk* AddTileChunk(RaytmxState* raytmxState) {
+    RaytmxTileChunkNode* node = (RaytmxTileChunkNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxTileChunkNode));
+    
+    if (raytmxState->tileChunksRoot == NULL)
+        raytmxState->tileChunksRoot = node;
+    else
+        raytmxState->tileChunksTail->next = node;
+    raytmxState->tileChunksTail = node;
+    raytmxState->tileChunksLength += 1;
+    
+    return &node->chunk;
+}
+
+void BuildTileChunks(RaytmxState* raytmxState) {
+    TmxTileLayer* tileLayer = raytmxState->tileLayer;
+    RaytmxTileChunkNode* iterator = raytmxState->tileChunksRoot;
+    /* Tiled gives every chunk of a map the same size, its "chunk size" setting, and aligns them to multiples of it. */
+    /* A tile's chunk can then be found from its position alone. */
+    uint32_t chunkWidth = iterator->chunk.width, chunkHeight = iterator->chunk.height;
+    if (chunkWidth == 0 || chunkHeight == 0) {
+        TraceLog(LOG_WARNING, "RAYTMX: Layer \"%s\" has chunks without dimensions - the layer will be empty",
+                 raytmxState->layer->name);
+        return;
+    }
+    
+    /* Allocate the chunks and a hash table at most half full so that probing always finds an empty slot */
+    tileLayer->chunks = (TmxTileChunk*)ArenaAlloc(raytmxState->arena,
+                                                  sizeof(TmxTileChunk) * raytmxState->tileChunksLength);
+    tileLayer->chunkTableCapacity = 16;
+    while (tileLayer->chunkTableCapacity < raytmxState->tileChunksLength * 2)
+        tileLayer->chunkTableCapacity *= 2;
+    tileLayer->chunkTable = (uint32_t*)ArenaAlloc(raytmxState->arena,
+                                                  sizeof(uint32_t) * tileLayer->chunkTableCapacity);
+    if (tileLayer->chunks == NULL || tileLayer->chunkTable == NULL) {
+        TraceLog(LOG_WARNING, "RAYTMX: Out of memory for the chunks of layer \"%s\" - the layer will be empty",
+                 raytmxState->layer->name);
+        tileLayer->chunks = NULL;
+        tileLayer->chunkTable = NULL;
+        tileLayer->chunkTableCapacity = 0;
+        return;
+    }
+    tileLayer->chunkWidth = chunkWidth;
+    tileLayer->chunkHeight = chunkHeight;
+    
+    for (; iterator != NULL; iterator = iterator->next) {
+        TmxTileChunk chunk = iterator->chunk;
+        if (chunk.width != chunkWidth || chunk.height != chunkHeight || chunk.x % (int32_t)chunkWidth != 0 ||
+            chunk.y % (int32_t)chunkHeight != 0) {
+            TraceLog(LOG_WARNING, "RAYTMX: Skipping chunk at (%d, %d) of layer \"%s\" because its size or position "
+                     "doesn't match the layer's other chunks", chunk.x, chunk.y, raytmxState->layer->name);
+            continue;
+        }
+        
+        int32_t chunkX = chunk.x / (int32_t)chunkWidth, chunkY = chunk.y / (int32_t)chunkHeight;
+        if (FindTileChunk(tileLayer, chunkX, chunkY) != NULL) {
+            TraceLog(LOG_WARNING, "RAYTMX: Skipping duplicate chunk at (%d, %d) of layer \"%s\"", chunk.x, chunk.y,
+                     raytmxState->layer->name);
+            continue;
+        }
+        uint32_t slot = HashChunkCoordinates(chunkX, chunkY) & (tileLayer->chunkTableCapacity - 1);
+        while (tileLayer->chunkTable[slot] != 0) /* Linear probing */
+            slot = (slot + 1) & (tileLayer->chunkTableCapacity - 1);
+        tileLayer->chunks[tileLayer->chunksLength] = chunk;
+        tileLayer->chunkTable[slot] = ++tileLayer->chunksLength; /* Indexes are offset by one as zero means empty */
+        
+        if (tileLayer->chunksLength == 1) {
+            tileLayer->chunksMinX = tileLayer->chunksMaxX = chunkX;
+            tileLayer->chunksMinY = tileLayer->chunksMaxY = chunkY;
+        } else {
+            tileLayer->chunksMinX = chunkX < tileLayer->chunksMinX ? chunkX : tileLayer->chunksMinX;
+            tileLayer->chunksMinY = chunkY < tileLayer->chunksMinY ? chunkY : tileLayer->chunksMinY;
+            tileLayer->chunksMaxX = chunkX > tileLayer->chunksMaxX ? chunkX : tileLayer->chunksMaxX;
+            tileLayer->chunksMaxY = chunkY > tileLayer->chunksMaxY ? chunkY : tileLayer->chunksMaxY;
+        }
+    }
+}
+
+/* Decodes Base64-encoded tile data, decompressing it too if need be. The result is a series of little-endian, 32-bit */
+/* GIDs to be freed with MemFree(), or NULL if decoding failed. */
+unsigned char* DecodeTileData(const char* layerName, const char* content, const char* compression, int* dataLength) {
+    *dataLength = 0;
+    if (content == NULL)
+        return NULL;
+    
+    /* The data is a series of unsigned, 32-bit integers encoded as a Base64 string. But, XML considers everything */
+    /* between <data> and </data> to be content meaning there is probably some whitespace on both ends of the */
+    /* content we need to ignore. So, find the actual start: */
+    const char* encodedStart = content;
+    while (isspace(*encodedStart))
+        encodedStart++;
+    
+    /* With the string of encoded Base64 data trimmed, decode it */
+    int decodedLength;
+    unsigned char* decoded = DecodeDataBase64((const unsigned char*)encodedStart, &decodedLength);
+    if (decoded == NULL) {
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to decode Base64 data for layer \"%s\"", layerName);
+        return NULL;
+    }
+    if (compression == NULL) { /* If the Base64-encoded data is uncompressed */
+        *dataLength = decodedLength;
+        return decoded;
+    }
+    
+    /* If the Base-64encoded data is also compressed */
+    unsigned char* postHeaderDecoded = NULL;
+    if (strcmp(compression, "gzip") == 0) {
+        /* The first two bytes of a GZIP header are expected to be a magic number, 0x1F8B, identifying the format */
+        /* and the third is expected to indicate the compression method where 0x08 is DEFLATE. */
+        /* If these values are found, decompression can continue */
+        if (decoded[0] == 0x1F && decoded[1] == 0x8B && decoded[2] == 0x08) {
+            /* Skip past the GZIP header. The header is typically ten bytes. The bytes not checked are unimportant */
+            /* things like a timestamp and OS ID. Additional optional headers are possible but not used by Tiled so */
+            /* they are assumed to be missing. */
+            postHeaderDecoded = decoded + 10;
+        } else { /* If the GZIP header doesn't match a decompressable one */
+            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses GZIP compression but the stream's header doesn't "
+                     "indicate DEFLATE compression", layerName);
+        }
+    } else if (strcmp(compression, "zlib") == 0) {
+        /* The first byte of a ZLIB header is expected to be 0x78 where the 8 indicates the DEFLATE compression */
+        /* method and the 7 is "compression info" that indicates a 32K LZ77 window size and, in practice, cannot be */
+        /* anything else. */
+        /* If these values are found, decompression can continue */
+        if (decoded[0] == 0x78) {
+            /* Skip past the ZLIB header. The header is two bytes. */
+            postHeaderDecoded = decoded + 2;
+        } else { /* If the ZLIB header doesn't match a decompressable one */
+            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" uses ZLIB compression but the stream's header doesn't "
+                     "indicate DEFLATE compression", layerName);
+        }
+    } else {
+        TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" cannot be parsed because the compression method \"%s\" is "
+                 "unsupported", layerName, compression);
+    }
+    
+    unsigned char* decompressed = NULL;
+    if (postHeaderDecoded != NULL) {
+        /* "zlib" and "gzip" both use the DEFLATE algorithm and raylib provides a decompression function when it's */
+        /* built with SUPPORT_COMPRESSION_API (default) */
+        decompressed = DecompressData(postHeaderDecoded, decodedLength, dataLength);
+        if (decompressed == NULL || *dataLength <= 0) { /* raylib wasn't built with compression or allocation failed */
+            TraceLog(LOG_ERROR, "RAYTMX: Layer \"%s\" compressed with \"%s\" cannot be parsed because DEFLATE "
+                     "decompression failed - either raylib was not built with SUPPORT_COMPRESSION_API or memory "
+                     "allocation failed", layerName, compression);
+            if (decompressed != NULL)
+                MemFree(decompressed);
+            decompressed = NULL;
+            *dataLength = 0;
+        }
+    }
+    MemFree(decoded); /* Free the memory allocated by DecodeDataBase64() */
+    
+    return decompressed;
+}
+
+/* Decodes a Comma-Separated Value (CSV) list of GIDs into the given array. Returns how many GIDs were in the list, */
+/* which may be more than were stored. */
+uint32_t DecodeTileDataCsv(const char* content, uint32_t* gids, uint32_t gidsCapacity) {
+    uint32_t gidsDecoded = 0;
+    const char* iterator = content;
+    while (iterator != NULL && *iterator != '\0') { /* While not pointing to the end of the string */
+        if (*iterator < '0' || *iterator > '9') { /* Skip over commas and whitespace */
+            iterator++;
+            continue;
+        }
+        uint32_t gid = 0;
+        while (*iterator >= '0' && *iterator <= '9') {
+            gid = (gid * 10) + (uint32_t)(*iterator - '0');
+            iterator++;
+        }
+        if (gidsDecoded < gidsCapacity)
+            gids[gidsDecoded] = gid;
+        gidsDecoded++;
+    }
+    
+    return gidsDecoded;
+}
+
 TmxTileset* AddTileset(RaytmxState* raytmxState) {
-    RaytmxTilesetNode* node = (RaytmxTilesetNode*)MemAllocZero(sizeof(RaytmxTilesetNode));
+    RaytmxTilesetNode* node = (RaytmxTilesetNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxTilesetNode));
     
     if (raytmxState->tilesetsRoot == NULL)
         raytmxState->tilesetsRoot = node;
@@ -4406,7 +7469,8 @@ TmxTileset* AddTileset(RaytmxState* raytmxState) {
 }
 
 TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState) {
-    RaytmxTilesetTileNode* node = (RaytmxTilesetTileNode*)MemAllocZero(sizeof(RaytmxTilesetTileNode));
+    RaytmxTilesetTileNode* node =
+    (RaytmxTilesetTileNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxTilesetTileNode));
     
     if (raytmxState->tilesetTilesRoot == NULL)
         raytmxState->tilesetTilesRoot = node;
@@ -4419,7 +7483,8 @@ TmxTilesetTile* AddTilesetTile(RaytmxState* raytmxState) {
 }
 
 TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState) {
-    RaytmxAnimationFrameNode* node = (RaytmxAnimationFrameNode*)MemAllocZero(sizeof(RaytmxAnimationFrameNode));
+    RaytmxAnimationFrameNode* node =
+    (RaytmxAnimationFrameNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxAnimationFrameNode));
     
     if (raytmxState->animationFramesRoot == NULL)
         raytmxState->animationFramesRoot = node;
@@ -4432,7 +7497,7 @@ TmxAnimationFrame* AddAnimationFrame(RaytmxState* raytmxState) {
 }
 
 TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup) {
-    RaytmxLayerNode* node = (RaytmxLayerNode*)MemAllocZero(sizeof(RaytmxLayerNode));
+    RaytmxLayerNode* node = (RaytmxLayerNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxLayerNode));
     /* There are some non-zero default values for several layer attributes: */
     node->layer.opacity = 1.0;
     node->layer.visible = true;
@@ -4463,7 +7528,7 @@ TmxLayer* AddGenericLayer(RaytmxState* raytmxState, bool isGroup) {
 }
 
 TmxObject* AddObject(RaytmxState* raytmxState) {
-    RaytmxObjectNode* node = (RaytmxObjectNode*)MemAllocZero(sizeof(RaytmxObjectNode));
+    RaytmxObjectNode* node = (RaytmxObjectNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxObjectNode));
     /* <object> elements have one non-zero default value: */
     node->object.visible = true;
     
@@ -4486,7 +7551,7 @@ void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* lay
         groupLayer = &(groupNode->layer);
     
     /* Allocate the array and zerioze every index as initialization */
-    TmxLayer* layers = (TmxLayer*)MemAllocZero(sizeof(TmxLayer) * layersLength);
+    TmxLayer* layers = (TmxLayer*)ArenaAlloc(&map->arena, sizeof(TmxLayer) * layersLength);
     /* Copy the TmxLayers into the array */
     RaytmxLayerNode* layersIterator = layersRoot;
     for (uint32_t i = 0; layersIterator != NULL; i++) {
@@ -4505,44 +7570,299 @@ void AppendLayerTo(TmxMap* map, RaytmxLayerNode* groupNode, RaytmxLayerNode* lay
     }
 }
 
-RaytmxCachedTextureNode* LoadCachedTexture(RaytmxState* raytmxState, const char* fileName) {
+Texture2D LoadCachedTexture(RaytmxState* raytmxState, const char* fileName) {
+    Texture2D texture;
+    memset(&texture, 0, sizeof(Texture2D));
     if (raytmxState == NULL || fileName == NULL)
-        return NULL;
-    
-    /* First try to find an already-loaded texture identified by the file name */
-    RaytmxCachedTextureNode* cachedTextureNode = raytmxState->texturesRoot;
-    while (cachedTextureNode != NULL) {
-        /* If the file name associated with the node matches the given file name */
-        if (strcmp(cachedTextureNode->fileName, fileName) == 0)
-            return cachedTextureNode;
-        cachedTextureNode = cachedTextureNode->next;
-    }
+        return texture;
     
-    /* Try to load the texture */
+    /* Images are referenced relative to the document. The joined path is what identifies them in the cache. */
     char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
-    Texture2D texture = loadTextureOverride ? loadTextureOverride(fullPath) : LoadTexture(fullPath);
-    if (texture.id == 0) { /* If loading the texture failed */
+    if (asyncLoadOnThread != NULL) /* If on a worker thread, where images can be decoded but not uploaded */
+        return QueueAsyncTexture(asyncLoadOnThread, fullPath);
+    texture = LoadTextureTMX(fullPath);
+    if (texture.id == 0) /* If loading the texture failed */
         TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", fullPath);
-        return NULL;
+    
+    return texture;
+}
+
+int32_t FindCachedTexture(const char* fileName, uint32_t fileNameHash) {
+    if (textureCache.indexCapacity == 0)
+        return -1;
+    
+    uint32_t mask = textureCache.indexCapacity - 1;
+    for (uint32_t slot = fileNameHash & mask; textureCache.byFileName[slot] >= 0; slot = (slot + 1) & mask) {
+        RaytmxCachedTexture* cachedTexture = &textureCache.textures[textureCache.byFileName[slot]];
+        if (cachedTexture->fileNameHash == fileNameHash && strcmp(cachedTexture->fileName, fileName) == 0)
+            return textureCache.byFileName[slot];
+    }
+    return -1;
+}
+
+int32_t FindCachedTextureById(unsigned int id) {
+    if (textureCache.indexCapacity == 0)
+        return -1;
+    
+    uint32_t mask = textureCache.indexCapacity - 1;
+    for (uint32_t slot = (id * 2654435761u) & mask; textureCache.byTextureId[slot] >= 0; slot = (slot + 1) & mask) {
+        if (textureCache.textures[textureCache.byTextureId[slot]].texture.id == id)
+            return textureCache.byTextureId[slot];
+    }
+    return -1;
+}
+
+bool GrowTextureCache(void) {
+    uint32_t texturesCapacity = textureCache.texturesCapacity > 0 ? textureCache.texturesCapacity * 2 : 16;
+    uint32_t indexCapacity = texturesCapacity * 2; /* Keeps probe sequences short */
+    
+    /* Capacities are only raised once all three arrays have grown, so a failure leaves the cache as it was */
+    RaytmxCachedTexture* textures = (RaytmxCachedTexture*)MemRealloc(textureCache.textures,
+                                                                     (unsigned int)(sizeof(RaytmxCachedTexture) *
+                                                                                    texturesCapacity));
+    if (textures == NULL)
+        return false;
+    textureCache.textures = textures;
+    int32_t* byFileName = (int32_t*)MemRealloc(textureCache.byFileName,
+                                               (unsigned int)(sizeof(int32_t) * indexCapacity));
+    if (byFileName == NULL)
+        return false;
+    textureCache.byFileName = byFileName;
+    int32_t* byTextureId = (int32_t*)MemRealloc(textureCache.byTextureId,
+                                                (unsigned int)(sizeof(int32_t) * indexCapacity));
+    if (byTextureId == NULL)
+        return false;
+    textureCache.byTextureId = byTextureId;
+    
+    textureCache.texturesCapacity = texturesCapacity;
+    textureCache.indexCapacity = indexCapacity;
+    IndexTextureCache();
+    return true;
+}
+
+void IndexTextureCache(void) {
+    /* Every byte being 0xFF makes every slot -1, or empty */
+    memset(textureCache.byFileName, 0xFF, sizeof(int32_t) * textureCache.indexCapacity);
+    memset(textureCache.byTextureId, 0xFF, sizeof(int32_t) * textureCache.indexCapacity);
+    
+    uint32_t mask = textureCache.indexCapacity - 1;
+    for (uint32_t i = 0; i < textureCache.texturesLength; i++) {
+        uint32_t slot = textureCache.textures[i].fileNameHash & mask;
+        while (textureCache.byFileName[slot] >= 0)
+            slot = (slot + 1) & mask;
+        textureCache.byFileName[slot] = (int32_t)i;
+        
+        slot = (textureCache.textures[i].texture.id * 2654435761u) & mask;
+        while (textureCache.byTextureId[slot] >= 0)
+            slot = (slot + 1) & mask;
+        textureCache.byTextureId[slot] = (int32_t)i;
+    }
+}
+
+/* 32-bit FNV-1a */
+uint32_t HashFileName(const char* fileName) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char* character = (const unsigned char*)fileName; *character != '\0'; character++) {
+        hash ^= *character;
+        hash *= 16777619u;
     }
+    return hash;
+}
+
+/* Returns false, leaving the texture uncached, if there isn't the memory to add it */
+bool AddCachedTexture(const char* fileName, uint32_t fileNameHash, Texture2D texture) {
+    if (textureCache.texturesLength == textureCache.texturesCapacity && !GrowTextureCache())
+        return false;
     
-    /* Create a new node in the list of known textures */
-    cachedTextureNode = (RaytmxCachedTextureNode*)MemAllocZero(sizeof(RaytmxCachedTextureNode));
-    cachedTextureNode->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
-    StringCopy(cachedTextureNode->fileName, fileName);
-    cachedTextureNode->texture = texture;
+    RaytmxCachedTexture* cachedTexture = &textureCache.textures[textureCache.texturesLength];
+    cachedTexture->fileName = (char*)MemAlloc((unsigned int)(strlen(fileName) + 1));
+    if (cachedTexture->fileName == NULL)
+        return false;
+    StringCopy(cachedTexture->fileName, fileName);
+    cachedTexture->fileNameHash = fileNameHash;
+    cachedTexture->texture = texture;
+    cachedTexture->references = 1;
+    
+    /* Add it to both indexes */
+    uint32_t mask = textureCache.indexCapacity - 1, slot = fileNameHash & mask;
+    while (textureCache.byFileName[slot] >= 0)
+        slot = (slot + 1) & mask;
+    textureCache.byFileName[slot] = (int32_t)textureCache.texturesLength;
+    slot = (texture.id * 2654435761u) & mask;
+    while (textureCache.byTextureId[slot] >= 0)
+        slot = (slot + 1) & mask;
+    textureCache.byTextureId[slot] = (int32_t)textureCache.texturesLength;
+    textureCache.texturesLength++;
     
-    /* Add to the cache */
-    if (raytmxState->texturesRoot == NULL)
-        raytmxState->texturesRoot = cachedTextureNode;
-    else {
-        RaytmxCachedTextureNode* cachedTextureIterator = raytmxState->texturesRoot;
-        while (cachedTextureIterator->next != NULL)
-            cachedTextureIterator = cachedTextureIterator->next;
-        cachedTextureIterator->next = cachedTextureNode;
+    return true;
+}
+
+#ifdef _WIN32
+unsigned long __stdcall RunAsyncLoad(void* load) {
+#else
+void* RunAsyncLoad(void* load) {
+#endif
+    TmxAsyncLoad* asyncLoad = (TmxAsyncLoad*)load;
+    
+    /* LoadCachedTexture() queues images with this load, rather than loading textures, while this is set. It covers */
+    /* TSX and TX documents too since they're parsed on this thread with states of their own. */
+    asyncLoadOnThread = asyncLoad;
+    asyncLoad->map = LoadTMX(asyncLoad->fileName);
+    asyncLoadOnThread = NULL;
+    
+    RAYTMX_ATOMIC_STORE(asyncLoad->isParsed, 1);
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+void JoinAsyncLoad(TmxAsyncLoad* load) {
+#ifdef _WIN32
+    WaitForSingleObject(load->thread, 0xFFFFFFFF); /* INFINITE */
+    CloseHandle(load->thread);
+#else
+    pthread_join(load->thread, NULL);
+#endif
+    load->status = load->map != NULL ? ASYNC_LOAD_UPLOADING : ASYNC_LOAD_FAILED;
+}
+
+/* Called on the worker thread. Returns a placeholder to be swapped for the texture by ResolveAsyncTextures(). */
+Texture2D QueueAsyncTexture(TmxAsyncLoad* load, const char* fileName) {
+    Texture2D texture;
+    memset(&texture, 0, sizeof(Texture2D));
+    
+    /* Images shared by tilesets of the same map are only decoded once */
+    uint32_t index = 0;
+    while (index < load->texturesLength && strcmp(load->textures[index].fileName, fileName) != 0)
+        index++;
+    
+    if (index == load->texturesLength) { /* If the image is new to this load */
+        if (load->texturesLength == load->texturesCapacity) {
+            uint32_t capacity = load->texturesCapacity == 0 ? 8 : load->texturesCapacity * 2;
+            RaytmxPendingTexture* textures = (RaytmxPendingTexture*)MemRealloc(load->textures,
+                (unsigned int)(sizeof(RaytmxPendingTexture) * capacity));
+            if (textures == NULL) {
+                TraceLog(LOG_ERROR, "RAYTMX: Unable to queue texture \"%s\"", fileName);
+                return texture;
+            }
+            load->textures = textures;
+            load->texturesCapacity = capacity;
+        }
+        
+        RaytmxPendingTexture* pendingTexture = &load->textures[index];
+        memset(pendingTexture, 0, sizeof(RaytmxPendingTexture));
+        pendingTexture->fileName = (char*)MemAlloc((unsigned int)(strlen(fileName) + 1));
+        if (pendingTexture->fileName == NULL) {
+            TraceLog(LOG_ERROR, "RAYTMX: Unable to queue texture \"%s\"", fileName);
+            return texture;
+        }
+        StringCopy(pendingTexture->fileName, fileName);
+        /* A custom callback may not be safe to call from this thread so those images are loaded by the callback, */
+        /* on the loading thread, when it's their turn to be uploaded */
+        if (loadTextureOverride == NULL)
+            pendingTexture->image = LoadImage(fileName);
+        load->texturesLength++;
+    }
+    
+    /* Textures with an ID of zero are never drawn. The negative format identifies the image the texture is for. */
+    texture.width = load->textures[index].image.width;
+    texture.height = load->textures[index].image.height;
+    texture.format = -(int)(index + 1);
+    return texture;
+}
+
+/* Called on the loading thread. Every uploaded texture is cached or, failing that, discarded so that the textures */
+/* given to the map's images are always shared through the cache. */
+void UploadAsyncTexture(TmxAsyncLoad* load) {
+    RaytmxPendingTexture* pendingTexture = &load->textures[load->texturesUploaded++];
+    uint32_t fileNameHash = HashFileName(pendingTexture->fileName);
+    
+    if (pendingTexture->image.data != NULL && FindCachedTexture(pendingTexture->fileName, fileNameHash) < 0) {
+        pendingTexture->texture = LoadTextureFromImage(pendingTexture->image);
+        if (pendingTexture->texture.id != 0)
+            AddCachedTexture(pendingTexture->fileName, fileNameHash, pendingTexture->texture);
+    } else /* If another map already has it, a custom callback loads it, or it couldn't be decoded */
+        pendingTexture->texture = LoadTextureTMX(pendingTexture->fileName);
+    
+    if (pendingTexture->texture.id != 0 && FindCachedTextureById(pendingTexture->texture.id) < 0) {
+        UnloadTexture(pendingTexture->texture); /* Only without the memory to cache it */
+        memset(&pendingTexture->texture, 0, sizeof(Texture2D));
     }
+    if (pendingTexture->texture.id == 0)
+        TraceLog(LOG_ERROR, "RAYTMX: Unable to load texture \"%s\"", pendingTexture->fileName);
     
-    return cachedTextureNode;
+    if (pendingTexture->image.data != NULL)
+        UnloadImage(pendingTexture->image);
+    memset(&pendingTexture->image, 0, sizeof(Image));
+}
+
+/* 'isReference' is true for textures that are released by UnloadTMX() as opposed to copies of them */
+Texture2D ResolveAsyncTexture(const TmxAsyncLoad* load, Texture2D texture, bool isReference) {
+    if (texture.id != 0 || texture.format >= 0 || (uint32_t)-texture.format > load->texturesLength)
+        return texture; /* Not a placeholder */
+    
+    Texture2D resolved = load->textures[-texture.format - 1].texture;
+    if (isReference && resolved.id != 0) {
+        int32_t index = FindCachedTextureById(resolved.id);
+        if (index < 0) { /* Uploads are kept cached by the load's own reference. Without an entry, don't share it. */
+            memset(&resolved, 0, sizeof(Texture2D));
+            return resolved;
+        }
+        textureCache.textures[index].references++;
+    }
+    return resolved;
+}
+
+void ResolveAsyncLayerTextures(const TmxAsyncLoad* load, TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        if (layers[i].type == LAYER_TYPE_IMAGE_LAYER && layers[i].exact.imageLayer.hasImage) {
+            TmxImage* image = &layers[i].exact.imageLayer.image;
+            image->texture = ResolveAsyncTexture(load, image->texture, true);
+        }
+        ResolveAsyncLayerTextures(load, layers[i].layers, layers[i].layersLength);
+    }
+}
+
+/* Replaces every placeholder texture in the map once all textures are uploaded */
+void ResolveAsyncTextures(TmxAsyncLoad* load) {
+    TmxMap* map = load->map;
+    for (uint32_t i = 0; i < map->tilesetsLength; i++) {
+        TmxTileset* tileset = &map->tilesets[i];
+        if (tileset->hasImage)
+            tileset->image.texture = ResolveAsyncTexture(load, tileset->image.texture, true);
+        for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+            if (tileset->tiles[j].hasImage) {
+                TmxImage* image = &tileset->tiles[j].image;
+                image->texture = ResolveAsyncTexture(load, image->texture, true);
+            }
+        }
+    }
+    ResolveAsyncLayerTextures(load, map->layers, map->layersLength);
+    for (uint32_t gid = 0; gid < map->gidsToTilesLength; gid++)
+        map->gidsToTiles[gid].texture = ResolveAsyncTexture(load, map->gidsToTiles[gid].texture, false);
+    CalculateTileTexCoords(map); /* Placeholders of images that failed to decode had no dimensions */
+    PackTileDraws(map);
+    
+    /* Each image now holds a reference of its own so those held since uploading can be released */
+    for (uint32_t i = 0; i < load->texturesLength; i++) {
+        UnloadTextureTMX(load->textures[i].texture);
+        memset(&load->textures[i].texture, 0, sizeof(Texture2D));
+    }
+}
+
+/* Also releases whatever wasn't resolved if the load failed */
+void FreeAsyncLoad(TmxAsyncLoad* load) {
+    for (uint32_t i = 0; i < load->texturesLength; i++) {
+        if (load->textures[i].image.data != NULL)
+            UnloadImage(load->textures[i].image);
+        UnloadTextureTMX(load->textures[i].texture);
+        MemFree(load->textures[i].fileName);
+    }
+    MemFree(load->textures);
+    MemFree(load->fileName);
+    MemFree(load);
 }
 
 RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const char* fileName) {
@@ -4560,15 +7880,15 @@ RaytmxCachedTemplateNode* LoadCachedTemplate(RaytmxState* raytmxState, const cha
     
     /* Load the template from the external TX file */
     char* fullPath = JoinPath(raytmxState->documentDirectory, fileName);
-    RaytmxObjectTemplate objectTemplate = LoadTX(fullPath);
+    RaytmxObjectTemplate objectTemplate = LoadTX(raytmxState->arena, fullPath);
     if (!objectTemplate.isSuccess) { /* If loading the template failed */
         TraceLog(LOG_ERROR, "RAYTMX: Unable to load template \"%s\"", fullPath);
         return NULL;
     }
     
     /* Create a new node in the list of known templates */
-    cachedTemplateNode = (RaytmxCachedTemplateNode*)MemAllocZero(sizeof(RaytmxCachedTemplateNode));
-    cachedTemplateNode->fileName = (char*)MemAllocZero((unsigned int)strlen(fileName) + 1);
+    cachedTemplateNode = (RaytmxCachedTemplateNode*)ArenaAlloc(&raytmxState->scratch, sizeof(RaytmxCachedTemplateNode));
+    cachedTemplateNode->fileName = (char*)ArenaAlloc(&raytmxState->scratch, strlen(fileName) + 1);
     StringCopy(cachedTemplateNode->fileName, fileName);
     cachedTemplateNode->objectTemplate = objectTemplate;
     
@@ -4657,14 +7977,342 @@ uint32_t GetGid(uint32_t rawGid, bool* isFlippedHorizontally, bool* isFlippedVer
 
 void* MemAllocZero(unsigned int size) {
     void* buffer = MemAlloc(size); /* Reserve 'size' bytes of memory */
+    if (buffer != NULL)
+        memset(buffer, 0, size); /* Initialize any values to zero, NULL, false, or an equivalent enum value */
+    return buffer;
+}
+
+/**
+ * Allocate zeroed memory from the given arena, adding a region to it when the newest one is too full. Regions grow
+ * geometrically so that even large maps are parsed with a handful of calls to MemAlloc().
+ *
+ * @param arena Pointer to the arena's handle, a pointer to its newest region. The handle may be NULL for a new arena.
+ * @param size The number of bytes to allocate.
+ * @return Zeroed memory, aligned to TMX_ARENA_ALIGNMENT, that remains valid until the arena is freed, or NULL if a new
+ *         region was needed and couldn't be allocated. The arena is left as it was in that case.
+ */
+void* ArenaAlloc(RaytmxArena** arena, size_t size) {
+    /* Round the size up to the alignment, as the header is, so every allocation within a region stays aligned */
+    size = (size + TMX_ARENA_ALIGNMENT - 1) & ~(size_t)(TMX_ARENA_ALIGNMENT - 1);
+    
+    RaytmxArena* region = *arena;
+    if (region == NULL || region->capacity - region->used < size) { /* If a new region is needed */
+        size_t capacity = TMX_ARENA_REGION_SIZE;
+        if (region != NULL && capacity < region->capacity * 2)
+            capacity = region->capacity * 2;
+        if (capacity < size)
+            capacity = size;
+        RaytmxArena* newRegion = (RaytmxArena*)MemAlloc((unsigned int)(TMX_ARENA_HEADER_SIZE + capacity));
+        if (newRegion == NULL) {
+            TraceLog(LOG_ERROR, "RAYTMX: Unable to allocate a region of %zu bytes", capacity);
+            return NULL;
+        }
+        newRegion->previous = region;
+        newRegion->capacity = capacity;
+        newRegion->used = 0;
+        newRegion->mapping = NULL;
+        *arena = region = newRegion;
+    }
+    
+    void* buffer = GetArenaRegionData(region) + region->used;
+    region->used += size;
     memset(buffer, 0, size); /* Initialize any values to zero, NULL, false, or an equivalent enum value */
     return buffer;
 }
 
+void FreeArena(RaytmxArena* arena) {
+    while (arena != NULL) {
+        RaytmxArena* previous = arena->previous;
+        if (arena->mapping != NULL)
+            UnmapFile(arena->mapping, arena->capacity);
+        MemFree(arena);
+        arena = previous;
+    }
+}
+
+unsigned char* GetArenaRegionData(RaytmxArena* region) {
+    if (region->mapping != NULL)
+        return (unsigned char*)region->mapping;
+    return (unsigned char*)region + TMX_ARENA_HEADER_SIZE;
+}
+
+/* Map an entire file into memory as copy-on-write: readable and writable without the writes reaching the file */
+void* MapFile(const char* fileName, size_t* size) {
+    *size = 0;
+#ifdef _WIN32
+    void* file = CreateFileA(fileName, 0x80000000 /* GENERIC_READ */, 0x00000001 /* FILE_SHARE_READ */, NULL,
+                             3 /* OPEN_EXISTING */, 0x00000080 /* FILE_ATTRIBUTE_NORMAL */, NULL);
+    if (file == (void*)(intptr_t)-1) /* INVALID_HANDLE_VALUE */
+        return NULL;
+    unsigned long sizeHigh = 0, sizeLow = GetFileSize(file, &sizeHigh);
+    void* mapping = NULL;
+    void* fileMapping = CreateFileMappingA(file, NULL, 0x08 /* PAGE_WRITECOPY */, 0, 0, NULL);
+    if (fileMapping != NULL) {
+        mapping = MapViewOfFile(fileMapping, 0x0001 /* FILE_MAP_COPY */, 0, 0, 0);
+        CloseHandle(fileMapping); /* The view keeps the mapping alive */
+    }
+    CloseHandle(file);
+    if (mapping != NULL)
+        *size = (size_t)(((uint64_t)sizeHigh << 32) | sizeLow);
+    return mapping;
+#else
+    int file = open(fileName, O_RDONLY);
+    if (file < 0)
+        return NULL;
+    struct stat fileStat;
+    void* mapping = NULL;
+    if (fstat(file, &fileStat) == 0 && fileStat.st_size > 0) {
+        mapping = mmap(NULL, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        if (mapping == MAP_FAILED)
+            mapping = NULL;
+        else
+            *size = (size_t)fileStat.st_size;
+    }
+    close(file); /* The mapping remains valid after the file is closed */
+    return mapping;
+#endif /* _WIN32 */
+}
+
+void UnmapFile(void* mapping, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(mapping);
+#else
+    munmap(mapping, size);
+#endif /* _WIN32 */
+}
+
+/* Baked maps are copies of the models as they are in memory so the sizes of the models must match between builds */
+uint32_t GetBinaryLayoutHash(void) {
+    const size_t sizes[] = {
+        sizeof(void*), sizeof(TmxMap), sizeof(TmxTileset), sizeof(TmxTilesetTile), sizeof(TmxTile), sizeof(TmxLayer),
+        sizeof(TmxObjectGroup), sizeof(TmxObjectGrid), sizeof(TmxObject), sizeof(TmxText), sizeof(TmxTextLine),
+        sizeof(TmxProperty), sizeof(TmxImage), sizeof(TmxAnimationFrame), sizeof(TmxObjectBounds), sizeof(TmxObjectBvh),
+        sizeof(TmxObjectBvhNode)
+    };
+    uint32_t hash = 2166136261u; /* 32-bit FNV-1a */
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        hash ^= (uint32_t)sizes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Translate an address within the map's arena to an offset within the writer's copy of the arena */
+bool GetBinaryOffset(const RaytmxBinaryWriter* writer, const void* pointer, uint64_t* offset) {
+    const unsigned char* address = (const unsigned char*)pointer;
+    for (uint32_t i = 0; i < writer->regionsLength; i++) {
+        const unsigned char* regionData = GetArenaRegionData(writer->regions[i]);
+        /* The end is inclusive because zero-length allocations at the end of a region point there */
+        if (address >= regionData && address <= regionData + writer->regions[i]->used) {
+            *offset = writer->regionOffsets[i] + (uint64_t)(address - regionData);
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Given the address of a pointer within the map, rewrite the copy of it as an offset and record it as a relocation */
+void WriteBinaryPointer(RaytmxBinaryWriter* writer, const void* field) {
+    const void* pointer;
+    memcpy(&pointer, field, sizeof(void*));
+    if (pointer == NULL) /* NULL pointers are zero either way and aren't relocated */
+        return;
+    
+    uint64_t fieldOffset, pointerOffset;
+    if (!GetBinaryOffset(writer, field, &fieldOffset) || !GetBinaryOffset(writer, pointer, &pointerOffset)) {
+        writer->isSuccess = false;
+        return;
+    }
+    uintptr_t value = (uintptr_t)pointerOffset;
+    memcpy(writer->data + fieldOffset, &value, sizeof(uintptr_t));
+    
+    if (writer->relocationsLength == writer->relocationsCapacity) {
+        uint32_t capacity = writer->relocationsCapacity == 0 ? 256 : writer->relocationsCapacity * 2;
+        uint64_t* relocations = (uint64_t*)MemRealloc(writer->relocations, (unsigned int)(sizeof(uint64_t) * capacity));
+        if (relocations == NULL) { /* The old array is kept, to be freed by ExportTMXBinary() */
+            writer->isSuccess = false;
+            writer->isOutOfMemory = true;
+            return;
+        }
+        writer->relocations = relocations;
+        writer->relocationsCapacity = capacity;
+    }
+    writer->relocations[writer->relocationsLength++] = fieldOffset;
+}
+
+/* Zero the copy of a value that only has meaning in the running process, like a texture */
+void WriteBinaryZeroes(RaytmxBinaryWriter* writer, const void* field, size_t size) {
+    uint64_t fieldOffset;
+    if (GetBinaryOffset(writer, field, &fieldOffset))
+        memset(writer->data + fieldOffset, 0, size);
+    else
+        writer->isSuccess = false;
+}
+
+void WriteBinaryProperties(RaytmxBinaryWriter* writer, const TmxProperty* properties, uint32_t propertiesLength) {
+    for (uint32_t i = 0; i < propertiesLength; i++) {
+        WriteBinaryPointer(writer, &properties[i].name);
+        WriteBinaryPointer(writer, &properties[i].stringValue);
+    }
+}
+
+void WriteBinaryImage(RaytmxBinaryWriter* writer, const TmxImage* image) {
+    WriteBinaryPointer(writer, &image->source);
+    WriteBinaryZeroes(writer, &image->texture, sizeof(Texture2D));
+}
+
+void WriteBinaryObjectGroup(RaytmxBinaryWriter* writer, const TmxObjectGroup* objectGroup) {
+    for (uint32_t i = 0; i < objectGroup->objectsLength; i++) {
+        const TmxObject* object = &objectGroup->objects[i];
+        WriteBinaryPointer(writer, &object->name);
+        WriteBinaryPointer(writer, &object->typeString);
+        WriteBinaryPointer(writer, &object->templateString);
+        WriteBinaryPointer(writer, &object->points);
+        WriteBinaryPointer(writer, &object->drawPoints);
+        if (object->text != NULL) {
+            WriteBinaryPointer(writer, &object->text->fontFamily);
+            WriteBinaryPointer(writer, &object->text->content);
+            for (uint32_t j = 0; j < object->text->linesLength; j++) {
+                WriteBinaryPointer(writer, &object->text->lines[j].content);
+                WriteBinaryZeroes(writer, &object->text->lines[j].font, sizeof(Font));
+            }
+            WriteBinaryPointer(writer, &object->text->lines);
+        }
+        WriteBinaryPointer(writer, &object->text);
+        WriteBinaryProperties(writer, object->properties, object->propertiesLength);
+        WriteBinaryPointer(writer, &object->properties);
+    }
+    WriteBinaryPointer(writer, &objectGroup->objects);
+    WriteBinaryPointer(writer, &objectGroup->ySortedObjects);
+    if (objectGroup->grid != NULL) {
+        WriteBinaryPointer(writer, &objectGroup->grid->cellStarts);
+        WriteBinaryPointer(writer, &objectGroup->grid->cellObjects);
+    }
+    WriteBinaryPointer(writer, &objectGroup->grid);
+    if (objectGroup->bounds != NULL) {
+        WriteBinaryPointer(writer, &objectGroup->bounds->minX);
+        WriteBinaryPointer(writer, &objectGroup->bounds->minY);
+        WriteBinaryPointer(writer, &objectGroup->bounds->maxX);
+        WriteBinaryPointer(writer, &objectGroup->bounds->maxY);
+    }
+    WriteBinaryPointer(writer, &objectGroup->bounds);
+    if (objectGroup->bvh != NULL) {
+        WriteBinaryPointer(writer, &objectGroup->bvh->nodes);
+        WriteBinaryPointer(writer, &objectGroup->bvh->objectIndices);
+    }
+    WriteBinaryPointer(writer, &objectGroup->bvh);
+}
+
+void WriteBinaryTilesets(RaytmxBinaryWriter* writer, const TmxTileset* tilesets, uint32_t tilesetsLength) {
+    for (uint32_t i = 0; i < tilesetsLength; i++) {
+        const TmxTileset* tileset = &tilesets[i];
+        WriteBinaryPointer(writer, &tileset->source);
+        WriteBinaryPointer(writer, &tileset->name);
+        WriteBinaryPointer(writer, &tileset->classString);
+        WriteBinaryImage(writer, &tileset->image);
+        WriteBinaryProperties(writer, tileset->properties, tileset->propertiesLength);
+        WriteBinaryPointer(writer, &tileset->properties);
+        for (uint32_t j = 0; j < tileset->tilesLength; j++) {
+            const TmxTilesetTile* tilesetTile = &tileset->tiles[j];
+            WriteBinaryPointer(writer, &tilesetTile->classString);
+            WriteBinaryImage(writer, &tilesetTile->image);
+            WriteBinaryPointer(writer, &tilesetTile->animation.frames);
+            WriteBinaryProperties(writer, tilesetTile->properties, tilesetTile->propertiesLength);
+            WriteBinaryPointer(writer, &tilesetTile->properties);
+            WriteBinaryObjectGroup(writer, &tilesetTile->objectGroup);
+        }
+        WriteBinaryPointer(writer, &tileset->tiles);
+    }
+}
+
+void WriteBinaryLayers(RaytmxBinaryWriter* writer, const TmxLayer* layers, uint32_t layersLength) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        const TmxLayer* layer = &layers[i];
+        WriteBinaryPointer(writer, &layer->name);
+        WriteBinaryPointer(writer, &layer->classString);
+        WriteBinaryProperties(writer, layer->properties, layer->propertiesLength);
+        WriteBinaryPointer(writer, &layer->properties);
+        WriteBinaryLayers(writer, layer->layers, layer->layersLength);
+        WriteBinaryPointer(writer, &layer->layers);
+        switch (layer->type) {
+        case LAYER_TYPE_TILE_LAYER:
+            WriteBinaryPointer(writer, &layer->exact.tileLayer.encoding);
+            WriteBinaryPointer(writer, &layer->exact.tileLayer.compression);
+            WriteBinaryPointer(writer, &layer->exact.tileLayer.tiles);
+            for (uint32_t j = 0; j < layer->exact.tileLayer.chunksLength; j++) {
+                const TmxTileChunk* chunk = &layer->exact.tileLayer.chunks[j];
+                WriteBinaryPointer(writer, &chunk->data);
+                WriteBinaryZeroes(writer, &chunk->tiles, sizeof(chunk->tiles)); /* Decoded tiles aren't in the arena */
+            }
+            WriteBinaryPointer(writer, &layer->exact.tileLayer.chunks);
+            WriteBinaryPointer(writer, &layer->exact.tileLayer.chunkTable);
+            WriteBinaryPointer(writer, &layer->exact.tileLayer.solidBits);
+            WriteBinaryPointer(writer, &layer->exact.tileLayer.shapeBits);
+            break;
+        case LAYER_TYPE_OBJECT_GROUP:
+            WriteBinaryObjectGroup(writer, &layer->exact.objectGroup);
+            break;
+        case LAYER_TYPE_IMAGE_LAYER:
+            WriteBinaryImage(writer, &layer->exact.imageLayer.image);
+            break;
+        case LAYER_TYPE_GROUP:
+            break;
+        }
+    }
+}
+
+int CompareBinaryOffsets(const void* a, const void* b) {
+    uint64_t offsetA = *(const uint64_t*)a, offsetB = *(const uint64_t*)b;
+    return (offsetA > offsetB) - (offsetA < offsetB);
+}
+
+Texture2D LoadBinaryTexture(RaytmxState* raytmxState, const char* directory, const char* source) {
+    Texture2D texture;
+    memset(&texture, 0, sizeof(Texture2D));
+    if (source == NULL)
+        return texture;
+    
+    /* The state's document directory is left empty so the full path is used as-is and is the key of the cache. The */
+    /* path is as long as JoinPath() allows at most, a separator and terminator included. */
+    char fullPath[260];
+    if (strlen(directory) + strlen(source) + 2 > sizeof(fullPath)) {
+        TraceLog(LOG_ERROR, "RAYTMX: Path of texture \"%s\" is too long", source);
+        return texture;
+    }
+    StringCopy(fullPath, JoinPath(directory, source));
+    return LoadCachedTexture(raytmxState, fullPath);
+}
+
+void LoadBinaryLayerResources(RaytmxState* raytmxState, TmxLayer* layers, uint32_t layersLength,
+                              const char* directory) {
+    for (uint32_t i = 0; i < layersLength; i++) {
+        TmxLayer* layer = &layers[i];
+        if (layer->type == LAYER_TYPE_OBJECT_GROUP)
+            SetObjectGroupFonts(&layer->exact.objectGroup);
+        else if (layer->type == LAYER_TYPE_IMAGE_LAYER && layer->exact.imageLayer.hasImage) {
+            TmxImage* image = &layer->exact.imageLayer.image;
+            image->texture = LoadBinaryTexture(raytmxState, directory, image->source);
+        } else if (layer->type == LAYER_TYPE_GROUP)
+            LoadBinaryLayerResources(raytmxState, layer->layers, layer->layersLength, directory);
+    }
+}
+
+void SetObjectGroupFonts(TmxObjectGroup* objectGroup) {
+    for (uint32_t i = 0; i < objectGroup->objectsLength; i++) {
+        TmxText* text = objectGroup->objects[i].text;
+        if (text == NULL)
+            continue;
+        for (uint32_t j = 0; j < text->linesLength; j++)
+            text->lines[j].font = GetFontDefault(); /* The same font text lines are given when parsed */
+    }
+}
+
 /* "Get directory for a given filePath" */
 /* raylib's GetDirectoryPath() doesn't work as described so this is used in its place */
 char* GetDirectoryPath2(const char* filePath) {
-    static char directoryPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
+    /* Max path length on Windows, the bottleneck, is 260 characters. One buffer per thread for LoadTMXAsync(). */
+    static RAYTMX_THREAD_LOCAL char directoryPath[260];
     memset(directoryPath, '\0', 260);
     size_t length = strlen(filePath);
     /* Paths beginning with a Windows drive letter (C:\, D:\, etc.) or beginning with a slash are absolute paths */
@@ -4689,7 +8337,8 @@ char* GetDirectoryPath2(const char* filePath) {
 }
 
 char* JoinPath(const char* prefix, const char* suffix) {
-    static char joinedPath[260]; /* Max path length on Windows, the bottleneck, is 260 characters */
+    /* Max path length on Windows, the bottleneck, is 260 characters. One buffer per thread for LoadTMXAsync(). */
+    static RAYTMX_THREAD_LOCAL char joinedPath[260];
     memset(joinedPath, '\0', 260);
     StringCopy(joinedPath, prefix);
     size_t prefixLength = strlen(prefix);
@@ -0,0 +1,1054 @@
+/*******************************************************************************************
+*
+*   raytmx benchmarks
+*
+*   Generates synthetic maps, then times loading them, building their GID-to-tile tables,
+*   iterating their tile layers through a screen-sized viewport, and collision queries
+*   and raycasts against their object group. No window or GPU is used; tilesets' images
+*   are never loaded. Before timing them, the object group's three AABB queries are checked
+*   against each other, edge-touching rectangles included, and its bounding volume hierarchy
+*   against a scan of every object. Any difference fails the run.
+*
+*   Usage: tmx_bench [-out results.json] [-repeats N] [-dir path]
+*          tmx_bench -width W -height H -layers L -objects O [-slopes S] [-polylines P]
+*                    -encoding csv|base64|zlib [...]
+*
+*   Without a map given, a fixed suite of maps is run. Results are printed, or written to
+*   -out, as JSON. Every benchmark is named "<map>/<measurement>" where <map> is
+*   "<width>x<height>_l<layers>_o<objects>_<encoding>", with "_s<slopes>" before the encoding
+*   when some of the objects are triangular slopes and "_p<polylines>" when some are
+*   polylines, so a name only changes when what it measures does and results can be
+*   tracked from build to build.
+*
+********************************************************************************************/
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raylib.h"
+
+extern "C"
+{
+#include "raytmx.h"
+}
+
+#include "plata_profiler.cpp"
+
+#define BENCH_DEFAULT_REPEATS 9
+#define BENCH_MAX_RESULTS 128
+#define BENCH_TILE_SIZE 16
+#define BENCH_TILESET_COLUMNS 16
+#define BENCH_TILESET_TILES 256
+#define BENCH_VIEWPORT_WIDTH 1024.0f
+#define BENCH_VIEWPORT_HEIGHT 768.0f
+#define BENCH_VIEWPORTS 64
+#define BENCH_QUERIES 4096
+#define BENCH_QUERY_WIDTH 32.0f
+#define BENCH_QUERY_HEIGHT 48.0f
+#define BENCH_MAX_CANDIDATES 256
+#define BENCH_RAY_LENGTH 256 // Longest a raycast's segment is along either axis, in pixels
+
+//----------------------------------------------------------------------------------
+// Types and Structures Definition
+//----------------------------------------------------------------------------------
+typedef enum
+{
+    BENCH_ENCODING_CSV = 0,
+    BENCH_ENCODING_BASE64,
+    BENCH_ENCODING_ZLIB,
+    BENCH_ENCODING_COUNT
+} BenchEncoding;
+
+typedef struct BenchMapSpec
+{
+    int width; // In tiles
+    int height;
+    int layers;
+    int objects;
+    BenchEncoding encoding;
+    int slopes; // How many of the objects are right-triangle polygons rather than rectangles
+    int polylines; // How many of the objects after the slopes are polylines, every other one left open
+} BenchMapSpec;
+
+// Growable, always null-terminated
+typedef struct BenchText
+{
+    char *data;
+    int length;
+    int capacity;
+} BenchText;
+
+typedef struct BenchResult
+{
+    char name[96];
+    const char *unit;
+    int repeats;
+    double median;
+    double min;
+    double mean;
+} BenchResult;
+
+typedef struct BenchResults
+{
+    BenchResult results[BENCH_MAX_RESULTS];
+    int count;
+} BenchResults;
+
+static const char *benchEncodingNames[BENCH_ENCODING_COUNT] = { "csv", "base64", "zlib" };
+
+// Run when no map is given on the command line. Append to this rather than changing entries, so names stay stable.
+static const BenchMapSpec benchSuite[] =
+{
+    { 64, 64, 2, 64, BENCH_ENCODING_CSV, 0, 0 },
+    { 256, 256, 4, 1024, BENCH_ENCODING_CSV, 0, 0 },
+    { 256, 256, 4, 1024, BENCH_ENCODING_BASE64, 0, 0 },
+    { 256, 256, 4, 1024, BENCH_ENCODING_ZLIB, 0, 0 },
+    { 1024, 1024, 2, 8192, BENCH_ENCODING_ZLIB, 0, 0 },
+    { 1024, 1024, 2, 8192, BENCH_ENCODING_ZLIB, 4096, 0 },
+    { 1024, 1024, 2, 8192, BENCH_ENCODING_ZLIB, 2048, 2048 },
+};
+
+//----------------------------------------------------------------------------------
+// Function Forward Declarations / Prototypes
+//----------------------------------------------------------------------------------
+static bool RunBenchMap(BenchResults *results, BenchMapSpec spec, const char *directory, int repeats);
+static bool WriteBenchMap(const char *fileName, BenchMapSpec spec);
+static uint32_t CheckBenchQueries(TmxObjectGroup *group, Rectangle *queries, int count);
+static uint32_t CheckBenchBvh(TmxObjectGroup *group, Rectangle *queries, Vector2 *rayStarts, Vector2 *rayEnds,
+                              int count);
+static uint32_t CheckBenchRaycasts(TmxObjectGroup *group, Vector2 *rayStarts, Vector2 *rayEnds, int count);
+static bool IntersectBenchObject(TmxObject *object, Vector2 from, Vector2 to, float *hitTime);
+static bool IntersectBenchEdge(Vector2 from, Vector2 delta, Vector2 start, Vector2 end, float *hitTime);
+static void AppendText(BenchText *text, const char *format, ...);
+static void EncodeTileData(BenchText *text, uint32_t *gids, int gidCount, BenchEncoding encoding);
+static uint32_t Adler32(const unsigned char *data, int length);
+static BenchResult *AddBenchResult(BenchResults *results, const char *mapName, const char *measurement,
+                                   const char *unit, double *samples, int repeats);
+static bool WriteBenchResults(BenchResults *results, const char *fileName);
+static uint32_t NextRandom(uint32_t *state);
+static Texture2D LoadNoTexture(const char *fileName);
+
+//------------------------------------------------------------------------------------
+// Program main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char **argv)
+{
+    const char *outPath = 0;
+    const char *directory = ".";
+    int repeats = BENCH_DEFAULT_REPEATS;
+    BenchMapSpec custom = { 256, 256, 4, 1024, BENCH_ENCODING_CSV, 0, 0 };
+    bool hasCustom = false;
+    for(int argIndex = 1;
+        argIndex < argc;
+        argIndex++)
+    {
+        if(strcmp(argv[argIndex], "-out") == 0 && argIndex + 1 < argc)
+        {
+            outPath = argv[++argIndex];
+        }
+        else if(strcmp(argv[argIndex], "-repeats") == 0 && argIndex + 1 < argc)
+        {
+            repeats = atoi(argv[++argIndex]);
+        }
+        else if(strcmp(argv[argIndex], "-dir") == 0 && argIndex + 1 < argc)
+        {
+            directory = argv[++argIndex];
+        }
+        else if(strcmp(argv[argIndex], "-width") == 0 && argIndex + 1 < argc)
+        {
+            custom.width = atoi(argv[++argIndex]);
+            hasCustom = true;
+        }
+        else if(strcmp(argv[argIndex], "-height") == 0 && argIndex + 1 < argc)
+        {
+            custom.height = atoi(argv[++argIndex]);
+            hasCustom = true;
+        }
+        else if(strcmp(argv[argIndex], "-layers") == 0 && argIndex + 1 < argc)
+        {
+            custom.layers = atoi(argv[++argIndex]);
+            hasCustom = true;
+        }
+        else if(strcmp(argv[argIndex], "-objects") == 0 && argIndex + 1 < argc)
+        {
+            custom.objects = atoi(argv[++argIndex]);
+            hasCustom = true;
+        }
+        else if(strcmp(argv[argIndex], "-slopes") == 0 && argIndex + 1 < argc)
+        {
+            custom.slopes = atoi(argv[++argIndex]);
+            hasCustom = true;
+        }
+        else if(strcmp(argv[argIndex], "-polylines") == 0 && argIndex + 1 < argc)
+        {
+            custom.polylines = atoi(argv[++argIndex]);
+            hasCustom = true;
+        }
+        else if(strcmp(argv[argIndex], "-encoding") == 0 && argIndex + 1 < argc)
+        {
+            const char *encodingName = argv[++argIndex];
+            custom.encoding = BENCH_ENCODING_COUNT;
+            for(int encoding = 0;
+                encoding < BENCH_ENCODING_COUNT;
+                encoding++)
+            {
+                if(strcmp(encodingName, benchEncodingNames[encoding]) == 0) custom.encoding = (BenchEncoding)encoding;
+            }
+            if(custom.encoding == BENCH_ENCODING_COUNT)
+            {
+                fprintf(stderr, "Unknown encoding \"%s\". Use csv, base64 or zlib.\n", encodingName);
+                return(1);
+            }
+            hasCustom = true;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-out file.json] [-repeats N] [-dir path]\n"
+                    "       %s -width W -height H -layers L -objects O [-slopes S] [-polylines P]"
+                    " -encoding csv|base64|zlib [...]\n",
+                    argv[0], argv[0]);
+            return(1);
+        }
+    }
+    if(repeats < 1) repeats = 1;
+    if(custom.width < 1 || custom.height < 1 || custom.layers < 1 || custom.objects < 0 || custom.slopes < 0 ||
+       custom.polylines < 0 || custom.slopes + custom.polylines > custom.objects)
+    {
+        fprintf(stderr, "Map dimensions and layer count must be at least 1, and slopes and polylines together at "
+                "most the object count\n");
+        return(1);
+    }
+    
+    // The synthetic tileset's image doesn't exist, and isn't needed without a GPU to draw with
+    SetTraceLogLevel(LOG_ERROR);
+    SetLoadTextureTMX(LoadNoTexture);
+    
+    BenchResults *results = (BenchResults *)MemAlloc(sizeof(BenchResults));
+    bool succeeded = true;
+    if(hasCustom)
+    {
+        succeeded = RunBenchMap(results, custom, directory, repeats);
+    }
+    else
+    {
+        for(int i = 0;
+            i < (int)(sizeof(benchSuite) / sizeof(benchSuite[0]));
+            i++)
+        {
+            if(!RunBenchMap(results, benchSuite[i], directory, repeats)) succeeded = false;
+        }
+    }
+    
+    if(!WriteBenchResults(results, outPath))
+    {
+        TraceLog(LOG_ERROR, "Failed to write results to \"%s\"", outPath);
+        succeeded = false;
+    }
+    MemFree(results);
+    ProfilerShutdown();
+    
+    return(succeeded ? 0 : 1);
+}
+
+// Writes the map to the directory, runs every measurement against it, and deletes it again
+static bool
+RunBenchMap(BenchResults *results, BenchMapSpec spec, const char *directory, int repeats)
+{
+    char mapName[64];
+    char slopesName[16] = "";
+    if(spec.slopes > 0) snprintf(slopesName, sizeof(slopesName), "_s%d", spec.slopes);
+    char polylinesName[16] = "";
+    if(spec.polylines > 0) snprintf(polylinesName, sizeof(polylinesName), "_p%d", spec.polylines);
+    snprintf(mapName, sizeof(mapName), "%dx%d_l%d_o%d%s%s_%s", spec.width, spec.height, spec.layers, spec.objects,
+             slopesName, polylinesName, benchEncodingNames[spec.encoding]);
+    char fileName[512];
+    snprintf(fileName, sizeof(fileName), "%s/bench_%s.tmx", directory, mapName);
+    
+    if(!WriteBenchMap(fileName, spec))
+    {
+        TraceLog(LOG_ERROR, "Failed to write \"%s\"", fileName);
+        return(false);
+    }
+    
+    double *samples = (double *)MemAlloc((unsigned int)(repeats * sizeof(double)));
+    TmxMap *map = 0;
+    
+    // Parsing the document and building everything hung off the map, start to finish
+    for(int repeat = 0;
+        repeat < repeats;
+        repeat++)
+    {
+        if(map) UnloadTMX(map);
+        uint64_t start = ProfilerGetTicks();
+        map = LoadTMX(fileName);
+        samples[repeat] = ProfilerTicksToMicroseconds(ProfilerGetTicks() - start) / 1000.0;
+        if(!map) break;
+    }
+    remove(fileName);
+    if(!map)
+    {
+        TraceLog(LOG_ERROR, "Failed to load \"%s\"", fileName);
+        MemFree(samples);
+        return(false);
+    }
+    AddBenchResult(results, mapName, "load", "ms", samples, repeats);
+    
+    // Rebuilding allocates a fresh table from the map's arena each time, so the map grows a little per repeat
+    for(int repeat = 0;
+        repeat < repeats;
+        repeat++)
+    {
+        uint64_t start = ProfilerGetTicks();
+        RebuildTMXTiles(map);
+        samples[repeat] = ProfilerTicksToMicroseconds(ProfilerGetTicks() - start);
+    }
+    AddBenchResult(results, mapName, "gids_to_tiles", "us", samples, repeats);
+    
+    // Viewports are spread over the map on a fixed diagonal walk, so every run visits the same tiles
+    float mapWidth = (float)(map->width * map->tileWidth);
+    float mapHeight = (float)(map->height * map->tileHeight);
+    uint64_t checksum = 0;
+    for(int repeat = 0;
+        repeat < repeats;
+        repeat++)
+    {
+        uint64_t start = ProfilerGetTicks();
+        for(int viewportIndex = 0;
+            viewportIndex < BENCH_VIEWPORTS;
+            viewportIndex++)
+        {
+            float t = (float)viewportIndex / BENCH_VIEWPORTS;
+            Rectangle viewport = { t * mapWidth - BENCH_VIEWPORT_WIDTH / 2, t * mapHeight - BENCH_VIEWPORT_HEIGHT / 2,
+                                   BENCH_VIEWPORT_WIDTH, BENCH_VIEWPORT_HEIGHT };
+            for(uint32_t layerIndex = 0;
+                layerIndex < map->layersLength;
+                layerIndex++)
+            {
+                TmxLayer *layer = &map->layers[layerIndex];
+                if(layer->type != LAYER_TYPE_TILE_LAYER) continue;
+                
+                TmxTileLayerIterator iterator;
+                InitTMXTileLayerIterator(&iterator, map, &layer->exact.tileLayer, viewport);
+                uint32_t rawGid;
+                TmxTile tile;
+                Rectangle tileRect;
+                while(NextTMXTileLayerTile(&iterator, &rawGid, &tile, &tileRect))
+                {
+                    checksum += rawGid;
+                }
+            }
+        }
+        samples[repeat] = ProfilerTicksToMicroseconds(ProfilerGetTicks() - start) / BENCH_VIEWPORTS;
+    }
+    AddBenchResult(results, mapName, "iterate_viewport", "us", samples, repeats);
+    
+    TmxObjectGroup *group = 0;
+    for(uint32_t layerIndex = 0;
+        layerIndex < map->layersLength;
+        layerIndex++)
+    {
+        if(map->layers[layerIndex].type == LAYER_TYPE_OBJECT_GROUP) group = &map->layers[layerIndex].exact.objectGroup;
+    }
+    
+    bool matched = true;
+    if(group)
+    {
+        // Player-sized rectangles scattered over the whole map
+        Rectangle *queries = (Rectangle *)MemAlloc((unsigned int)(BENCH_QUERIES * sizeof(Rectangle)));
+        uint32_t randomState = 0x9E3779B9;
+        for(int i = 0;
+            i < BENCH_QUERIES;
+            i++)
+        {
+            queries[i].x = (float)(NextRandom(&randomState) % (uint32_t)mapWidth);
+            queries[i].y = (float)(NextRandom(&randomState) % (uint32_t)mapHeight);
+            queries[i].width = BENCH_QUERY_WIDTH;
+            queries[i].height = BENCH_QUERY_HEIGHT;
+        }
+        
+        for(int repeat = 0;
+            repeat < repeats;
+            repeat++)
+        {
+            uint64_t start = ProfilerGetTicks();
+            for(int i = 0;
+                i < BENCH_QUERIES;
+                i++)
+            {
+                if(CheckCollisionTMXObjectGroupRec(*group, queries[i], 0)) checksum++;
+            }
+            samples[repeat] = ProfilerTicksToMicroseconds(ProfilerGetTicks() - start) * 1000.0 / BENCH_QUERIES;
+        }
+        AddBenchResult(results, mapName, "collision_rec", "ns", samples, repeats);
+        
+        // The same queries all at once, still reported per query
+        uint32_t *objectIndices = (uint32_t *)MemAlloc((unsigned int)(BENCH_QUERIES * sizeof(uint32_t)));
+        for(int repeat = 0;
+            repeat < repeats;
+            repeat++)
+        {
+            uint64_t start = ProfilerGetTicks();
+            checksum += CheckCollisionTMXObjectGroupRecs(group, queries, BENCH_QUERIES, objectIndices);
+            samples[repeat] = ProfilerTicksToMicroseconds(ProfilerGetTicks() - start) * 1000.0 / BENCH_QUERIES;
+        }
+        AddBenchResult(results, mapName, "collision_recs_batch", "ns", samples, repeats);
+        MemFree(objectIndices);
+        
+        uint32_t candidates[BENCH_MAX_CANDIDATES];
+        for(int repeat = 0;
+            repeat < repeats;
+            repeat++)
+        {
+            uint64_t start = ProfilerGetTicks();
+            for(int i = 0;
+                i < BENCH_QUERIES;
+                i++)
+            {
+                checksum += QueryTMXObjectGroupGrid(group, queries[i], candidates, BENCH_MAX_CANDIDATES);
+            }
+            samples[repeat] = ProfilerTicksToMicroseconds(ProfilerGetTicks() - start) * 1000.0 / BENCH_QUERIES;
+        }
+        AddBenchResult(results, mapName, "collision_grid_query", "ns", samples, repeats);
+        
+        // Bullet-length segments from the same places, in every direction
+        Vector2 *rayStarts = (Vector2 *)MemAlloc((unsigned int)(BENCH_QUERIES * sizeof(Vector2)));
+        Vector2 *rayEnds = (Vector2 *)MemAlloc((unsigned int)(BENCH_QUERIES * sizeof(Vector2)));
+        for(int i = 0;
+            i < BENCH_QUERIES;
+            i++)
+        {
+            rayStarts[i] = { queries[i].x, queries[i].y };
+            rayEnds[i].x = rayStarts[i].x + (float)((int)(NextRandom(&randomState) % (2 * BENCH_RAY_LENGTH + 1)) -
+                                                    BENCH_RAY_LENGTH);
+            rayEnds[i].y = rayStarts[i].y + (float)((int)(NextRandom(&randomState) % (2 * BENCH_RAY_LENGTH + 1)) -
+                                                    BENCH_RAY_LENGTH);
+        }
+        
+        // Timing a wrong answer is pointless, so the queries have to agree with each other, and the hierarchy with a
+        // scan of every object, first
+        uint32_t mismatches = CheckBenchQueries(group, queries, BENCH_QUERIES);
+        if(mismatches)
+        {
+            TraceLog(LOG_ERROR, "%s: %u of %d queries differ between the bounds, grid and BVH", mapName, mismatches,
+                     BENCH_QUERIES);
+            matched = false;
+        }
+        mismatches = CheckBenchRaycasts(group, rayStarts, rayEnds, BENCH_QUERIES);
+        if(mismatches)
+        {
+            TraceLog(LOG_ERROR, "%s: %u of %d raycasts differ from testing every object's shape directly", mapName,
+                     mismatches, BENCH_QUERIES);
+            matched = false;
+        }
+        mismatches = CheckBenchBvh(group, queries, rayStarts, rayEnds, BENCH_QUERIES);
+        if(mismatches)
+        {
+            TraceLog(LOG_ERROR, "%s: %u of %d queries differ between the BVH and a scan of every object", mapName,
+                     mismatches, BENCH_QUERIES);
+            matched = false;
+        }
+        
+        if(group->bvh)
+        {
+            for(int repeat = 0;
+                repeat < repeats;
+                repeat++)
+            {
+                uint64_t start = ProfilerGetTicks();
+                for(int i = 0;
+                    i < BENCH_QUERIES;
+                    i++)
+                {
+                    checksum += QueryTMXObjectGroupBVH(group, queries[i], candidates, BENCH_MAX_CANDIDATES);
+                }
+                samples[repeat] = ProfilerTicksToMicroseconds(ProfilerGetTicks() - start) * 1000.0 / BENCH_QUERIES;
+            }
+            AddBenchResult(results, mapName, "collision_bvh_query", "ns", samples, repeats);
+        }
+        
+        // With the group's hierarchy, if it has one, then with every object scanned
+        TmxObjectBvh *bvh = group->bvh;
+        for(int pass = 0;
+            pass < (bvh ? 2 : 1);
+            pass++)
+        {
+            group->bvh = pass == 0 ? bvh : 0;
+            for(int repeat = 0;
+                repeat < repeats;
+                repeat++)
+            {
+                uint64_t start = ProfilerGetTicks();
+                for(int i = 0;
+                    i < BENCH_QUERIES;
+                    i++)
+                {
+                    if(RaycastTMXObjectGroup(group, rayStarts[i], rayEnds[i], 0)) checksum++;
+                }
+                samples[repeat] = ProfilerTicksToMicroseconds(ProfilerGetTicks() - start) * 1000.0 / BENCH_QUERIES;
+            }
+            AddBenchResult(results, mapName, group->bvh ? "raycast" : "raycast_scan", "ns", samples, repeats);
+        }
+        group->bvh = bvh;
+        
+        MemFree(rayEnds);
+        MemFree(rayStarts);
+        MemFree(queries);
+    }
+    
+    // Printed so none of the timed work can be optimized away
+    TraceLog(LOG_DEBUG, "%s checksum %llu", mapName, (unsigned long long)checksum);
+    
+    UnloadTMX(map);
+    MemFree(samples);
+    return(matched);
+}
+
+// Runs every query through QueryTMXObjectGroupBounds(), QueryTMXObjectGroupGrid() and QueryTMXObjectGroupBVH(), and
+// again moved to just touch one of the group's objects on one side, and counts the queries whose answers differ. The
+// touching queries must also find the object they touch.
+static uint32_t
+CheckBenchQueries(TmxObjectGroup *group, Rectangle *queries, int count)
+{
+    if(group->objectsLength == 0) return(0);
+    
+    uint32_t *fromBounds = (uint32_t *)MemAlloc((unsigned int)(group->objectsLength * sizeof(uint32_t)));
+    uint32_t *fromGrid = (uint32_t *)MemAlloc((unsigned int)(group->objectsLength * sizeof(uint32_t)));
+    uint32_t *fromBvh = (uint32_t *)MemAlloc((unsigned int)(group->objectsLength * sizeof(uint32_t)));
+    uint32_t mismatches = 0;
+    for(int i = 0;
+        i < count;
+        i++)
+    {
+        for(int touching = 0;
+            touching < 2;
+            touching++)
+        {
+            Rectangle query = queries[i];
+            uint32_t touched = (uint32_t)i % group->objectsLength;
+            if(touching)
+            {
+                // Left of, right of, above or below the object, with one edge exactly on one of the object's
+                Rectangle aabb = group->objects[touched].aabb;
+                query.x = aabb.x;
+                query.y = aabb.y;
+                if(i % 4 == 0) query.x = aabb.x - query.width;
+                if(i % 4 == 1) query.x = aabb.x + aabb.width;
+                if(i % 4 == 2) query.y = aabb.y - query.height;
+                if(i % 4 == 3) query.y = aabb.y + aabb.height;
+            }
+            
+            uint32_t boundsCount = QueryTMXObjectGroupBounds(group, query, fromBounds, group->objectsLength);
+            uint32_t gridCount = QueryTMXObjectGroupGrid(group, query, fromGrid, group->objectsLength);
+            uint32_t bvhCount = QueryTMXObjectGroupBVH(group, query, fromBvh, group->objectsLength);
+            bool same = boundsCount == gridCount && boundsCount == bvhCount &&
+                        memcmp(fromBounds, fromGrid, boundsCount * sizeof(uint32_t)) == 0 &&
+                        memcmp(fromBounds, fromBvh, boundsCount * sizeof(uint32_t)) == 0;
+            if(touching && same)
+            {
+                same = false;
+                for(uint32_t found = 0;
+                    found < boundsCount;
+                    found++)
+                {
+                    if(fromBounds[found] == touched) same = true;
+                }
+            }
+            if(!same)
+            {
+                mismatches++;
+                break;
+            }
+        }
+    }
+    
+    MemFree(fromBvh);
+    MemFree(fromGrid);
+    MemFree(fromBounds);
+    return(mismatches);
+}
+
+// Runs every query through the group's bounding volume hierarchy and again with the hierarchy detached, which makes
+// raytmx scan every object instead, and counts the queries whose answers differ. The first-collision checks, the
+// AABB query, raycasts, and the enumeration of every colliding object are all compared.
+static uint32_t
+CheckBenchBvh(TmxObjectGroup *group, Rectangle *queries, Vector2 *rayStarts, Vector2 *rayEnds, int count)
+{
+    TmxObjectBvh *bvh = group->bvh;
+    TmxObjectBounds *bounds = group->bounds;
+    if(!bvh) return(0);
+    
+    uint32_t *found = (uint32_t *)MemAlloc((unsigned int)(group->objectsLength * sizeof(uint32_t)));
+    uint32_t *scanned = (uint32_t *)MemAlloc((unsigned int)(group->objectsLength * sizeof(uint32_t)));
+    uint32_t mismatches = 0;
+    for(int i = 0;
+        i < count;
+        i++)
+    {
+        // A slope-shaped query, so that polygons are tested against polygons as well as rectangles
+        Rectangle query = queries[i];
+        Vector2 triangle[3] = { { query.x, query.y + query.height }, { query.x + query.width, query.y + query.height },
+                                { query.x + query.width, query.y } };
+        TmxObject triangleObject = {};
+        triangleObject.type = OBJECT_TYPE_POLYGON;
+        triangleObject.aabb = query;
+        triangleObject.points = triangle;
+        triangleObject.pointsLength = 3;
+        
+        TmxObject recObject;
+        TmxObject scannedObject;
+        TmxRaycastHit hit = {};
+        TmxRaycastHit scannedHit = {};
+        group->bvh = bvh;
+        bool recHit = CheckCollisionTMXObjectGroupRec(*group, query, &recObject);
+        bool polyHit = CheckCollisionTMXObjectGroupPolyEx(*group, triangle, 3, query, 0);
+        bool rayHit = RaycastTMXObjectGroup(group, rayStarts[i], rayEnds[i], &hit);
+        uint32_t foundCount = QueryTMXObjectGroupBVH(group, query, found, group->objectsLength);
+        group->bvh = 0;
+        group->bounds = 0;
+        bool same = CheckCollisionTMXObjectGroupRec(*group, query, &scannedObject) == recHit &&
+                    (!recHit || scannedObject.id == recObject.id) &&
+                    CheckCollisionTMXObjectGroupPolyEx(*group, triangle, 3, query, 0) == polyHit &&
+                    RaycastTMXObjectGroup(group, rayStarts[i], rayEnds[i], &scannedHit) == rayHit &&
+                    (!rayHit || (scannedHit.objectIndex == hit.objectIndex && scannedHit.time == hit.time)) &&
+                    QueryTMXObjectGroupBVH(group, query, scanned, group->objectsLength) == foundCount &&
+                    memcmp(found, scanned, foundCount * sizeof(uint32_t)) == 0;
+        
+        group->bvh = bvh;
+        foundCount = EnumerateTMXObjectGroupCollisions(group, triangleObject, found, group->objectsLength);
+        group->bvh = 0;
+        uint32_t scannedCount = EnumerateTMXObjectGroupCollisions(group, triangleObject, scanned, group->objectsLength);
+        group->bounds = bounds;
+        if(!same || scannedCount != foundCount || memcmp(found, scanned, foundCount * sizeof(uint32_t)) != 0)
+        {
+            mismatches++;
+        }
+    }
+    group->bvh = bvh;
+    
+    MemFree(scanned);
+    MemFree(found);
+    return(mismatches);
+}
+
+// Raycasts every segment through the group as it is and, if it has a hierarchy, again with the hierarchy detached, and
+// counts the segments for which either differs from the nearest hit found here. Every object's shape is tested here
+// from its points, without any of raytmx's segment code, so that a mistake in that code can't agree with itself.
+static uint32_t
+CheckBenchRaycasts(TmxObjectGroup *group, Vector2 *rayStarts, Vector2 *rayEnds, int count)
+{
+    // Times within this of each other count as the same hit, as they are found with differently rounded math
+    const float tolerance = 1e-4f;
+    
+    TmxObjectBvh *bvh = group->bvh;
+    uint32_t mismatches = 0;
+    for(int i = 0;
+        i < count;
+        i++)
+    {
+        uint32_t nearestIndex = TMX_NO_OBJECT;
+        float nearestTime = 1.0f;
+        for(uint32_t objectIndex = 0;
+            objectIndex < group->objectsLength;
+            objectIndex++)
+        {
+            float time;
+            if(IntersectBenchObject(&group->objects[objectIndex], rayStarts[i], rayEnds[i], &time) &&
+               (nearestIndex == TMX_NO_OBJECT || time < nearestTime))
+            {
+                nearestIndex = objectIndex;
+                nearestTime = time;
+            }
+        }
+        
+        for(int pass = 0;
+            pass < (bvh ? 2 : 1);
+            pass++)
+        {
+            group->bvh = pass == 0 ? bvh : 0;
+            TmxRaycastHit hit = {};
+            bool rayHit = RaycastTMXObjectGroup(group, rayStarts[i], rayEnds[i], &hit);
+            
+            // Objects hit at nearly the same time may be told apart either way, so a different object is only wrong
+            // if it isn't hit at about the same time
+            float hitTime;
+            bool same = rayHit == (nearestIndex != TMX_NO_OBJECT);
+            if(same && rayHit)
+            {
+                same = fabsf(hit.time - nearestTime) <= tolerance &&
+                       (hit.objectIndex == nearestIndex ||
+                        (IntersectBenchObject(&group->objects[hit.objectIndex], rayStarts[i], rayEnds[i], &hitTime) &&
+                         fabsf(hitTime - nearestTime) <= tolerance));
+            }
+            if(!same)
+            {
+                mismatches++;
+                break;
+            }
+        }
+    }
+    group->bvh = bvh;
+    
+    return(mismatches);
+}
+
+// When the segment first hits the object, by the rules RaycastTMXObjectGroup() documents. A polygon's points are its
+// centroid, its vertices and its first vertex again, and it is hit at once if the segment begins inside it. A
+// polyline's points are its vertices and its first vertex again, and it doesn't close.
+static bool
+IntersectBenchObject(TmxObject *object, Vector2 from, Vector2 to, float *hitTime)
+{
+    Vector2 delta = { to.x - from.x, to.y - from.y };
+    if(object->type == OBJECT_TYPE_POLYGON || object->type == OBJECT_TYPE_POLYLINE)
+    {
+        bool isPolygon = object->type == OBJECT_TYPE_POLYGON;
+        Vector2 position = { (float)object->x, (float)object->y };
+        Vector2 *vertices = object->points + (isPolygon ? 1 : 0);
+        int verticesLength = (int)object->pointsLength - (isPolygon ? 2 : 1);
+        
+        if(isPolygon)
+        {
+            // Even-odd rule: a ray from the start crosses the outline an odd number of times from inside
+            bool inside = false;
+            for(int i = 0, j = verticesLength - 1;
+                i < verticesLength;
+                j = i++)
+            {
+                Vector2 a = { position.x + vertices[i].x, position.y + vertices[i].y };
+                Vector2 b = { position.x + vertices[j].x, position.y + vertices[j].y };
+                if((a.y > from.y) != (b.y > from.y) && from.x < (b.x - a.x) * (from.y - a.y) / (b.y - a.y) + a.x)
+                {
+                    inside = !inside;
+                }
+            }
+            if(inside)
+            {
+                *hitTime = 0.0f;
+                return(true);
+            }
+        }
+        
+        bool hit = false;
+        for(int i = 0;
+            i < verticesLength - (isPolygon ? 0 : 1);
+            i++)
+        {
+            Vector2 start = vertices[i];
+            Vector2 end = vertices[(i + 1) % verticesLength];
+            start = { position.x + start.x, position.y + start.y };
+            end = { position.x + end.x, position.y + end.y };
+            float time;
+            if(IntersectBenchEdge(from, delta, start, end, &time) && (!hit || time < *hitTime))
+            {
+                *hitTime = time;
+                hit = true;
+            }
+        }
+        return(hit);
+    }
+    if(object->type == OBJECT_TYPE_POINT) return(false);
+    
+    // Everything else is its box. Along an edge counts, as does beginning inside.
+    Rectangle box = object->aabb;
+    float boxMin[2] = { box.x, box.y };
+    float boxMax[2] = { box.x + box.width, box.y + box.height };
+    float start[2] = { from.x, from.y };
+    float step[2] = { delta.x, delta.y };
+    float entry = 0.0f;
+    float exit = 1.0f;
+    for(int axis = 0;
+        axis < 2;
+        axis++)
+    {
+        if(step[axis] == 0.0f)
+        {
+            if(start[axis] < boxMin[axis] || start[axis] > boxMax[axis]) return(false);
+            continue;
+        }
+        float nearTime = ((step[axis] > 0.0f ? boxMin[axis] : boxMax[axis]) - start[axis]) / step[axis];
+        float farTime = ((step[axis] > 0.0f ? boxMax[axis] : boxMin[axis]) - start[axis]) / step[axis];
+        if(nearTime > entry) entry = nearTime;
+        if(farTime < exit) exit = farTime;
+    }
+    if(entry > exit) return(false);
+    
+    *hitTime = entry;
+    return(true);
+}
+
+// Where along the segment it crosses the edge, ends included. Parallel edges are never crossed.
+static bool
+IntersectBenchEdge(Vector2 from, Vector2 delta, Vector2 start, Vector2 end, float *hitTime)
+{
+    Vector2 edge = { end.x - start.x, end.y - start.y };
+    float denominator = delta.x * edge.y - delta.y * edge.x;
+    if(denominator == 0.0f) return(false);
+    
+    Vector2 offset = { start.x - from.x, start.y - from.y };
+    float time = (offset.x * edge.y - offset.y * edge.x) / denominator;
+    float along = (offset.x * delta.y - offset.y * delta.x) / denominator;
+    if(time < 0.0f || time > 1.0f || along < 0.0f || along > 1.0f) return(false);
+    
+    *hitTime = time;
+    return(true);
+}
+
+// One tileset of BENCH_TILESET_TILES tiles, then the tile layers, then an object group of slopes, polylines and
+// rectangles. GIDs are pseudo-random with a quarter left empty and some flipped, which is roughly how a hand-made
+// level looks.
+static bool
+WriteBenchMap(const char *fileName, BenchMapSpec spec)
+{
+    BenchText text = {};
+    AppendText(&text, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               "<map version=\"1.10\" orientation=\"orthogonal\" renderorder=\"right-down\" width=\"%d\" "
+               "height=\"%d\" tilewidth=\"%d\" tileheight=\"%d\" infinite=\"0\" nextlayerid=\"%d\" "
+               "nextobjectid=\"%d\">\n", spec.width, spec.height, BENCH_TILE_SIZE, BENCH_TILE_SIZE,
+               spec.layers + 2, spec.objects + 1);
+    AppendText(&text, " <tileset firstgid=\"1\" name=\"bench\" tilewidth=\"%d\" tileheight=\"%d\" tilecount=\"%d\" "
+               "columns=\"%d\">\n  <image source=\"bench.png\" width=\"%d\" height=\"%d\"/>\n </tileset>\n",
+               BENCH_TILE_SIZE, BENCH_TILE_SIZE, BENCH_TILESET_TILES, BENCH_TILESET_COLUMNS,
+               BENCH_TILESET_COLUMNS * BENCH_TILE_SIZE,
+               (BENCH_TILESET_TILES / BENCH_TILESET_COLUMNS) * BENCH_TILE_SIZE);
+    
+    uint32_t randomState = 0x2545F491;
+    int gidCount = spec.width * spec.height;
+    uint32_t *gids = (uint32_t *)MemAlloc((unsigned int)(gidCount * sizeof(uint32_t)));
+    for(int layerIndex = 0;
+        layerIndex < spec.layers;
+        layerIndex++)
+    {
+        for(int i = 0;
+            i < gidCount;
+            i++)
+        {
+            uint32_t random = NextRandom(&randomState);
+            gids[i] = (random % 4 == 0) ? 0 : 1 + (random >> 8) % BENCH_TILESET_TILES;
+            if(gids[i] && (random >> 4) % 16 == 0) gids[i] |= 0x80000000; // Flipped horizontally
+        }
+        
+        AppendText(&text, " <layer id=\"%d\" name=\"Tiles %d\" width=\"%d\" height=\"%d\">\n", layerIndex + 1,
+                   layerIndex + 1, spec.width, spec.height);
+        EncodeTileData(&text, gids, gidCount, spec.encoding);
+        AppendText(&text, " </layer>\n");
+    }
+    MemFree(gids);
+    
+    AppendText(&text, " <objectgroup id=\"%d\" name=\"Collision\">\n", spec.layers + 1);
+    int mapWidth = spec.width * BENCH_TILE_SIZE;
+    int mapHeight = spec.height * BENCH_TILE_SIZE;
+    for(int i = 0;
+        i < spec.objects;
+        i++)
+    {
+        int width = BENCH_TILE_SIZE * (1 + (int)(NextRandom(&randomState) % 8));
+        int height = BENCH_TILE_SIZE * (1 + (int)(NextRandom(&randomState) % 4));
+        int x = (int)(NextRandom(&randomState) % (uint32_t)mapWidth);
+        int y = (int)(NextRandom(&randomState) % (uint32_t)mapHeight);
+        if(i < spec.slopes)
+        {
+            // A right triangle along the bottom of the same box, rising to the right or to the left
+            bool risesRight = (NextRandom(&randomState) % 2) == 0;
+            AppendText(&text, "  <object id=\"%d\" x=\"%d\" y=\"%d\">\n   <polygon points=\"0,0 %d,0 %d,%d\"/>\n"
+                       "  </object>\n", i + 1, x, y + height, width, risesRight ? width : 0, -height);
+        }
+        else if(i < spec.slopes + spec.polylines)
+        {
+            // Every other one is open, a ramp up to a ledge, and the rest come back to where they start
+            if(i % 2 == 0)
+            {
+                AppendText(&text, "  <object id=\"%d\" x=\"%d\" y=\"%d\">\n"
+                           "   <polyline points=\"0,0 %d,%d %d,%d\"/>\n  </object>\n", i + 1, x, y + height,
+                           width / 2, -height, width, -height);
+            }
+            else
+            {
+                AppendText(&text, "  <object id=\"%d\" x=\"%d\" y=\"%d\">\n"
+                           "   <polyline points=\"0,0 %d,0 %d,%d 0,0\"/>\n  </object>\n", i + 1, x, y + height, width,
+                           width / 2, -height);
+            }
+        }
+        else
+        {
+            AppendText(&text, "  <object id=\"%d\" x=\"%d\" y=\"%d\" width=\"%d\" height=\"%d\"/>\n", i + 1, x, y,
+                       width, height);
+        }
+    }
+    AppendText(&text, " </objectgroup>\n</map>\n");
+    
+    bool saved = text.data && SaveFileText(fileName, text.data);
+    MemFree(text.data);
+    return(saved);
+}
+
+static void
+AppendText(BenchText *text, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int needed = vsnprintf(0, 0, format, args);
+    va_end(args);
+    if(needed < 0) return;
+    
+    if(text->length + needed + 1 > text->capacity)
+    {
+        int capacity = text->capacity ? text->capacity : 4096;
+        while(text->length + needed + 1 > capacity) capacity *= 2;
+        char *data = (char *)MemRealloc(text->data, (unsigned int)capacity);
+        if(!data) return;
+        text->data = data;
+        text->capacity = capacity;
+    }
+    
+    va_start(args, format);
+    vsnprintf(text->data + text->length, needed + 1, format, args);
+    va_end(args);
+    text->length += needed;
+}
+
+// Writes the <data> element the way Tiled would for the encoding
+static void
+EncodeTileData(BenchText *text, uint32_t *gids, int gidCount, BenchEncoding encoding)
+{
+    if(encoding == BENCH_ENCODING_CSV)
+    {
+        AppendText(text, "  <data encoding=\"csv\">\n");
+        for(int i = 0;
+            i < gidCount;
+            i++)
+        {
+            AppendText(text, i + 1 < gidCount ? "%u," : "%u\n", gids[i]);
+        }
+        AppendText(text, "</data>\n");
+        return;
+    }
+    
+    // Tiled's binary layout is little-endian 32-bit GIDs
+    int byteCount = gidCount * 4;
+    unsigned char *bytes = (unsigned char *)MemAlloc((unsigned int)byteCount);
+    for(int i = 0;
+        i < gidCount;
+        i++)
+    {
+        bytes[i*4 + 0] = (unsigned char)(gids[i] & 0xFF);
+        bytes[i*4 + 1] = (unsigned char)((gids[i] >> 8) & 0xFF);
+        bytes[i*4 + 2] = (unsigned char)((gids[i] >> 16) & 0xFF);
+        bytes[i*4 + 3] = (unsigned char)((gids[i] >> 24) & 0xFF);
+    }
+    
+    unsigned char *payload = bytes;
+    int payloadLength = byteCount;
+    if(encoding == BENCH_ENCODING_ZLIB)
+    {
+        // raylib compresses to a raw DEFLATE stream. zlib wraps that in a two-byte header and an Adler-32 trailer.
+        int deflatedLength = 0;
+        unsigned char *deflated = CompressData(bytes, byteCount, &deflatedLength);
+        payloadLength = deflatedLength + 6;
+        payload = (unsigned char *)MemAlloc((unsigned int)payloadLength);
+        payload[0] = 0x78;
+        payload[1] = 0x9C;
+        if(deflated) memcpy(payload + 2, deflated, deflatedLength);
+        uint32_t adler = Adler32(bytes, byteCount);
+        payload[payloadLength - 4] = (unsigned char)(adler >> 24);
+        payload[payloadLength - 3] = (unsigned char)(adler >> 16);
+        payload[payloadLength - 2] = (unsigned char)(adler >> 8);
+        payload[payloadLength - 1] = (unsigned char)adler;
+        MemFree(deflated);
+    }
+    
+    int encodedLength = 0;
+    char *encoded = EncodeDataBase64(payload, payloadLength, &encodedLength);
+    AppendText(text, "  <data encoding=\"base64\"%s>\n   %s\n  </data>\n",
+               encoding == BENCH_ENCODING_ZLIB ? " compression=\"zlib\"" : "", encoded ? encoded : "");
+    
+    MemFree(encoded);
+    if(payload != bytes) MemFree(payload);
+    MemFree(bytes);
+}
+
+static uint32_t
+Adler32(const unsigned char *data, int length)
+{
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for(int i = 0;
+        i < length;
+        i++)
+    {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return((b << 16) | a);
+}
+
+static BenchResult*
+AddBenchResult(BenchResults *results, const char *mapName, const char *measurement, const char *unit,
+               double *samples, int repeats)
+{
+    if(results->count == BENCH_MAX_RESULTS) return(0);
+    
+    BenchResult *result = &results->results[results->count++];
+    snprintf(result->name, sizeof(result->name), "%s/%s", mapName, measurement);
+    result->unit = unit;
+    result->repeats = repeats;
+    
+    double sum = 0.0;
+    for(int i = 0;
+        i < repeats;
+        i++)
+    {
+        sum += samples[i];
+    }
+    qsort(samples, repeats, sizeof(double), CompareDoubles);
+    result->median = samples[repeats / 2];
+    result->min = samples[0];
+    result->mean = sum / repeats;
+    
+    fprintf(stderr, "%-48s %12.3f %s\n", result->name, result->median, unit);
+    return(result);
+}
+
+// To stdout if no file name is given
+static bool
+WriteBenchResults(BenchResults *results, const char *fileName)
+{
+    FILE *file = fileName ? fopen(fileName, "w") : stdout;
+    if(!file) return(false);
+    
+    fprintf(file, "{\n  \"benchmarks\": [\n");
+    for(int i = 0;
+        i < results->count;
+        i++)
+    {
+        BenchResult *result = &results->results[i];
+        fprintf(file, "    { \"name\": \"%s\", \"unit\": \"%s\", \"repeats\": %d, \"median\": %.6f, \"min\": %.6f, "
+                "\"mean\": %.6f }%s\n", result->name, result->unit, result->repeats, result->median, result->min,
+                result->mean, i + 1 < results->count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    
+    bool written = (ferror(file) == 0);
+    if(file != stdout) fclose(file);
+    return(written);
+}
+
+// xorshift32, so every run generates the same maps and queries
+static uint32_t
+NextRandom(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return(x);
+}
+
+static Texture2D
+LoadNoTexture(const char *fileName)
+{
+    Texture2D texture = {};
+    return(texture);
+}
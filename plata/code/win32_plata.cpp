@@ -21,27 +21,18 @@
 // DON'T include windows.h at all - use this workaround instead:
 //extern "C" __declspec(dllimport) void __stdcall OutputDebugStringA(const char* lpOutputString);
 
-extern "C" 
-{
-#include "raytmx.h"
-}
+#include "plata_sim.cpp"
 
-#define GRAVITY 400
-#define PLAYER_JUMP_SPD 350.0f
-#define PLAYER_HOR_SPD 300.0f
-#define MAX_PROJECTILES 20
-#define PROJECTILE_SPEED 900.0f
+#define MAP_PATH "plata/data/plata.tmx"
+#define MAP_BINARY_PATH "plata/data/plata.tmxb"
+#define MAP_CHUNK_TILES 16
+#define SIM_MAX_STEPS_PER_FRAME 8
+#define MAP_UPLOAD_BUDGET 0.004 // Seconds of each loading frame spent uploading the map's textures
+#define MAP_RESIDENT_CHUNKS_RADIUS 2 // Chunks of an infinite map kept decoded on each side of the camera
 
 //----------------------------------------------------------------------------------
 // Types and Structures Definition
 //----------------------------------------------------------------------------------
-typedef struct Projectile
-{
-    Vector2 velocity;
-    Vector2 position;
-    bool active;
-} Projectile;
-
 typedef struct AnimationRectangles
 {
     Rectangle source;
@@ -58,14 +49,6 @@ typedef struct PlayerTextures
     Texture2D idle_left_fire;
 } PlayerTextures;
 
-typedef struct AnimationFrame
-{
-    int currentFrame;
-    int frameCount;
-    float frameTimer;
-    float frameSpeed;
-} AnimationFrame;
-
 typedef enum
 {
     PISTOL_SOUND_FIRE = 0,
@@ -75,73 +58,36 @@ typedef enum
     PISTOL_SOUND_COUNT
 } PistolSoundType;
 
-typedef struct Gun
-{
-    float coolDown;;
-    int rounds;
-    int roundsPerMagazine;
-    bool overHeated;
-    float overHeatTimer;
-    
-    Projectile bullets[MAX_PROJECTILES];
-    float bulletRadius;
-    float bulletSpeed;
-    
-    Sound pistolSounds[PISTOL_SOUND_COUNT];
-} Gun;
-
-typedef struct Player {
-    Vector2 position;
-    float velocityX;
-    float velocityY;
-    float height;
-    float width;
-    bool facingRight;
-    bool canJump;
-    bool inAir;
-    bool idle;
-    bool gunFiring;
-    
-    // Running animation
-    AnimationFrame running;
-    
-    // Gun firing animation
-    AnimationFrame firing;
-    
-    // Gun parameters
-    Gun gun;
-} Player;
-
 typedef struct GameState
 {
     int screenWidth;
     int screenHeight;
+    
+    Sound pistolSounds[PISTOL_SOUND_COUNT];
+    
+    bool showProfiler;
 } GameState;
 
 //----------------------------------------------------------------------------------
 // Function Forward Declarations / Prototypes
 //----------------------------------------------------------------------------------
-void UpdatePlayer(Player *player, TmxMap *map, float delta);
-static TmxObjectGroup *GetCollisionLayer(TmxMap *map);
-static void UpdatePlayerMovement(Player *player, float delta);
-static void UpdatePlayerHorizontalCollision(Player *player, TmxObjectGroup *objGroup, float delta);
-static void UpdatePlayerVerticalCollision(Player *player, TmxObjectGroup *objGroup, float delta);
-static void UpdatePlayerAnimation(Player *player, float delta);
-static void UpdatePlayerWeapon(Player *player, float delta);
-static void UpdateBullets(Projectile *projectiles, GameState *gameState, float delta);
-void DrawPlayer(Player *player, PlayerTextures *textures);
-void DrawBullets(Projectile *projectiles);
+static void PollPlayerInput(PlayerInput *input);
+static void PlaySimEventSounds(SimState *sim, GameState *gameState);
+static TmxMap *LoadMapWithLoadingScreen(const char *fileName);
+static void DrawProfilerOverlay(int posX, int posY);
+void DrawPlayer(Player *player, PlayerTextures *textures, Vector2 position);
+void DrawBullets(ProjectilePool *pool, float alpha);
+void DrawImpacts(SimState *sim);
 int InitPlayerTextures(PlayerTextures *playerTextures);
 void UnloadPlayerTextures(PlayerTextures *playerTextures);
-void UnloadSounds(Gun *pistol);
-static void SpawnBullet(Player *player);
-int InitPlayer(Player *player, PlayerTextures *textures);
-AnimationRectangles GenerateAnimationRectangle(Player *player, AnimationFrame *sheet, Texture2D *texture);
+void InitSounds(GameState *gameState);
+void UnloadSounds(GameState *gameState);
+AnimationRectangles GenerateAnimationRectangle(Vector2 position, AnimationFrame *sheet, Texture2D *texture);
 
 //------------------------------------------------------------------------------------
 // Program main entry point
 //------------------------------------------------------------------------------------
-int main(void)
+int main(int argc, char **argv)
 {
     // For debugging
     //OutputDebugStringA("=== REACHED MAIN===\n");
@@ -151,6 +97,7 @@ int main(void)
     GameState gameState = {};
     gameState.screenWidth = 1024;
     gameState.screenHeight = 768;
+    gameState.showProfiler = false;
     
     InitWindow(gameState.screenWidth, gameState.screenHeight, "raylib [core] example - 2d camera platformer");
     SetWindowPosition(60, 30);
@@ -160,20 +107,107 @@ int main(void)
     PlayerTextures playerTextures = {};
     InitPlayerTextures(&playerTextures);
     
-    // Load tilemap
-    TmxMap* map = LoadTMX("plata/data/plata.tmx");
+    // "-bake" re-parses the TMX, writes the baked .tmxb next to it, and exits.
+    // "-record file" saves this session's input when the window closes. "-replay file" plays one back instead of
+    // reading the keyboard, and exits when it runs out. "-trace file.json" dumps the profiler's most recent zones
+    // as a Chrome trace when the window closes.
+    bool bakeMap = false;
+    const char *recordPath = 0;
+    const char *replayPath = 0;
+    const char *tracePath = 0;
+    for(int argIndex = 1;
+        argIndex < argc;
+        argIndex++)
+    {
+        if(strcmp(argv[argIndex], "-bake") == 0)
+        {
+            bakeMap = true;
+        }
+        else if(strcmp(argv[argIndex], "-record") == 0 && argIndex + 1 < argc)
+        {
+            recordPath = argv[++argIndex];
+        }
+        else if(strcmp(argv[argIndex], "-replay") == 0 && argIndex + 1 < argc)
+        {
+            replayPath = argv[++argIndex];
+        }
+        else if(strcmp(argv[argIndex], "-trace") == 0 && argIndex + 1 < argc)
+        {
+            tracePath = argv[++argIndex];
+        }
+    }
+    
+    // Load tilemap. The baked map skips XML parsing but is ignored once the TMX is edited after baking.
+    TmxMap* map = 0;
+    if(!bakeMap && FileExists(MAP_BINARY_PATH) && GetFileModTime(MAP_BINARY_PATH) >= GetFileModTime(MAP_PATH))
+    {
+        map = LoadTMXBinary(MAP_BINARY_PATH);
+    }
+    if(map == 0)
+    {
+        map = LoadMapWithLoadingScreen(MAP_PATH);
+    }
     if(map == 0)
     {
-        TraceLog(LOG_ERROR, "Failed to load TMX \"%s\"", "plata/data/plata.tmx");
+        TraceLog(LOG_ERROR, "Failed to load TMX \"%s\"", MAP_PATH);
         return(1);
     }
     
-    Player player = {};
-    InitPlayer(&player, &playerTextures);
+    if(bakeMap)
+    {
+        bool baked = ExportTMXBinary(map, MAP_BINARY_PATH);
+        UnloadTMX(map);
+        UnloadPlayerTextures(&playerTextures);
+        CloseAudioDevice();
+        CloseWindow();
+        return(baked ? 0 : 1);
+    }
+    
+    // Pre-render the tile layers so drawing them is a few chunk quads per frame
+    LoadTMXRenderCache(map, MAP_CHUNK_TILES);
     
+    InitSounds(&gameState);
+    
+    SimState sim = {};
+    float spriteWidth = (float)playerTextures.idle_right.width;
+    float spriteHeight = (float)playerTextures.idle_right.height;
+    
+    InputRecording replay = {};
+    if(replayPath)
+    {
+        if(!LoadInputRecording(&replay, replayPath))
+        {
+            TraceLog(LOG_ERROR, "Failed to load input recording \"%s\"", replayPath);
+            replayPath = 0;
+        }
+        else if(HashSimMap(map) != replay.header.mapHash)
+        {
+            TraceLog(LOG_ERROR, "\"%s\" was recorded on a different map than \"%s\"", replayPath, MAP_PATH);
+            UnloadInputRecording(&replay);
+            replayPath = 0;
+        }
+        else
+        {
+            spriteWidth = replay.header.spriteWidth;
+            spriteHeight = replay.header.spriteHeight;
+        }
+    }
+    
+    SimInit(&sim, map, spriteWidth, spriteHeight);
+    Player *player = &sim.player;
+    
+    InputRecording recording = {};
+    if(recordPath) InitInputRecording(&recording, MAP_PATH, HashSimMap(map), spriteWidth, spriteHeight);
+    
+    PlayerInput input = {};
+    bool replayFinished = false;
+    uint64_t replayMismatches = 0;
+    
+    // Frame time not yet simulated. The simulation advances in whole SIM_DT ticks regardless of the frame rate.
+    float accumulator = 0.0f;
     
     Camera2D camera = {};
-    camera.target = player.position;
+    camera.target = player->position;
     camera.offset = { gameState.screenWidth/2.0f, gameState.screenHeight/2.0f };
     camera.rotation = 0.0f;
     camera.zoom = 1.0f;
@@ -182,17 +216,61 @@ int main(void)
     //--------------------------------------------------------------------------------------
     
     // Main game loop
-    while (!WindowShouldClose())
+    while (!WindowShouldClose() && !replayFinished)
     {
         // Update
         //----------------------------------------------------------------------------------
-        float deltaTime = GetFrameTime();
+        PollPlayerInput(&input);
+        if(IsKeyPressed(KEY_F3)) gameState.showProfiler = !gameState.showProfiler;
+        
+        // Cap the catch-up after a hitch. Past this the game slows down rather than falling further behind.
+        float frameTime = GetFrameTime();
+        if(frameTime > SIM_MAX_STEPS_PER_FRAME * SIM_DT) frameTime = SIM_MAX_STEPS_PER_FRAME * SIM_DT;
+        accumulator += frameTime;
+        
+        SimClearEvents(&sim);
+        while(accumulator >= SIM_DT)
+        {
+            if(replayPath)
+            {
+                if(sim.tick >= replay.header.frameCount)
+                {
+                    replayFinished = true;
+                    break;
+                }
+                UnpackPlayerInput(replay.frames[sim.tick].input, &input);
+            }
+            uint32_t inputBits = PackPlayerInput(&input);
+            
+            SimStep(&sim, &input, SIM_DT);
+            
+            if(replayPath && HashSimState(&sim) != replay.frames[sim.tick - 1].stateHash)
+            {
+                if(replayMismatches == 0)
+                {
+                    TraceLog(LOG_WARNING, "Replay diverged from the recording at tick %llu",
+                             (unsigned long long)(sim.tick - 1));
+                }
+                replayMismatches++;
+            }
+            if(recordPath) AppendInputRecordingFrame(&recording, inputBits, HashSimState(&sim));
+            
+            accumulator -= SIM_DT;
+        }
+        PlaySimEventSounds(&sim, &gameState);
         
-        UpdatePlayer(&player, map, deltaTime);
-        UpdateBullets(player.gun.bullets, &gameState, deltaTime);
+        // Draw between the last two ticks by however far the leftover time is into the next one
+        float alpha = accumulator / SIM_DT;
+        Vector2 playerDrawPosition = Vector2Lerp(player->previousPosition, player->position, alpha);
         
-        camera.target.x = floorf(player.position.x);
-        camera.target.y = floorf(player.position.y);
+        camera.target.x = floorf(playerDrawPosition.x);
+        camera.target.y = floorf(playerDrawPosition.y);
+        
+        // Infinite maps only keep the chunks around the camera decoded
+        UpdateTMXChunkResidency(map, camera, MAP_RESIDENT_CHUNKS_RADIUS);
+        
+        // Chunks with animated tiles are re-rendered here, outside of BeginMode2D()
+        UpdateTMXRenderCache(map);
         
         //----------------------------------------------------------------------------------
         // Draw
@@ -205,30 +283,59 @@ int main(void)
         BeginMode2D(camera);
         
         //AnimateTMX(map);
-        DrawTMX(map, &camera, 0, 0, 0, WHITE);
+        {
+            PROFILE_ZONE("DrawTMX");
+            DrawTMX(map, &camera, 0, 0, 0, WHITE);
+        }
         
-        DrawPlayer(&player, &playerTextures);
-        DrawBullets(player.gun.bullets);
+        DrawPlayer(player, &playerTextures, playerDrawPosition);
+        DrawBullets(&player->gun.bullets, alpha);
+        DrawImpacts(&sim);
         
         EndMode2D();
         
         // Debug Information
-        DrawText(TextFormat("Jumping: %s", player.inAir ? "true" : "false"), 
+        DrawText(TextFormat("Jumping: %s", player->inAir ? "true" : "false"), 
                  10, 10, 20, RED);
         
-        DrawText(TextFormat("Firing: %s", player.gunFiring ? "true" : "false"), 
+        DrawText(TextFormat("Firing: %s", player->gunFiring ? "true" : "false"), 
                  10, 30, 20, RED);
         
-        EndDrawing();
+        if(gameState.showProfiler) DrawProfilerOverlay(10, 60);
+        
+        {
+            PROFILE_ZONE("EndDrawing");
+            EndDrawing();
+        }
+        
+        // Fold this frame's zones, simulation ticks included, into the overlay's percentiles
+        ProfilerEndFrame();
         
         //----------------------------------------------------------------------------------
     }
     
     // De-Initialization
     //--------------------------------------------------------------------------------------
+    if(replayPath)
+    {
+        TraceLog(LOG_INFO, "Replayed %llu ticks, %llu diverged", (unsigned long long)sim.tick,
+                 (unsigned long long)replayMismatches);
+    }
+    if(recordPath && !SaveInputRecording(&recording, recordPath))
+    {
+        TraceLog(LOG_ERROR, "Failed to save input recording \"%s\"", recordPath);
+    }
+    UnloadInputRecording(&recording);
+    UnloadInputRecording(&replay);
     UnloadTMX(map);
     UnloadPlayerTextures(&playerTextures);
-    UnloadSounds(&player.gun);
+    UnloadSounds(&gameState);
+    SimShutdown(&sim);
+    if(tracePath && !ProfilerWriteChromeTrace(tracePath))
+    {
+        TraceLog(LOG_WARNING, "Failed to write profile trace \"%s\"", tracePath);
+    }
+    ProfilerShutdown();
     CloseAudioDevice();
     CloseWindow();        // Close window and OpenGL context
     //--------------------------------------------------------------------------------------
@@ -236,434 +343,155 @@ int main(void)
     return 0;
 }
 
-void
-UpdatePlayer(Player *player, TmxMap *map, float delta)
-{
-    TmxObjectGroup *collisionGroup = GetCollisionLayer(map);
-    if(!collisionGroup) return;
-    
-    UpdatePlayerMovement(player, delta);
-    UpdatePlayerHorizontalCollision(player, collisionGroup, delta);
-    UpdatePlayerVerticalCollision(player, collisionGroup, delta);
-    UpdatePlayerAnimation(player, delta);
-    UpdatePlayerWeapon(player, delta);
-}
-
-static TmxObjectGroup*
-GetCollisionLayer(TmxMap *map)
-{
-    for(uint32_t i = 0;
-        i < map->layersLength;
-        i++)
-    {
-        if(map->layers[i].type == LAYER_TYPE_OBJECT_GROUP &&
-           TextIsEqual(map->layers[i].name, "Collision"))
-        {
-            return &map->layers[i].exact.objectGroup;
-        }
-    }
-    
-    TraceLog(LOG_ERROR, "Could not locate Collision layer");
-    return(0);
-}
-
 static void
-UpdatePlayerMovement(Player *player, float delta)
+PollPlayerInput(PlayerInput *input)
 {
-    // Movement
-    float acceleration = 1000.0f;
-    float deceleration = 600.0f;
-    float max_speed = PLAYER_HOR_SPD;
-    
-    float inputX = 0.0f;
-    if(IsKeyDown(KEY_LEFT) && !player->inAir)
-    {
-        inputX = -1.0f;
-        player->facingRight = false;
-    }
-    if(IsKeyDown(KEY_RIGHT) && !player->inAir)
-    {
-        inputX = 1.0f;
-        player->facingRight = true;
-    }
-    
-    // Apply acceleration and deceleration
-    if(inputX != 0.0f)
-    {
-        player->velocityX += inputX * acceleration * delta;
-        
-        // Clamp to max speed
-        player->velocityX = Clamp(player->velocityX, -max_speed, max_speed);
-    }
-    else if(!player->inAir)
-    {
-        float decelerateAmount = deceleration * delta;
-        
-        if(player->velocityX > 0)
-        {
-            player->velocityX -= decelerateAmount;
-            if(player->velocityX < 0) player->velocityX = 0;
-        }
-        else if(player->velocityX < 0)
-        {
-            player->velocityX += decelerateAmount;
-            if(player->velocityX > 0) player->velocityX = 0;
-        }
-    }
-    
-    // Jumping
-    if(IsKeyPressed(KEY_SPACE) && player->canJump)
-    {
-        player->velocityY = -PLAYER_JUMP_SPD;
-        player->canJump = false;
-        player->inAir = true;
-    }
-    
-    if(IsKeyReleased(KEY_SPACE) && player->velocityY < 0)
-    {
-        player->velocityY *= 0.5f;
-    }
+    input->moveLeft = IsKeyDown(KEY_LEFT);
+    input->moveRight = IsKeyDown(KEY_RIGHT);
+    input->fireDown = IsKeyDown(KEY_BACKSPACE);
+    
+    // A frame may run zero ticks, so edges are only ever set here and are cleared once a tick has seen them
+    if(IsKeyPressed(KEY_SPACE)) input->jumpPressed = true;
+    if(IsKeyReleased(KEY_SPACE)) input->jumpReleased = true;
+    if(IsKeyPressed(KEY_BACKSPACE)) input->firePressed = true;
+    if(IsKeyPressed(KEY_R)) input->reloadPressed = true;
 }
 
 static void
-UpdatePlayerHorizontalCollision(Player *player, TmxObjectGroup *objGroup, float delta)
+PlaySimEventSounds(SimState *sim, GameState *gameState)
 {
-    float moveX = player->velocityX * delta;
-    
-    // Player hitbox
-    float playerLeft = player->position.x - player->width / 2;
-    float playerRight = player->position.x + player->width / 2;
-    float playerTop = player->position.y - player->height;
-    float playerBottom = player->position.y;
-    
-    float futureLeft = playerLeft + moveX;
-    float futureRight = playerRight + moveX;
-    
-    for(uint32_t i = 0;
-        i < objGroup->objectsLength;
+    for(int i = 0;
+        i < sim->eventCount;
         i++)
     {
-        TmxObject *obj = &objGroup->objects[i];
-        if(obj->type != OBJECT_TYPE_RECTANGLE) continue;
-        
-        float wallLeft = (float)obj->x;
-        float wallRight = (float)(obj->x + obj->width);
-        float wallTop = (float)obj->y;
-        float wallBottom = (float)(obj->y + obj->height);
-        
-        // Check if player overlaps vertically with wall
-        if(playerBottom > wallTop && playerTop < wallBottom)
+        switch(sim->events[i].type)
         {
-            // Moving right and hitting wall with playerTop
-            if(moveX > 0 && playerRight <= wallLeft && futureRight >= wallLeft)
-            {
-                player->position.x = wallLeft - player->width / 2;
-                moveX = 0;
-                break;
-            }
-            // Moving left and hitting wall with playerTop
-            if(moveX < 0 && playerLeft >= wallRight && futureLeft <= wallRight)
-            {
-                player->position.x = wallRight + player->width / 2;
-                moveX = 0;
-                break;
-            }
+            case SIM_EVENT_GUN_FIRED: PlaySound(gameState->pistolSounds[PISTOL_SOUND_FIRE]); break;
+            case SIM_EVENT_GUN_DRY_FIRED: PlaySound(gameState->pistolSounds[PISTOL_SOUND_DRYFIRE]); break;
+            case SIM_EVENT_GUN_RELOADED: PlaySound(gameState->pistolSounds[PISTOL_SOUND_RELOAD]); break;
+            case SIM_EVENT_GUN_OVERHEATED: PlaySound(gameState->pistolSounds[PISTOL_SOUND_STEAM]); break;
+            default: break;
         }
     }
-    
-    player->position.x += moveX;
 }
 
-static void
-UpdatePlayerVerticalCollision(Player *player, TmxObjectGroup *objGroup, float delta)
+AnimationRectangles
+GenerateAnimationRectangle(Vector2 position, AnimationFrame *sheet, Texture2D *texture)
 {
-    bool hitObstacle = false;
-    float futureY = player->position.y + player->velocityY * delta;
+    float frameWidth = texture->width / sheet->frameCount; 
+    float frameHeight = texture->height;
     
-    // Recalculate player bounds after horizontal movement
-    float playerLeft = player->position.x - player->width / 2;
-    float playerRight = player->position.x + player->width / 2;
-    float playerTop = player->position.y - player->height;
-    float playerBottom = player->position.y;
+    AnimationRectangles rectangles;
     
-    for(uint32_t i = 0;
-        i < objGroup->objectsLength;
-        i++)
+    rectangles.source =
     {
-        TmxObject *obj = &objGroup->objects[i];
-        if(obj->type != OBJECT_TYPE_RECTANGLE) continue;
-        
-        float platformLeft = (float)obj->x;
-        float platformRight = (float)(obj->x + obj->width);
-        float platformTop = (float)obj->y;
-        float platformBottom = (float)(obj->y + obj->height);
-        
-        // Check if player overlaps horizontally
-        if(playerRight > platformLeft && playerLeft < platformRight)
-        {
-            // Landing on platform
-            if(player->velocityY >= 0 &&
-               playerBottom <= platformTop + 1.0f &&
-               futureY >= platformTop - 1.0f)
-            {
-                hitObstacle = true;
-                player->velocityY = 0.0f;
-                player->position.y = platformTop;
-                break;
-            }
-            
-            // Hitting ceiling
-            float futureTop = futureY - player->height;
-            if(player->velocityY < 0 &&
-               playerTop >= platformBottom &&
-               futureTop <= platformBottom)
-            {
-                player->velocityY = 0.0f;
-                player->position.y = platformBottom + player->height;
-                break;
-            }
-        }
-        
-        // NEW: Check if player would be inside wall after vertical movement
-        float futureTop = futureY - player->height;
-        float futureBottom = futureY;
-        
-        if(playerRight > platformLeft && playerLeft < platformRight &&
-           futureBottom > platformTop && futureTop < platformBottom)
-        {
-            // Player would be inside this wall - push them out horizontally
-            float playerCenterX = player->position.x;
-            float wallCenterX = platformLeft + (platformRight - platformLeft) / 2;
-            
-            if(playerCenterX < wallCenterX)
-            {
-                player->position.x = platformLeft - player->width / 2;
-            }
-            else
-            {
-                player->position.x = platformRight + player->width / 2;
-            }
-            
-            // Recalculate bounds for next iteration
-            playerLeft = player->position.x - player->width / 2;
-            playerRight = player->position.x + player->width / 2;
-        }
-        
-        // Check if player is in the air
-        if(futureY < platformBottom) player->inAir = true;
-        
-    }
+        sheet->currentFrame * frameWidth,
+        0,
+        frameWidth,
+        frameHeight
+    };
     
-    if(!hitObstacle)
-    {
-        player->position.y += player->velocityY * delta;
-        player->velocityY += GRAVITY * delta;
-        player->canJump = false;
-    }
-    else
-    {
-        player->canJump = true;
-        player->inAir = false;
-    }
-}
-
-static void
-UpdatePlayerAnimation(Player *player, float delta)
-{
-    if(!player->inAir && player->velocityX != 0)
-    {
-        player->idle = false;
-        player->running.frameTimer += delta;
-        if(player->running.frameTimer >= player->running.frameSpeed)
-        {
-            player->running.frameTimer = 0.0f;
-            player->running.currentFrame++;
-            
-            if(player->running.currentFrame >= player->running.frameCount)
-                player->running.currentFrame = 0;
-        }
-    }
-    else
+    rectangles.destination =
     {
-        player->idle = true;
-    }
+        position.x - frameWidth / 2,
+        position.y - frameHeight,
+        frameWidth,
+        frameHeight
+    };
+    
+    return rectangles;
 }
 
-static void
-SpawnBullet(Player *player)
+void
+DrawBullets(ProjectilePool *pool, float alpha)
 {
     for(int i = 0;
-        i < MAX_PROJECTILES;
+        i < pool->count;
         i++)
     {
-        if(!player->gun.bullets[i].active)
+        Vector2 position =
         {
-            player->gun.bullets[i].active = true;
-            player->gun.bullets[i].position.x = player->position.x;
-            player->gun.bullets[i].position.y = player->position.y - 33;
-            
-            float direction = player->facingRight ? 1.0f : -1.0f;
-            player->gun.bullets[i].velocity.x = direction * player->gun.bulletSpeed;
-            
-            // just fire one bullet
-            break;
-        }
+            Lerp(pool->previousX[i], pool->x[i], alpha),
+            Lerp(pool->previousY[i], pool->y[i], alpha)
+        };
+        DrawCircleV(position, 4.0f, YELLOW);
+        DrawCircleV(position, 2.0f, RED);
     }
 }
 
-static void
-UpdateBullets(Projectile *projectiles, GameState *gameState, float delta)
+void
+DrawImpacts(SimState *sim)
 {
     for(int i = 0;
-        i < MAX_PROJECTILES;
+        i < sim->eventCount;
         i++)
     {
-        if(projectiles[i].active)
+        if(sim->events[i].type == SIM_EVENT_PROJECTILE_IMPACT)
         {
-            projectiles[i].position.x +=  projectiles[i].velocity.x * delta;
-            
-            // Despawn if bullet is offscreen
-            if(projectiles[i].position.x < -400 || projectiles[i].position.x > gameState->screenWidth + 400)
-            {
-                projectiles[i].active = false;
-            }
+            DrawCircleV(sim->events[i].impact.position, 6.0f, ORANGE);
         }
     }
 }
 
-static void
-UpdatePlayerWeapon(Player *player, float delta)
+// Parses the map on a worker thread while the window keeps presenting frames, then uploads its textures a few at a
+// time per frame. Streaming in the next level while the current one plays is the same calls from inside the game loop.
+static TmxMap*
+LoadMapWithLoadingScreen(const char *fileName)
 {
-    player->gun.coolDown -= delta;
-    
-    // Handle overheat
-    if(player->gun.overHeated)
-    {
-        player->gun.overHeatTimer -= delta;
-        if(player->gun.overHeatTimer <= 0)
-        {
-            player->gun.overHeated = false;
-            
-        }
-        
-        // Exit function now if gun is overheated
-        return;
-    }
-    
-    // Rapid fire
-    if(IsKeyDown(KEY_BACKSPACE) && player->gun.coolDown <= 0 && player->gun.rounds > 0)
-    {
-        player->gunFiring = true;
-        SpawnBullet(player);
-        player->firing.currentFrame = 0;
-        PlaySound(player->gun.pistolSounds[PISTOL_SOUND_FIRE]);
-        
-        // Lower cool down if holding down fire
-        player->gun.coolDown = 0.1f;
-        player->gun.rounds--;
-        
-        // Check if mag is empty overheat
-        if(player->gun.rounds == 0)
-        {
-            player->gun.overHeated = true;
-            PlaySound(player->gun.pistolSounds[PISTOL_SOUND_STEAM]);
-        }
-        
-    }
+    TmxAsyncLoad *load = LoadTMXAsync(fileName);
+    if(!load) return(LoadTMX(fileName));
     
-    // Firing gun
-    if(IsKeyPressed(KEY_BACKSPACE) && player->gun.coolDown <= 0)
+    TmxAsyncLoadStatus status = ASYNC_LOAD_PARSING;
+    while((status == ASYNC_LOAD_PARSING || status == ASYNC_LOAD_UPLOADING) && !WindowShouldClose())
     {
-        if(player->gun.rounds > 0)
-        {
-            player->gunFiring = true;
-            SpawnBullet(player);
-            player->gun.rounds--;
-            player->firing.currentFrame = 0;
-            PlaySound(player->gun.pistolSounds[PISTOL_SOUND_FIRE]);
-            
-        }
-        else
-        {
-            PlaySound(player->gun.pistolSounds[PISTOL_SOUND_DRYFIRE]);
-        }
+        status = UpdateTMXAsync(load, MAP_UPLOAD_BUDGET);
         
+        BeginDrawing();
+        ClearBackground(BLACK);
+        DrawText(status == ASYNC_LOAD_PARSING ? "Loading..." : "Uploading textures...", 20, 20, 20, RAYWHITE);
+        EndDrawing();
     }
     
-    if(player->gunFiring)
-    {
-        
-        player->firing.frameTimer += delta;
-        if(player->firing.frameTimer >= player->firing.frameSpeed)
-        {
-            player->firing.frameTimer = 0.0f;
-            player->firing.currentFrame++;
-            
-            if(player->firing.currentFrame >= player->firing.frameCount)
-            {
-                player->gunFiring = false;
-                player->firing.currentFrame = 0;
-            }
-        }
-    }
-    
-    // Reloading
-    if(IsKeyPressed(KEY_R) && !player->gun.overHeated)
-    {
-        PlaySound(player->gun.pistolSounds[PISTOL_SOUND_RELOAD]);
-        player->gun.rounds = player->gun.roundsPerMagazine;
-    }
+    // Also finishes a load cut short by closing the window, so the map can be unloaded like any other
+    return(FinishTMXAsync(load));
 }
 
-AnimationRectangles
-GenerateAnimationRectangle(Player *player, AnimationFrame *sheet, Texture2D *texture)
-{
-    float frameWidth = texture->width / sheet->frameCount; 
-    float frameHeight = texture->height;
-    
-    AnimationRectangles rectangles;
-    
-    rectangles.source =
-    {
-        sheet->currentFrame * frameWidth,
-        0,
-        frameWidth,
-        frameHeight
-    };
-    
-    rectangles.destination =
-    {
-        player->position.x - frameWidth / 2,
-        player->position.y - frameHeight,
-        frameWidth,
-        frameHeight
-    };
-    
-    return rectangles;
-}
-
-void
-DrawBullets(Projectile *projectiles)
+// Rolling per-frame p50/p99 of every zone seen so far, in milliseconds
+static void
+DrawProfilerOverlay(int posX, int posY)
 {
-    for(int i = 0;
-        i < MAX_PROJECTILES;
-        i++)
+    int zoneCount = ProfilerGetZoneCount();
+    DrawRectangle(posX - 4, posY - 4, 420, 24 + zoneCount*18, Fade(BLACK, 0.6f));
+    DrawText("zone", posX, posY, 16, RAYWHITE);
+    DrawText("p50 ms", posX + 290, posY, 16, RAYWHITE);
+    DrawText("p99 ms", posX + 350, posY, 16, RAYWHITE);
+    
+    for(int zoneIndex = 0;
+        zoneIndex < zoneCount;
+        zoneIndex++)
     {
-        if(projectiles[i].active)
-        {
-            DrawCircleV(projectiles[i].position, 4.0f, YELLOW);
-            DrawCircleV(projectiles[i].position, 2.0f, RED);
-        }
+        const char *name = 0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+        if(!ProfilerGetZonePercentiles(zoneIndex, &name, &p50, &p99)) continue;
+        
+        int lineY = posY + 20 + zoneIndex*18;
+        DrawText(name, posX, lineY, 16, RAYWHITE);
+        DrawText(TextFormat("%.3f", p50 / 1000.0), posX + 290, lineY, 16, GREEN);
+        DrawText(TextFormat("%.3f", p99 / 1000.0), posX + 350, lineY, 16, YELLOW);
     }
 }
 
 void
-DrawPlayer(Player *player, PlayerTextures *textures)
+DrawPlayer(Player *player, PlayerTextures *textures, Vector2 position)
 {
+    PROFILE_ZONE("DrawPlayer");
+    
     // Shooting gun
     if(player->gunFiring)
     {
-        AnimationRectangles rectangle = GenerateAnimationRectangle(player, &player->firing, &textures->idle_right_fire);
+        AnimationRectangles rectangle =
+            GenerateAnimationRectangle(position, &player->firing, &textures->idle_right_fire);
         
         if(player->facingRight)
         {
@@ -677,7 +505,7 @@ DrawPlayer(Player *player, PlayerTextures *textures)
     }
     else if(!player->idle)
     {
-        AnimationRectangles rectangle = GenerateAnimationRectangle(player, &player->running, &textures->run_right);
+        AnimationRectangles rectangle = GenerateAnimationRectangle(position, &player->running, &textures->run_right);
         
         if(player->facingRight)
         {
@@ -693,15 +521,15 @@ DrawPlayer(Player *player, PlayerTextures *textures)
         if(player->facingRight)
         {
             DrawTexture(textures->idle_right,
-                        (int)(player->position.x - textures->idle_right.width / 2),
-                        (int)(player->position.y - textures->idle_right.height),
+                        (int)(position.x - textures->idle_right.width / 2),
+                        (int)(position.y - textures->idle_right.height),
                         WHITE);
         }
         else
         {
             DrawTexture(textures->idle_left,
-                        (int)(player->position.x - textures->idle_left.width / 2),
-                        (int)(player->position.y - textures->idle_left.height),
+                        (int)(position.x - textures->idle_left.width / 2),
+                        (int)(position.y - textures->idle_left.height),
                         WHITE);
         }
     }
@@ -710,12 +538,13 @@ DrawPlayer(Player *player, PlayerTextures *textures)
 int
 InitPlayerTextures(PlayerTextures *playerTextures)
 {
-    playerTextures->idle_right = LoadTexture("plata/data/player_idle-right.png");
-    playerTextures->idle_left = LoadTexture("plata/data/player_idle-left.png");
-    playerTextures->run_right = LoadTexture("plata/data/player_run-right.png");
-    playerTextures->run_left = LoadTexture("plata/data/player_run-left.png");
-    playerTextures->idle_right_fire = LoadTexture("plata/data/player_idle_right_fire.png");
-    playerTextures->idle_left_fire = LoadTexture("plata/data/player_idle_left_fire.png");
+    // Through raytmx's cache, which maps loaded later share. Released with UnloadTextureTMX().
+    playerTextures->idle_right = LoadTextureTMX("plata/data/player_idle-right.png");
+    playerTextures->idle_left = LoadTextureTMX("plata/data/player_idle-left.png");
+    playerTextures->run_right = LoadTextureTMX("plata/data/player_run-right.png");
+    playerTextures->run_left = LoadTextureTMX("plata/data/player_run-left.png");
+    playerTextures->idle_right_fire = LoadTextureTMX("plata/data/player_idle_right_fire.png");
+    playerTextures->idle_left_fire = LoadTextureTMX("plata/data/player_idle_left_fire.png");
     
     if(!playerTextures->run_left.id  ||
        !playerTextures->run_right.id ||
@@ -734,71 +563,31 @@ InitPlayerTextures(PlayerTextures *playerTextures)
 void
 UnloadPlayerTextures(PlayerTextures *playerTextures)
 {
-    UnloadTexture(playerTextures->run_right);
-    UnloadTexture(playerTextures->run_left);
-    UnloadTexture(playerTextures->idle_right);
-    UnloadTexture(playerTextures->idle_left);
-    UnloadTexture(playerTextures->idle_right_fire);
-    UnloadTexture(playerTextures->idle_left_fire);
+    UnloadTextureTMX(playerTextures->run_right);
+    UnloadTextureTMX(playerTextures->run_left);
+    UnloadTextureTMX(playerTextures->idle_right);
+    UnloadTextureTMX(playerTextures->idle_left);
+    UnloadTextureTMX(playerTextures->idle_right_fire);
+    UnloadTextureTMX(playerTextures->idle_left_fire);
 }
 
 void
-UnloadSounds(Gun *pistol)
+InitSounds(GameState *gameState)
 {
-    for(int i = 0;
-        i < PISTOL_SOUND_COUNT;
-        i++)
-    {
-        UnloadSound(pistol->pistolSounds[i]);
-    }
+    gameState->pistolSounds[PISTOL_SOUND_FIRE] = LoadSound("plata/data/sounds/pistol-fire.wav");
+    gameState->pistolSounds[PISTOL_SOUND_DRYFIRE] = LoadSound("plata/data/sounds/pistol-dry-fire.wav");
+    gameState->pistolSounds[PISTOL_SOUND_RELOAD] = LoadSound("plata/data/sounds/pistol-reload.ogg");
+    gameState->pistolSounds[PISTOL_SOUND_STEAM] = LoadSound("plata/data/sounds/pistol-steam.wav");
 }
 
-int
-InitPlayer(Player *player, PlayerTextures *textures)
+void
+UnloadSounds(GameState *gameState)
 {
-    player->position = { 400, 280 };
-    //player->velocityX = 0.0f;
-    //player->velocityY = 0.0f;
-    
-    // NOTE(trist007): in Aseprite there were about 28 pixels to the right if player was facing right
-    // if player was facing left there were about 18 pixels to the right, I'm going to have to adjust this
-    // in Aseprite at some point
-    player->width = (float)(textures->idle_right.width) - 30;
-    player->height = (float)textures->idle_right.height;
-    player->facingRight = true;
-    player->canJump = false;
-    player->inAir = false;
-    player->idle = true;
-    player->gunFiring = false;
-    
-    //player->running.currentFrame = 0;
-    player->running.frameCount = 8;
-    //player->running.frameTimer = 0.0f;
-    player->running.frameSpeed = 0.1f;  // 10 frames per second (1.0/10)
-    
-    //player->firing.currentFrame = 0;
-    player->firing.frameCount = 4;
-    //player->firing.frameTimer = 0.0f;
-    player->firing.frameSpeed = 0.1f;  // 10 frames per second (1.0/10)
-    
-    player->gun.coolDown = 0.2f;
-    player->gun.overHeatTimer = 2.0f;
-    player->gun.rounds = 7;
-    player->gun.roundsPerMagazine = 7;
-    player->gun.bulletRadius = 2.0f;
-    player->gun.bulletSpeed = PROJECTILE_SPEED;
-    player->gun.pistolSounds[PISTOL_SOUND_FIRE] = LoadSound("plata/data/sounds/pistol-fire.wav");
-    player->gun.pistolSounds[PISTOL_SOUND_DRYFIRE] = LoadSound("plata/data/sounds/pistol-dry-fire.wav");
-    player->gun.pistolSounds[PISTOL_SOUND_RELOAD] = LoadSound("plata/data/sounds/pistol-reload.ogg");
-    player->gun.pistolSounds[PISTOL_SOUND_STEAM] = LoadSound("plata/data/sounds/pistol-steam.wav");
-    
-    
     for(int i = 0;
-        i < MAX_PROJECTILES;
+        i < PISTOL_SOUND_COUNT;
         i++)
     {
-        player->gun.bullets[i].active = false;
+        UnloadSound(gameState->pistolSounds[i]);
     }
-    
-    return(0);
-}
\ No newline at end of file
+}
+